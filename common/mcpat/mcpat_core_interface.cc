@@ -1,6 +1,8 @@
 #include "mcpat_core_interface.h"
 #include "log.h"
 
+using std::endl;
+
 McPATCoreInterface::McPATCoreInterface(UInt32 load_buffer_size, UInt32 store_buffer_size)
 {
    // Initialize Architectural Paramaters
@@ -99,6 +101,10 @@ void McPATCoreInterface::initializeOoOCoreParameters()
 
 void McPATCoreInterface::initializeEventCounters()
 {
+   for (UInt32 i = 0; i < NUM_EVENT_TYPES; i++)
+      m_event_counts[i] = 0;
+   m_last_cycle_count = 0;
+
    initializeInstructionCounters();
    initializeCycleCounters();
    initializeRegFileAccessCounters();
@@ -174,13 +180,42 @@ void McPATCoreInterface::initializeMiscEventCounters()
 
 void McPATCoreInterface::updateEventCounters(Instruction* instruction, UInt64 cycle_count)
 {
+   const McPATInstructionEvents* events = getInstructionEvents(instruction);
+   for (UInt32 i = 0; i < events->getNumEvents(); i++)
+   {
+      const McPATInstructionEvents::Event& event = events->getEvent(i);
+      m_event_counts[event.type] += event.count;
+   }
+
+   m_last_cycle_count = cycle_count;
+}
+
+McPATInstructionEvents* McPATCoreInterface::getInstructionEvents(Instruction* instruction)
+{
+   McPATInstructionEvents* events = instruction->getMcPATEvents();
+   if (events)
+      return events;
+
+   // Several cores may classify the same instruction at once
+   events = classifyInstruction(instruction);
+   if (!instruction->setMcPATEvents(events))
+   {
+      delete events;
+      events = instruction->getMcPATEvents();
+   }
+   return events;
+}
+
+McPATInstructionEvents* McPATCoreInterface::classifyInstruction(Instruction* instruction)
+{
+   UInt32 counts[NUM_EVENT_TYPES];
+   for (UInt32 i = 0; i < NUM_EVENT_TYPES; i++)
+      counts[i] = 0;
+
    // Get Instruction Type
    InstructionType instruction_type = getInstructionType(instruction->getOpcode());
-   updateInstructionCounters(instruction_type);
+   counts[instruction_type] ++;
 
-   // Update Cycle Counters
-   updateCycleCounters(cycle_count);
-   
    const OperandList& ops = instruction->getOperands();
    for (unsigned int i = 0; i < ops.size(); i++)
    {
@@ -188,54 +223,96 @@ void McPATCoreInterface::updateEventCounters(Instruction* instruction, UInt64 cy
 
       // Loads/Stores
       if ((o.m_type == Operand::MEMORY) && (o.m_direction == Operand::READ))
-         updateInstructionCounters(LOAD_INST);
+         counts[LOAD_INST_EVENT] ++;
       if ((o.m_type == Operand::MEMORY) && (o.m_direction == Operand::WRITE))
-         updateInstructionCounters(STORE_INST);
+         counts[STORE_INST_EVENT] ++;
 
       // Reg File Accesses
       if (o.m_type == Operand::REG)
-         updateRegFileAccessCounters(o.m_direction, o.m_value);
+      {
+         bool read = (o.m_direction == Operand::READ);
+         if (isIntegerReg(o.m_value))
+            counts[read ? INT_REGFILE_READ_EVENT : INT_REGFILE_WRITE_EVENT] ++;
+         else if (isFloatingPointReg(o.m_value))
+            counts[read ? FP_REGFILE_READ_EVENT : FP_REGFILE_WRITE_EVENT] ++;
+         else if (isXMMReg(o.m_value))
+            counts[read ? FP_REGFILE_READ_EVENT : FP_REGFILE_WRITE_EVENT] += 2;
+      }
    }
 
    // Execution Unit Accesses
    // A single instruction can access multiple execution units
-   // FIXME: Find out whether we need the whole instruction for this purpose
    ExecutionUnitList access_list = getExecutionUnitAccessList(instruction->getOpcode());
    for (UInt32 i = 0; i < access_list.size(); i++)
-      updateExecutionUnitAccessCounters(access_list[i]);
+      counts[ALU_ACCESS_EVENT + access_list[i]] ++;
+
+   McPATInstructionEvents* events = new McPATInstructionEvents();
+   for (UInt32 i = 0; i < NUM_EVENT_TYPES; i++)
+   {
+      if (counts[i] > 0)
+      {
+         LOG_ASSERT_ERROR(counts[i] <= 0xff, "Event(%u) count(%u) out of range", i, counts[i]);
+         events->addEvent((EventType) i, counts[i]);
+      }
+   }
+   return events;
+}
+
+void McPATCoreInterface::computeEventCounters()
+{
+   // Instruction Counters
+   for (UInt32 i = 0; i < NUM_INSTRUCTION_TYPES; i++)
+      updateInstructionCounters((InstructionType) i, m_event_counts[i]);
+
+   // Reg File Access Counters
+   m_int_regfile_reads += m_event_counts[INT_REGFILE_READ_EVENT];
+   m_int_regfile_writes += m_event_counts[INT_REGFILE_WRITE_EVENT];
+   m_fp_regfile_reads += m_event_counts[FP_REGFILE_READ_EVENT];
+   m_fp_regfile_writes += m_event_counts[FP_REGFILE_WRITE_EVENT];
+
+   // Execution Unit Access Counters
+   updateExecutionUnitAccessCounters(ALU, m_event_counts[ALU_ACCESS_EVENT]);
+   updateExecutionUnitAccessCounters(MUL, m_event_counts[MUL_ACCESS_EVENT]);
+   updateExecutionUnitAccessCounters(FPU, m_event_counts[FPU_ACCESS_EVENT]);
+
+   // Cycle Counters
+   updateCycleCounters(m_last_cycle_count);
+
+   for (UInt32 i = 0; i < NUM_EVENT_TYPES; i++)
+      m_event_counts[i] = 0;
 }
 
-void McPATCoreInterface::updateInstructionCounters(InstructionType instruction_type)
+void McPATCoreInterface::updateInstructionCounters(InstructionType instruction_type, UInt64 count)
 {
-   m_total_instructions ++;
-   m_committed_instructions ++;
+   m_total_instructions += count;
+   m_committed_instructions += count;
    
    switch (instruction_type)
    {
    case INTEGER_INST:
-      m_int_instructions ++;
-      m_committed_instructions ++;
+      m_int_instructions += count;
+      m_committed_int_instructions += count;
       break;
 
    case FLOATING_POINT_INST:
-      m_fp_instructions ++;
-      m_committed_fp_instructions ++;
+      m_fp_instructions += count;
+      m_committed_fp_instructions += count;
       break;
 
    case LOAD_INST:
-      m_load_instructions ++;
+      m_load_instructions += count;
       break;
 
    case STORE_INST:
-      m_store_instructions ++;
+      m_store_instructions += count;
       break;
 
    case BRANCH_INST:
-      m_branch_instructions ++;
+      m_branch_instructions += count;
       break;
 
    case BRANCH_NOT_TAKEN_INST:
-      m_branch_mispredictions ++;
+      m_branch_mispredictions += count;
       break;
 
    default:
@@ -244,49 +321,23 @@ void McPATCoreInterface::updateInstructionCounters(InstructionType instruction_t
    }
 }
 
-void McPATCoreInterface::updateRegFileAccessCounters(Operand::Direction operand_direction, UInt32 reg_id)
-{
-   if (operand_direction == Operand::READ)
-   {
-      if (isIntegerReg(reg_id))
-         m_int_regfile_reads ++;
-      else if (isFloatingPointReg(reg_id))
-         m_fp_regfile_reads ++;
-      else if (isXMMReg(reg_id))
-         m_fp_regfile_reads += 2;
-   }
-   else if (operand_direction == Operand::WRITE)
-   {
-      if (isIntegerReg(reg_id))
-         m_int_regfile_writes ++;
-      else if (isFloatingPointReg(reg_id))
-         m_fp_regfile_writes ++;
-      else if (isXMMReg(reg_id))
-         m_fp_regfile_writes += 2;
-   }
-   else
-   {
-      LOG_PRINT_ERROR("Unrecognized Operand Direction(%u)", operand_direction);
-   }
-}
-
-void McPATCoreInterface::updateExecutionUnitAccessCounters(ExecutionUnitType unit_type)
+void McPATCoreInterface::updateExecutionUnitAccessCounters(ExecutionUnitType unit_type, UInt64 count)
 {
    switch (unit_type)
    {
    case ALU:
-      m_ialu_accesses ++;
-      m_cdb_alu_accesses ++;
+      m_ialu_accesses += count;
+      m_cdb_alu_accesses += count;
       break;
 
    case MUL:
-      m_mul_accesses ++;
-      m_cdb_mul_accesses ++;
+      m_mul_accesses += count;
+      m_cdb_mul_accesses += count;
       break;
 
    case FPU:
-      m_fpu_accesses ++;
-      m_cdb_fpu_accesses ++;
+      m_fpu_accesses += count;
+      m_cdb_fpu_accesses += count;
       break;
 
    default:
@@ -302,6 +353,27 @@ void McPATCoreInterface::updateCycleCounters(UInt64 cycle_count)
    // TODO: Update for idle cycles later
 }
 
+void McPATCoreInterface::outputSummary(std::ostream &os)
+{
+   computeEventCounters();
+
+   os << "    McPAT Core Events:" << endl;
+   os << "      Total Instructions: " << m_total_instructions << endl;
+   os << "      Integer Instructions: " << m_int_instructions << endl;
+   os << "      Floating Point Instructions: " << m_fp_instructions << endl;
+   os << "      Load Instructions: " << m_load_instructions << endl;
+   os << "      Store Instructions: " << m_store_instructions << endl;
+   os << "      Branch Instructions: " << m_branch_instructions << endl;
+   os << "      Integer Register File Reads: " << m_int_regfile_reads << endl;
+   os << "      Integer Register File Writes: " << m_int_regfile_writes << endl;
+   os << "      Floating Point Register File Reads: " << m_fp_regfile_reads << endl;
+   os << "      Floating Point Register File Writes: " << m_fp_regfile_writes << endl;
+   os << "      ALU Accesses: " << m_ialu_accesses << endl;
+   os << "      MUL Accesses: " << m_mul_accesses << endl;
+   os << "      FPU Accesses: " << m_fpu_accesses << endl;
+   os << "      Total Cycles: " << m_total_cycles << endl;
+}
+
 // Dummy Implementations
 
 __attribute__((weak)) McPATCoreInterface::InstructionType
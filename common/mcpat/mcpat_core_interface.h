@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <string>
+#include <iostream>
 using std::vector;
 using std::string;
 
@@ -27,12 +28,36 @@ public:
       FPU
    };
    typedef vector<ExecutionUnitType> ExecutionUnitList;
+   enum EventType
+   {
+      // Same order as InstructionType
+      INTEGER_INST_EVENT = 0,
+      FLOATING_POINT_INST_EVENT,
+      LOAD_INST_EVENT,
+      STORE_INST_EVENT,
+      BRANCH_INST_EVENT,
+      BRANCH_NOT_TAKEN_INST_EVENT,
+      NUM_INSTRUCTION_TYPES,
+      INT_REGFILE_READ_EVENT = NUM_INSTRUCTION_TYPES,
+      INT_REGFILE_WRITE_EVENT,
+      FP_REGFILE_READ_EVENT,
+      FP_REGFILE_WRITE_EVENT,
+      // Same order as ExecutionUnitType
+      ALU_ACCESS_EVENT,
+      MUL_ACCESS_EVENT,
+      FPU_ACCESS_EVENT,
+      NUM_EVENT_TYPES
+   };
 
    McPATCoreInterface(UInt32 load_buffer_size, UInt32 store_buffer_size);
    ~McPATCoreInterface();
    
    // Update Event Counters
    void updateEventCounters(Instruction* instruction, UInt64 cycle_count);
+   // Fold the accumulated events into the McPAT event counters
+   void computeEventCounters();
+
+   void outputSummary(std::ostream &os);
 
 private:
    // Architectural Parameters
@@ -120,6 +145,10 @@ private:
    UInt64 m_function_calls;
    UInt64 m_context_switches;
 
+   // Events accumulated since the last computeEventCounters()
+   UInt64 m_event_counts[NUM_EVENT_TYPES];
+   UInt64 m_last_cycle_count;
+
    // Initialize Architectural Parameters
    void initializeArchitecturalParameters(UInt32 load_buffer_size, UInt32 store_buffer_size);
    void initializeRegFileParameters();
@@ -135,13 +164,43 @@ private:
    void initializeOoOEventCounters();
    void initializeMiscEventCounters();
    
+   // Classify a static instruction
+   McPATInstructionEvents* getInstructionEvents(Instruction* instruction);
+   McPATInstructionEvents* classifyInstruction(Instruction* instruction);
+   
    // Update Event Counters
-   void updateInstructionCounters(InstructionType instruction_type);
-   void updateRegFileAccessCounters(Operand::Direction operand_direction, UInt32 reg_id);
-   void updateExecutionUnitAccessCounters(ExecutionUnitType unit_type);
+   void updateInstructionCounters(InstructionType instruction_type, UInt64 count);
+   void updateExecutionUnitAccessCounters(ExecutionUnitType unit_type, UInt64 count);
    void updateCycleCounters(UInt64 cycle_count);
 };
 
+// Non-zero event counts of a static instruction
+class McPATInstructionEvents
+{
+public:
+   struct Event
+   {
+      UInt8 type;
+      UInt8 count;
+   };
+
+   McPATInstructionEvents() : m_num_events(0) {}
+
+   void addEvent(McPATCoreInterface::EventType type, UInt8 count)
+   {
+      m_events[m_num_events].type = type;
+      m_events[m_num_events].count = count;
+      m_num_events ++;
+   }
+
+   UInt32 getNumEvents() const { return m_num_events; }
+   const Event& getEvent(UInt32 i) const { return m_events[i]; }
+
+private:
+   UInt32 m_num_events;
+   Event m_events[McPATCoreInterface::NUM_EVENT_TYPES];
+};
+
 McPATCoreInterface::InstructionType getInstructionType(UInt64 opcode);
 McPATCoreInterface::ExecutionUnitList getExecutionUnitAccessList(UInt64 opcode);
 bool isIntegerReg(UInt32 reg_id);
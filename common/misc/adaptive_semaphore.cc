@@ -0,0 +1,90 @@
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include "adaptive_semaphore.h"
+
+static inline UInt64 readTimestampCounter()
+{
+   UInt32 lo, hi;
+   __asm__ __volatile__ ("rdtsc" : "=a" (lo), "=d" (hi));
+   return ((UInt64) hi << 32) | lo;
+}
+
+static inline void cpuRelax()
+{
+   __asm__ __volatile__ ("rep; nop" : : : "memory");
+}
+
+AdaptiveSemaphore::AdaptiveSemaphore(int count)
+   : _count(count)
+   , _num_waiting(0)
+   , _spin_limit(MIN_SPIN_LIMIT)
+   , _num_spin_handoffs(0)
+   , _num_parked_handoffs(0)
+   , _total_handoff_latency(0)
+{
+}
+
+AdaptiveSemaphore::~AdaptiveSemaphore()
+{
+}
+
+bool AdaptiveSemaphore::tryDecrement()
+{
+   int count = _count;
+   return (count > 0) && __sync_bool_compare_and_swap(&_count, count, count-1);
+}
+
+void AdaptiveSemaphore::wait()
+{
+   UInt64 start_time = readTimestampCounter();
+
+   for (UInt32 i = 0; i < _spin_limit; i++)
+   {
+      if (tryDecrement())
+      {
+         _num_spin_handoffs ++;
+         _total_handoff_latency += readTimestampCounter() - start_time;
+         if (_spin_limit < MAX_SPIN_LIMIT)
+            _spin_limit *= 2;
+         return;
+      }
+      cpuRelax();
+   }
+
+   // Announce the waiter before re-checking the count, so that a signal()
+   // either is seen here or sees the waiter and issues a wake-up
+   __sync_fetch_and_add(&_num_waiting, 1);
+   while (!tryDecrement())
+   {
+      // Returns immediately if the count has become non-zero
+      syscall(SYS_futex, (void*) &_count, FUTEX_WAIT, 0, NULL, NULL, 0);
+   }
+   __sync_fetch_and_sub(&_num_waiting, 1);
+
+   _num_parked_handoffs ++;
+   _total_handoff_latency += readTimestampCounter() - start_time;
+   if (_spin_limit > MIN_SPIN_LIMIT)
+      _spin_limit /= 2;
+}
+
+void AdaptiveSemaphore::signal()
+{
+   __sync_fetch_and_add(&_count, 1);
+   if (_num_waiting > 0)
+      syscall(SYS_futex, (void*) &_count, FUTEX_WAKE, 1, NULL, NULL, 0);
+}
+
+UInt64 AdaptiveSemaphore::getAverageHandoffLatency() const
+{
+   UInt64 num_handoffs = _num_spin_handoffs + _num_parked_handoffs;
+   return (num_handoffs > 0) ? (_total_handoff_latency / num_handoffs) : 0;
+}
+
+void AdaptiveSemaphore::outputSummary(std::ostream& out, const std::string& name) const
+{
+   out << "    " << name << " Spin Handoffs: " << _num_spin_handoffs << std::endl;
+   out << "    " << name << " Parked Handoffs: " << _num_parked_handoffs << std::endl;
+   out << "    " << name << " Average Handoff Latency (in host cycles): " << getAverageHandoffLatency() << std::endl;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+
+#include "fixed_types.h"
+
+// Semaphore used to hand control back and forth between two threads
+// A waiter first spins on the count for a bounded number of iterations and
+// only then parks on a futex. The spin bound adapts: it grows when spinning
+// succeeds and shrinks when the waiter ends up parking anyway.
+//
+// The statistics are updated only by the waiting thread, so each semaphore
+// is expected to have a single waiter (as with the app/sim thread handoff)
+class AdaptiveSemaphore
+{
+public:
+   AdaptiveSemaphore(int count = 0);
+   ~AdaptiveSemaphore();
+
+   void wait();
+   void signal();
+
+   UInt64 getNumSpinHandoffs() const { return _num_spin_handoffs; }
+   UInt64 getNumParkedHandoffs() const { return _num_parked_handoffs; }
+   // Average time (in host timestamp-counter ticks) a waiter blocks in wait()
+   UInt64 getAverageHandoffLatency() const;
+
+   void outputSummary(std::ostream& out, const std::string& name) const;
+
+private:
+   static const UInt32 MIN_SPIN_LIMIT = 16;
+   static const UInt32 MAX_SPIN_LIMIT = 16384;
+
+   volatile int _count;
+   volatile int _num_waiting;
+   UInt32 _spin_limit;
+
+   UInt64 _num_spin_handoffs;
+   UInt64 _num_parked_handoffs;
+   UInt64 _total_handoff_latency;
+
+   bool tryDecrement();
+};
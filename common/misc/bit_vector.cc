@@ -1,5 +1,9 @@
 #include "bit_vector.h"
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 /* ================================================================ */
 /* Bit vector class method definitions */
 /* ================================================================ */
@@ -38,68 +42,26 @@ bool BitVector::resetFind()
 
 SInt32 BitVector::find()
 {
+   UInt32 start_pos = m_last_pos + 1;
+   UInt32 windex = start_pos >> 6; //divide by 64
 
-   int windex = (m_last_pos == -1) ? 0 : m_last_pos >> 6; //divide by 64
-   int word_count = (m_capacity + 64 -1)  >> 6;
-
-   //walk through bitVector one word at a time
-   //return when we find a set bit (whose pos is > last_pos)
-   while (windex < word_count)
+   if (windex < VECTOR_SIZE)
    {
+      //mask off the bits up to and including last_pos in the first word
+      UInt64 word64 = m_words[windex] & (~((UInt64) 0) << (start_pos & 63));
 
-      UInt64 word64 = m_words[windex];
-
-      if (word64 != 0)
+      //walk through bitVector one word at a time
+      while (true)
       {
-
-         UInt32 words32[2];
-         words32[1] = (word64 >> 32) ;
-         words32[0] = word64 & 0xFFFFFFFF;
-
-         for (int i = 0; i < 2; i++)
+         if (word64 != 0)
          {
-            if (words32[i] != 0)
-            {
-
-               UInt16 words16[2];
-               words16[1] = (words32[i] >> 16);
-               words16[0] = words32[i] & 0xFFFF;
-
-               for (int j = 0; j < 2; j++)
-               {
-                  if (words16[j] != 0)
-                  {
-
-                     UInt8 words8[2];
-                     words8[1] = (words16[j] >> 8);
-                     words8[0] = words16[j] & 0xFF;
-
-                     for (int k = 0; k < 2; k++)
-                     {
-                        if (words8[k] != 0)
-                        {
-
-                           for (int l = 0; l < 8; l++)
-                           {
-                              //loop through byte and look for set bit
-                              if (bTestBit(words8[k], l))
-                              {
-                                 int return_pos = 64*windex + 32*i + 16*j + 8*k + l;
-                                 if (return_pos > m_last_pos)
-                                 {
-                                    m_last_pos = return_pos;
-                                    return return_pos;
-                                 }
-                              }
-                           }
-                        }
-                     }
-                  }
-               }
-            }
+            m_last_pos = (windex << 6) + __builtin_ctzll(word64);
+            return m_last_pos;
          }
+         if (++windex == VECTOR_SIZE)
+            break;
+         word64 = m_words[windex];
       }
-      ++windex;
    }
 
    //if we get here, there is no set bit in bitVector (after the last_pos that is)
@@ -107,16 +69,38 @@ SInt32 BitVector::find()
    return -1;
 }
 
-//helper function to "find", accepts a byte
-//and a bit location and returns true if bit is set
-bool BitVector::bTestBit(UInt8 byte_word, UInt32 bit)
+UInt32 BitVector::getSetBits(SInt32* bits) const
 {
-   assert(bit < 8);
+   UInt32 count = 0;
+   for (UInt32 windex = 0; windex < VECTOR_SIZE; windex++)
+   {
+      UInt64 word64 = m_words[windex];
+      while (word64 != 0)
+      {
+         bits[count++] = (windex << 6) + __builtin_ctzll(word64);
+         //clear the lowest set bit
+         word64 &= word64 - 1;
+      }
+   }
+   assert(count == m_size);
+   return count;
+}
 
-// UInt8 shift = bit & 0xF; i don't think this is necessary b/c of assert
-   UInt8 one = 1;
-   UInt8 mask = one << bit;
-   return (byte_word & mask) ? true : false;
+SInt32 BitVector::findNth(UInt32 n) const
+{
+   for (UInt32 windex = 0; windex < VECTOR_SIZE; windex++)
+   {
+      UInt64 word64 = m_words[windex];
+      UInt32 word_count = __builtin_popcountll(word64);
+      if (n < word_count)
+      {
+         for (UInt32 i = 0; i < n; i++)
+            word64 &= word64 - 1;
+         return (windex << 6) + __builtin_ctzll(word64);
+      }
+      n -= word_count;
+   }
+   return -1;
 }
 
 bool BitVector::at(UInt32 bit)
@@ -160,29 +144,93 @@ void BitVector::clear(UInt32 bit)
    }
 }
 
-#if BITVECT_DEBUG
+void BitVector::updateSize()
+{
+   m_size = 0;
+   for (UInt32 i = 0; i < VECTOR_SIZE; i++)
+      m_size += __builtin_popcountll(m_words[i]);
+}
+
+/*
+ * Bulk operations. These walk the vectors 4 words at a time with AVX2
+ * when the simulator is compiled for it, and fall back to one 64-bit
+ * word at a time otherwise.
+ */
 
 void BitVector::set(const BitVector& vec2)
 {
    assert(m_capacity == vec2.m_capacity);
 
-   for (UInt32 i = 0; i < VECTOR_SIZE; i++)
-      words[i] |= vec2.m_words[i];
+   UInt32 i = 0;
+#ifdef __AVX2__
+   for ( ; i + 4 <= VECTOR_SIZE; i += 4)
+   {
+      __m256i a = _mm256_loadu_si256((const __m256i*) &m_words[i]);
+      __m256i b = _mm256_loadu_si256((const __m256i*) &vec2.m_words[i]);
+      _mm256_storeu_si256((__m256i*) &m_words[i], _mm256_or_si256(a, b));
+   }
+#endif
+   for ( ; i < VECTOR_SIZE; i++)
+      m_words[i] |= vec2.m_words[i];
+
+   updateSize();
 }
 
 void BitVector::clear(const BitVector& vec2)
 {
    assert(m_capacity == vec2.m_capacity);
 
-   for (UInt32 i = 0; i < VECTOR_SIZE; i++)
-      words[i] &= ~vec2.m_words[i];
+   UInt32 i = 0;
+#ifdef __AVX2__
+   for ( ; i + 4 <= VECTOR_SIZE; i += 4)
+   {
+      __m256i a = _mm256_loadu_si256((const __m256i*) &m_words[i]);
+      __m256i b = _mm256_loadu_si256((const __m256i*) &vec2.m_words[i]);
+      // andnot(b, a) computes (~b & a)
+      _mm256_storeu_si256((__m256i*) &m_words[i], _mm256_andnot_si256(b, a));
+   }
+#endif
+   for ( ; i < VECTOR_SIZE; i++)
+      m_words[i] &= ~vec2.m_words[i];
+
+   updateSize();
+}
+
+void BitVector::intersect(const BitVector& vec2)
+{
+   assert(m_capacity == vec2.m_capacity);
+
+   UInt32 i = 0;
+#ifdef __AVX2__
+   for ( ; i + 4 <= VECTOR_SIZE; i += 4)
+   {
+      __m256i a = _mm256_loadu_si256((const __m256i*) &m_words[i]);
+      __m256i b = _mm256_loadu_si256((const __m256i*) &vec2.m_words[i]);
+      _mm256_storeu_si256((__m256i*) &m_words[i], _mm256_and_si256(a, b));
+   }
+#endif
+   for ( ; i < VECTOR_SIZE; i++)
+      m_words[i] &= vec2.m_words[i];
+
+   updateSize();
 }
 
-bool BitVector::test(const BitVector& vec2)
+bool BitVector::test(const BitVector& vec2) const
 {
    assert(vec2.m_capacity == m_capacity);
 
-   for (UInt32 i = 0; i < VECTOR_SIZE; i++)
+   UInt32 i = 0;
+#ifdef __AVX2__
+   for ( ; i + 4 <= VECTOR_SIZE; i += 4)
+   {
+      __m256i a = _mm256_loadu_si256((const __m256i*) &m_words[i]);
+      __m256i b = _mm256_loadu_si256((const __m256i*) &vec2.m_words[i]);
+      // testz returns 1 if (a & b) is all zeroes
+      if (!_mm256_testz_si256(a, b))
+         return true;
+   }
+#endif
+   for ( ; i < VECTOR_SIZE; i++)
    {
       if (vec2.m_words[i] & m_words[i])
          return true;
@@ -191,6 +239,27 @@ bool BitVector::test(const BitVector& vec2)
    return false;
 }
 
+bool BitVector::any() const
+{
+   UInt32 i = 0;
+#ifdef __AVX2__
+   for ( ; i + 4 <= VECTOR_SIZE; i += 4)
+   {
+      __m256i a = _mm256_loadu_si256((const __m256i*) &m_words[i]);
+      if (!_mm256_testz_si256(a, a))
+         return true;
+   }
+#endif
+   for ( ; i < VECTOR_SIZE; i++)
+   {
+      if (m_words[i] != 0)
+         return true;
+   }
+
+   return false;
+}
+
+#if BITVECT_DEBUG
 
 void BitVector::debug()
 {
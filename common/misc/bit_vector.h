@@ -26,6 +26,9 @@ class BitVector
       //marks the position of the last set bit found.
       //value of -1 means no last_pos bit
 
+      //recompute m_size from the words (after bulk operations)
+      void updateSize();
+
    public:
 
 #if BITVECT_DEBUG
@@ -51,9 +54,11 @@ class BitVector
       SInt32 find();
       bool resetFind();
 
-      //given an 8bit word, test to see if 'bit' is set
-      //this is a helper function to the "find" function
-      bool bTestBit(UInt8 word, UInt32 bit);
+      //write the positions of all set bits (in increasing order) into 'bits',
+      //which must have room for size() entries. returns the number written
+      UInt32 getSetBits(SInt32* bits) const;
+      //position of the n-th (0-based) set bit, -1 if n >= size()
+      SInt32 findNth(UInt32 n) const;
 
       UInt32 capacity() { return m_capacity; }
       UInt32 size() { return m_size; }
@@ -63,12 +68,13 @@ class BitVector
       void set(UInt32 bit);
       void clear(UInt32 bit);
 
-#ifdef BITVECT_DEBUG
-      void set(const BitVector& vec2);
-      void clear(const BitVector& vec2);
-      bool test(const BitVector& vec2);
-#endif
-
+      //bulk operations on bit vectors of the same capacity
+      void set(const BitVector& vec2);       // this |= vec2
+      void clear(const BitVector& vec2);     // this &= ~vec2
+      void intersect(const BitVector& vec2); // this &= vec2
+      bool test(const BitVector& vec2) const;// (this & vec2) != 0
+      bool any() const;
+      bool none() const { return !any(); }
 };
 
 #endif
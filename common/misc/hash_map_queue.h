@@ -1,15 +1,23 @@
 #pragma once
 
-#include <map>
-#include <queue>
-using std::map;
-using std::queue;
-using std::make_pair;
+#include <vector>
+#include <cassert>
+using std::vector;
 
+#include "fixed_types.h"
+
+// A set of FIFO queues indexed by key (typically an address)
+// The keys live in an open-addressing (linear probing) hash table. The values
+// are kept in intrusive singly-linked FIFO chains whose nodes come from a
+// per-table pool, so that steady-state enqueue/dequeue does no allocation
+// K must be an integral type
 template<typename K, typename V>
 class HashMapQueue
 {
 public:
+   HashMapQueue(UInt32 initial_capacity = 16);
+   ~HashMapQueue();
+
    void enqueue(K key, V value);
    V dequeue(K key);
    V front(K key) const;
@@ -18,46 +26,200 @@ public:
    size_t size() const;
 
 private:
-   map<K, queue<V> > _hash_map_queue;
+   static const SInt32 INVALID_INDEX = -1;
+
+   struct Node
+   {
+      V _value;
+      SInt32 _next;
+   };
+
+   struct Slot
+   {
+      K _key;
+      SInt32 _head;
+      SInt32 _tail;
+      UInt32 _count;
+      bool _valid;
+   };
+
+   vector<Slot> _slots;
+   UInt32 _slot_mask;
+   size_t _num_keys;
+
+   vector<Node> _node_pool;
+   SInt32 _free_node_list;
+
+   UInt32 hash(K key) const;
+   SInt32 findSlot(K key) const;
+   SInt32 allocateNode(V value);
+   void releaseNode(SInt32 node_index);
+   void eraseSlot(UInt32 slot_index);
+   void grow();
 };
 
 template <typename K, typename V>
-void HashMapQueue<K,V>::enqueue(K key, V value)
+HashMapQueue<K,V>::HashMapQueue(UInt32 initial_capacity)
+   : _num_keys(0)
+   , _free_node_list(INVALID_INDEX)
 {
-   // Get the iterator
-   typename map<K, queue<V> >::iterator it = _hash_map_queue.find(key);
+   // Capacity is always a power of 2
+   UInt32 capacity = 1;
+   while (capacity < initial_capacity)
+      capacity <<= 1;
+
+   Slot empty_slot;
+   empty_slot._valid = false;
+   _slots.resize(capacity, empty_slot);
+   _slot_mask = capacity - 1;
+}
+
+template <typename K, typename V>
+HashMapQueue<K,V>::~HashMapQueue()
+{}
 
-   if (it == _hash_map_queue.end())
+template <typename K, typename V>
+UInt32 HashMapQueue<K,V>::hash(K key) const
+{
+   // Fibonacci hashing - mixes the (cache-line aligned) low bits away
+   UInt64 h = ((UInt64) key) * 0x9E3779B97F4A7C15ULL;
+   return (UInt32) (h >> 32) & _slot_mask;
+}
+
+template <typename K, typename V>
+SInt32 HashMapQueue<K,V>::findSlot(K key) const
+{
+   for (UInt32 i = hash(key); ; i = (i+1) & _slot_mask)
+   {
+      const Slot& slot = _slots[i];
+      if (!slot._valid)
+         return INVALID_INDEX;
+      if (slot._key == key)
+         return i;
+   }
+}
+
+template <typename K, typename V>
+SInt32 HashMapQueue<K,V>::allocateNode(V value)
+{
+   SInt32 node_index;
+   if (_free_node_list != INVALID_INDEX)
    {
-      // Create a new queue whose only element is the value
-      queue<V> value_queue;
-      value_queue.push(value);
-      _hash_map_queue.insert(make_pair(key, value_queue));
+      node_index = _free_node_list;
+      _free_node_list = _node_pool[node_index]._next;
    }
    else
    {
-      // Push the value
-      queue<V>& value_queue = (it->second);
-      value_queue.push(value);
+      node_index = _node_pool.size();
+      _node_pool.push_back(Node());
    }
+   _node_pool[node_index]._value = value;
+   _node_pool[node_index]._next = INVALID_INDEX;
+   return node_index;
+}
+
+template <typename K, typename V>
+void HashMapQueue<K,V>::releaseNode(SInt32 node_index)
+{
+   _node_pool[node_index]._next = _free_node_list;
+   _free_node_list = node_index;
+}
+
+template <typename K, typename V>
+void HashMapQueue<K,V>::eraseSlot(UInt32 slot_index)
+{
+   // Backward-shift deletion: move later entries of the probe sequence into the hole
+   // so that no tombstones are needed
+   UInt32 hole = slot_index;
+   for (UInt32 i = (hole+1) & _slot_mask; _slots[i]._valid; i = (i+1) & _slot_mask)
+   {
+      UInt32 home = hash(_slots[i]._key);
+      // Move the entry if its home slot is not in the cyclic range (hole, i]
+      if (((i - home) & _slot_mask) >= ((i - hole) & _slot_mask))
+      {
+         _slots[hole] = _slots[i];
+         hole = i;
+      }
+   }
+   _slots[hole]._valid = false;
+   _num_keys --;
+}
+
+template <typename K, typename V>
+void HashMapQueue<K,V>::grow()
+{
+   vector<Slot> old_slots;
+   old_slots.swap(_slots);
+
+   Slot empty_slot;
+   empty_slot._valid = false;
+   _slots.resize(old_slots.size() * 2, empty_slot);
+   _slot_mask = _slots.size() - 1;
+
+   for (UInt32 j = 0; j < old_slots.size(); j++)
+   {
+      if (!old_slots[j]._valid)
+         continue;
+      UInt32 i = hash(old_slots[j]._key);
+      while (_slots[i]._valid)
+         i = (i+1) & _slot_mask;
+      _slots[i] = old_slots[j];
+   }
+}
+
+template <typename K, typename V>
+void HashMapQueue<K,V>::enqueue(K key, V value)
+{
+   SInt32 node_index = allocateNode(value);
+
+   SInt32 slot_index = findSlot(key);
+   if (slot_index != INVALID_INDEX)
+   {
+      // Append the value to the existing chain
+      Slot& slot = _slots[slot_index];
+      _node_pool[slot._tail]._next = node_index;
+      slot._tail = node_index;
+      slot._count ++;
+      return;
+   }
+
+   // Keep the load factor at or below 3/4
+   if (4 * (_num_keys + 1) > 3 * _slots.size())
+      grow();
+
+   // Create a new chain whose only element is the value
+   UInt32 i = hash(key);
+   while (_slots[i]._valid)
+      i = (i+1) & _slot_mask;
+
+   Slot& slot = _slots[i];
+   slot._key = key;
+   slot._head = node_index;
+   slot._tail = node_index;
+   slot._count = 1;
+   slot._valid = true;
+   _num_keys ++;
 }
 
 template <typename K, typename V>
 V HashMapQueue<K,V>::dequeue(K key)
 {
    // The hash table cannot be empty for that key
-   typename map<K, queue<V> >::iterator it = _hash_map_queue.find(key);
-   if (it == _hash_map_queue.end())
+   SInt32 slot_index = findSlot(key);
+   if (slot_index == INVALID_INDEX)
       return V();
 
    // Get the value
-   queue<V>& value_queue = (it->second);
-   V value = value_queue.front();
-   value_queue.pop();
+   Slot& slot = _slots[slot_index];
+   SInt32 node_index = slot._head;
+   V value = _node_pool[node_index]._value;
+   slot._head = _node_pool[node_index]._next;
+   slot._count --;
+   releaseNode(node_index);
 
-   // Remove the queue if empty
-   if (value_queue.empty())
-      _hash_map_queue.erase(it);
+   // Remove the key if its chain is empty
+   if (slot._count == 0)
+      eraseSlot(slot_index);
 
    // Return the value
    return value;
@@ -67,54 +229,31 @@ template <typename K, typename V>
 V HashMapQueue<K,V>::front(K key) const
 {
    // The hash table cannot be empty for that key
-   typename map<K, queue<V> >::const_iterator it = _hash_map_queue.find(key);
-   if (it == _hash_map_queue.end())
+   SInt32 slot_index = findSlot(key);
+   if (slot_index == INVALID_INDEX)
       return V();
 
    // Return the value
-   const queue<V>& value_queue = (it->second);
-   return value_queue.front();
+   return _node_pool[_slots[slot_index]._head]._value;
 }
 
 template <typename K, typename V>
 size_t HashMapQueue<K,V>::count(K key) const
 {
-   // Get the iterator
-   typename map<K, queue<V> >::const_iterator it = _hash_map_queue.find(key);
-  
-   if (it == _hash_map_queue.end())
-   {
-      // If not present, return 0 
-      return 0;
-   }
-   else
-   {
-      // Return the count from the queue
-      const queue<V>& value_queue = (it->second);
-      return value_queue.size();
-   }
+   SInt32 slot_index = findSlot(key);
+   // If not present, return 0
+   return (slot_index == INVALID_INDEX) ? 0 : _slots[slot_index]._count;
 }
 
 template <typename K, typename V>
 bool HashMapQueue<K,V>::empty(K key) const
 {
-   // Get the iterator
-   typename map<K, queue<V> >::const_iterator it = _hash_map_queue.find(key);
-  
-   if (it == _hash_map_queue.end())
-   {
-      // If not present, return true
-      return true;
-   }
-   else
-   {
-      // The queue is present, if present it should be non-empty
-      return false;
-   }
+   // If present, the chain is non-empty
+   return (findSlot(key) == INVALID_INDEX);
 }
 
 template <typename K, typename V>
 size_t HashMapQueue<K,V>::size() const
 {
-   return _hash_map_queue.size();
+   return _num_keys;
 }
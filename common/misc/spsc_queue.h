@@ -0,0 +1,72 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <assert.h>
+#include "fixed_types.h"
+
+// Bounded lock-free queue with exactly one producer thread and one consumer thread
+// The head is written only by the consumer and the tail only by the producer.
+// x86 does not reorder stores with other stores or loads with other loads, so a
+// compiler barrier is enough to publish a slot before the index that covers it.
+template <class T>
+class SPSCQueue
+{
+public:
+   // The capacity is rounded up to a power of 2
+   SPSCQueue(UInt32 capacity)
+      : m_head(0)
+      , m_tail(0)
+   {
+      UInt32 size = 1;
+      while (size < capacity)
+         size <<= 1;
+      m_mask = size - 1;
+      m_buffer = new T[size];
+   }
+
+   ~SPSCQueue()
+   {
+      delete [] m_buffer;
+   }
+
+   UInt32 size() const { return m_tail - m_head; }
+   bool empty() const { return (m_tail == m_head); }
+   bool full() const { return (size() > m_mask); }
+
+   // Producer
+   void push(const T& t)
+   {
+      assert(!full());
+      m_buffer[m_tail & m_mask] = t;
+      compilerBarrier();
+      m_tail = m_tail + 1;
+   }
+
+   // Consumer
+   T& front()
+   {
+      assert(!empty());
+      compilerBarrier();
+      return m_buffer[m_head & m_mask];
+   }
+
+   void pop()
+   {
+      assert(!empty());
+      compilerBarrier();
+      m_head = m_head + 1;
+   }
+
+private:
+   static void compilerBarrier() { __asm__ __volatile__ ("" : : : "memory"); }
+
+   T* m_buffer;
+   UInt32 m_mask;
+
+   // Keep the two indices on separate cache lines
+   volatile UInt32 m_head;
+   char m_padding[64];
+   volatile UInt32 m_tail;
+};
+
+#endif
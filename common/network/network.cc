@@ -267,6 +267,53 @@ SInt32 Network::netSend(NetPacket& packet)
    return packet.length;
 }
 
+void Network::modelLocalDelivery(NetPacket& packet)
+{
+   // Floating Point Save/Restore
+   FloatingPointHandler floating_point_handler;
+
+   assert(_tile);
+   LOG_ASSERT_ERROR((TILE_ID(packet.sender) == _tile->getId()) && (TILE_ID(packet.receiver) == _tile->getId()),
+                    "sender(%i), receiver(%i), tile_id(%i)", TILE_ID(packet.sender), TILE_ID(packet.receiver), _tile->getId());
+
+   NetworkModel* model = getNetworkModelFromPacketType(packet.type);
+   float core_frequency = _tile->getCore()->getPerformanceModel()->getFrequency();
+
+   // Same conversions and model calls as netSend() + netPullFromTransport()
+   packet.time = convertCycleCount(packet.time, core_frequency, model->getFrequency());
+
+   // Hop-by-hop models route the packet through the router of this tile, so
+   // the hops are walked as in forwardPacket() (they all stay on this tile)
+   queue<NetworkModel::Hop> hop_queue;
+   model->__routePacket(packet, hop_queue);
+
+   bool received = false;
+   while (!hop_queue.empty())
+   {
+      NetworkModel::Hop hop = hop_queue.front();
+      hop_queue.pop();
+
+      LOG_ASSERT_ERROR(hop._next_tile_id == _tile->getId(),
+                       "Local packet routed through tile(%i), tile_id(%i)", hop._next_tile_id, _tile->getId());
+      LOG_ASSERT_ERROR(!received, "Local packet received more than once, tile_id(%i)", _tile->getId());
+
+      packet.node_type = hop._next_node_type;
+      packet.time = hop._time;
+      packet.zero_load_delay = hop._zero_load_delay;
+      packet.contention_delay = hop._contention_delay;
+
+      if (hop._next_node_type != NetworkModel::RECEIVE_TILE)
+         model->__routePacket(packet, hop_queue);
+      else
+         received = true;
+   }
+   LOG_ASSERT_ERROR(received, "Local packet not received, tile_id(%i)", _tile->getId());
+
+   model->__processReceivedPacket(packet);
+
+   packet.time = convertCycleCount(packet.time, model->getFrequency(), core_frequency);
+}
+
 // Stupid helper class to eliminate special cases for empty
 // sender/type vectors in a NetMatch
 class NetRecvIterator
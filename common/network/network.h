@@ -97,6 +97,11 @@ public:
    SInt32 netSend(NetPacket& packet);
    NetPacket netRecv(const NetMatch &match);
 
+   // Models a packet sent by this tile to itself without handing it to the
+   // transport layer. Only the timing is modeled: on return, packet.time is
+   // the time (in core cycles) at which the packet would have been received
+   void modelLocalDelivery(NetPacket& packet);
+
    // -- Wrappers -- //
 
    SInt32 netSend(core_id_t dest, PacketType type, const void *buf, UInt32 len);
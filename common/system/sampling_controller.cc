@@ -0,0 +1,254 @@
+#include <cmath>
+
+#include "sampling_controller.h"
+#include "simulator.h"
+#include "tile_manager.h"
+#include "tile.h"
+#include "core.h"
+#include "core_model.h"
+#include "basic_block.h"
+#include "instruction.h"
+#include "memory_manager.h"
+#include "config.h"
+#include "log.h"
+
+using std::endl;
+
+SamplingController::SamplingController()
+   : m_phase(INACTIVE)
+   , m_phase_end(0)
+   , m_num_instructions(0)
+   , m_local_counts(Config::getSingleton()->getNumLocalTiles())
+   , m_sample_start_cycles(0)
+   , m_sample_start_instructions(0)
+   , m_num_detailed_instructions(0)
+{
+   try
+   {
+      m_period = Sim()->getCfg()->getInt("sampling/period");
+      m_detailed_interval = Sim()->getCfg()->getInt("sampling/detailed_interval");
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read sampling information from cfg file");
+   }
+
+   LOG_ASSERT_ERROR(m_detailed_interval > 0 && m_detailed_interval < m_period,
+                    "Detailed interval(%llu) must be > 0 and < sampling period(%llu)",
+                    m_detailed_interval, m_period);
+   // The phases are switched within a process, without telling the others
+   LOG_ASSERT_ERROR(Config::getSingleton()->getProcessCount() == 1,
+                    "Sampling is only supported with a single process");
+   LOG_ASSERT_ERROR(!Sim()->getCfg()->getBool("general/trigger_models_within_application", false),
+                    "Sampling can not be used with trigger_models_within_application");
+
+   for (UInt32 i = 0; i < m_local_counts.size(); i++)
+      m_local_counts[i].count = 0;
+}
+
+SamplingController::~SamplingController()
+{}
+
+void SamplingController::start()
+{
+   ScopedLock sl(m_lock);
+
+   LOG_PRINT("Sampling: start, functional warming");
+
+   // Every sampling unit starts with functional warming
+   m_phase_end = m_num_instructions + (m_period - m_detailed_interval);
+   m_phase = FUNCTIONAL_WARMING;
+}
+
+void SamplingController::stop()
+{
+   ScopedLock sl(m_lock);
+
+   // An incomplete detailed interval is left out of the estimate. The models
+   // are disabled by the simulator afterwards.
+   for (UInt32 i = 0; i < m_local_counts.size(); i++)
+   {
+      __sync_add_and_fetch(&m_num_instructions, m_local_counts[i].count);
+      m_local_counts[i].count = 0;
+   }
+
+   LOG_PRINT("Sampling: stop");
+   m_phase = INACTIVE;
+}
+
+void SamplingController::handleBasicBlock(UInt32 tile_index, BasicBlock *basic_block)
+{
+   if ((m_phase == INACTIVE) || (tile_index >= m_local_counts.size()))
+      return;
+
+   addInstructions(tile_index, basic_block->size());
+
+   Core *core = Sim()->getTileManager()->getTileFromIndex(tile_index)->getCore();
+   applyPhase(core->getPerformanceModel());
+
+   // In functional warming, the core model does not fetch the instructions
+   if (!core->getPerformanceModel()->isEnabled())
+      warmInstructionCache(core, basic_block);
+}
+
+void SamplingController::addInstructions(UInt32 tile_index, UInt32 num_instructions)
+{
+   // Only the thread running on the tile updates its count
+   LocalCount &local_count = m_local_counts[tile_index];
+   local_count.count += num_instructions;
+   if (local_count.count < LOCAL_COUNT_THRESHOLD)
+      return;
+
+   UInt64 num_instructions_total = __sync_add_and_fetch(&m_num_instructions, local_count.count);
+   local_count.count = 0;
+
+   if (num_instructions_total < m_phase_end)
+      return;
+
+   ScopedLock sl(m_lock);
+
+   // Another thread may have switched the phase already
+   if ((m_phase != INACTIVE) && (m_num_instructions >= m_phase_end))
+      switchPhase();
+}
+
+void SamplingController::switchPhase()
+{
+   if (m_phase == FUNCTIONAL_WARMING)
+   {
+      LOG_PRINT("Sampling: detailed (%llu instructions)", m_num_instructions);
+      beginSample();
+      for (UInt32 i = 0; i < Config::getSingleton()->getNumLocalTiles(); i++)
+         Sim()->getTileManager()->getTileFromIndex(i)->enableMemoryAndNetworkModels();
+      m_phase_end += m_detailed_interval;
+      m_phase = DETAILED;
+   }
+   else
+   {
+      LOG_PRINT("Sampling: functional warming (%llu instructions)", m_num_instructions);
+      for (UInt32 i = 0; i < Config::getSingleton()->getNumLocalTiles(); i++)
+         Sim()->getTileManager()->getTileFromIndex(i)->disableMemoryAndNetworkModels();
+      endSample();
+      m_phase_end += (m_period - m_detailed_interval);
+      m_phase = FUNCTIONAL_WARMING;
+   }
+}
+
+// Called by the thread running on the tile, between two basic blocks
+void SamplingController::applyPhase(CoreModel *core_model)
+{
+   bool detailed = (m_phase == DETAILED);
+   if (detailed == core_model->isEnabled())
+      return;
+
+   if (detailed)
+   {
+      core_model->enable();
+   }
+   else
+   {
+      // The last basic block of the interval is not modeled
+      core_model->disable();
+      core_model->discardQueuedInstructions();
+   }
+}
+
+// The memory models of the tile are disabled, so the fetches only update the
+// state of the L1-I and the rest of the memory system
+void SamplingController::warmInstructionCache(Core *core, BasicBlock *basic_block)
+{
+   // Thread Spawner and MCP cores do not fetch in the detailed intervals either
+   if (core->getTile()->getId() >= (tile_id_t) Config::getSingleton()->getApplicationTiles())
+      return;
+
+   // One fetch per cache line
+   UInt32 cache_line_size = core->getMemoryManager()->getCacheLineSize();
+   IntPtr fetched_line = 0;
+   bool fetched = false;
+   for (UInt32 i = 0; i < basic_block->size(); i++)
+   {
+      Instruction *instruction = (*basic_block)[i];
+      IntPtr address = instruction->getAddress();
+      IntPtr last_byte = address + instruction->getSize() - 1;
+      IntPtr first_line = address - (address % cache_line_size);
+      IntPtr last_line = last_byte - (last_byte % cache_line_size);
+      if (fetched && (first_line == fetched_line) && (last_line == fetched_line))
+         continue;
+
+      core->readInstructionMemory(address, instruction->getSize());
+      fetched_line = last_line;
+      fetched = true;
+   }
+}
+
+void SamplingController::beginSample()
+{
+   getModeledCounts(m_sample_start_cycles, m_sample_start_instructions);
+}
+
+void SamplingController::endSample()
+{
+   UInt64 cycles = 0;
+   UInt64 instructions = 0;
+   getModeledCounts(cycles, instructions);
+
+   cycles -= m_sample_start_cycles;
+   instructions -= m_sample_start_instructions;
+   if (instructions == 0)
+      return;
+
+   m_sample_cpis.push_back((double) cycles / instructions);
+   m_num_detailed_instructions += instructions;
+}
+
+// Sum over the cores in this process
+void SamplingController::getModeledCounts(UInt64 &cycles, UInt64 &instructions)
+{
+   cycles = 0;
+   instructions = 0;
+
+   TileManager *tile_manager = Sim()->getTileManager();
+   for (UInt32 i = 0; i < Config::getSingleton()->getNumLocalTiles(); i++)
+   {
+      CoreModel *core_model = tile_manager->getTileFromIndex(i)->getCore()->getPerformanceModel();
+      cycles += core_model->getCycleCount();
+      instructions += core_model->getInstructionCount();
+   }
+}
+
+void SamplingController::outputSummary(std::ostream &os)
+{
+   UInt64 num_samples = m_sample_cpis.size();
+
+   double mean_cpi = 0;
+   for (UInt64 i = 0; i < num_samples; i++)
+      mean_cpi += m_sample_cpis[i];
+   if (num_samples > 0)
+      mean_cpi /= num_samples;
+
+   // 95% confidence interval of the mean CPI
+   double cpi_error = 0;
+   if (num_samples > 1)
+   {
+      double variance = 0;
+      for (UInt64 i = 0; i < num_samples; i++)
+         variance += (m_sample_cpis[i] - mean_cpi) * (m_sample_cpis[i] - mean_cpi);
+      variance /= (num_samples - 1);
+      cpi_error = 1.96 * sqrt(variance / num_samples);
+   }
+
+   os << "Sampling Summary:" << endl;
+   os << "    Period (in instructions): " << m_period << endl;
+   os << "    Detailed Interval (in instructions): " << m_detailed_interval << endl;
+   os << "    Total Instructions: " << m_num_instructions << endl;
+   os << "    Detailed Instructions: " << m_num_detailed_instructions << endl;
+   os << "    Samples: " << num_samples << endl;
+   os << "    Mean CPI: " << mean_cpi << endl;
+   os << "    CPI 95% Confidence Interval: +/- " << cpi_error;
+   if (mean_cpi > 0)
+      os << " (" << (100 * cpi_error / mean_cpi) << "%)";
+   os << endl;
+   os << "    Estimated Core Cycles: " << (UInt64) (mean_cpi * m_num_instructions)
+      << " +/- " << (UInt64) (cpi_error * m_num_instructions) << endl;
+   os << "    (The tile statistics below come from the detailed intervals only and are not scaled)" << endl;
+}
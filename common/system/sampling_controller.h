@@ -0,0 +1,87 @@
+#ifndef SAMPLING_CONTROLLER_H
+#define SAMPLING_CONTROLLER_H
+
+#include <iostream>
+#include <vector>
+
+#include "fixed_types.h"
+#include "lock.h"
+
+class BasicBlock;
+class Core;
+class CoreModel;
+
+// SMARTS-style sampled simulation
+//
+// Between the start and the end of the modeled region, the instructions of
+// the application are split into sampling units of 'period' instructions.
+// Each unit first runs with the performance models disabled (functional
+// warming: caches and coherence state are still updated), then runs its last
+// 'detailed_interval' instructions with the models enabled. The CPI of the
+// detailed intervals is extrapolated to the whole region. In functional
+// warming, the L1-I is warmed with the fetches of each basic block.
+//
+// The memory and network models are switched for all the tiles at once. The
+// core model of a tile is switched by the thread running on it at its next
+// basic block, so that the basic blocks and the dynamic info it queues stay
+// in step.
+class SamplingController
+{
+public:
+   SamplingController();
+   ~SamplingController();
+
+   // Called at the start and the end of the modeled region
+   void start();
+   void stop();
+
+   // Called by the application threads at the start of each basic block
+   void handleBasicBlock(UInt32 tile_index, BasicBlock *basic_block);
+
+   void outputSummary(std::ostream &os);
+
+private:
+   enum Phase
+   {
+      INACTIVE = 0,
+      FUNCTIONAL_WARMING,
+      DETAILED
+   };
+
+   // Instructions counted by a tile before they are added to the total
+   static const UInt64 LOCAL_COUNT_THRESHOLD = 10000;
+
+   struct LocalCount
+   {
+      UInt64 count;
+      char padding[64 - sizeof(UInt64)];
+   };
+
+   void addInstructions(UInt32 tile_index, UInt32 num_instructions);
+   void switchPhase();
+   void applyPhase(CoreModel *core_model);
+   void warmInstructionCache(Core *core, BasicBlock *basic_block);
+   void beginSample();
+   void endSample();
+   void getModeledCounts(UInt64 &cycles, UInt64 &instructions);
+
+   UInt64 m_period;
+   UInt64 m_detailed_interval;
+
+   volatile Phase m_phase;
+   // Instruction count at which the current phase ends
+   volatile UInt64 m_phase_end;
+   volatile UInt64 m_num_instructions;
+   std::vector<LocalCount> m_local_counts;
+   Lock m_lock;
+
+   // Core model counts at the start of the current sample
+   UInt64 m_sample_start_cycles;
+   UInt64 m_sample_start_instructions;
+
+   // CPI of each detailed interval
+   std::vector<double> m_sample_cpis;
+   UInt64 m_num_detailed_instructions;
+};
+
+#endif
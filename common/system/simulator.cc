@@ -15,6 +15,8 @@
 #include "clock_skew_minimization_object.h"
 #include "statistics_manager.h"
 #include "statistics_thread.h"
+#include "sampling_controller.h"
+#include "trace_capture.h"
 #include "fxsupport.h"
 #include "contrib/dsent/dsent_contrib.h"
 #include "mcpat_cache.h"
@@ -70,6 +72,8 @@ Simulator::Simulator()
    , m_clock_skew_minimization_manager(NULL)
    , m_statistics_manager(NULL)
    , m_statistics_thread(NULL)
+   , m_sampling_controller(NULL)
+   , m_trace_capture(NULL)
    , m_finished(false)
    , m_boot_time(getTime())
    , m_start_time(0)
@@ -118,6 +122,14 @@ void Simulator::start()
       m_statistics_thread->start();
    }
 
+   // For sampled simulation
+   if (m_config_file->getBool("sampling/enabled", false))
+      m_sampling_controller = new SamplingController();
+
+   // For capturing traces to be replayed without Pin
+   if (m_config_file->getBool("trace/capture", false))
+      m_trace_capture = new TraceCapture();
+
    // Save floating-point registers on context switch from user space to pin space
    Fxsupport::allocate();
 
@@ -162,6 +174,9 @@ Simulator::~Simulator()
          << "stop time\t" << (m_stop_time - m_boot_time) << endl
          << "shutdown time\t" << (m_shutdown_time - m_boot_time) << endl;
 
+      if (m_sampling_controller)
+         m_sampling_controller->outputSummary(os);
+
       m_tile_manager->outputSummary(os);
       os.close();
    }
@@ -183,6 +198,9 @@ Simulator::~Simulator()
       delete m_statistics_thread;
       delete m_statistics_manager;
    }
+
+   delete m_sampling_controller;
+   delete m_trace_capture;
   
    // Clock Skew Manager 
    if (m_clock_skew_minimization_manager)
@@ -289,17 +307,39 @@ bool Simulator::finished()
 void Simulator::enableModels()
 {
    startTimer();
-   m_enabled = true;
-   for (UInt32 i = 0; i < m_config.getNumLocalTiles(); i++)
-      m_tile_manager->getTileFromIndex(i)->enablePerformanceModels();
+
+   // With sampling, the models are enabled only in the detailed intervals,
+   // while the instrumentation runs over the whole region
+   if (m_sampling_controller)
+   {
+      m_enabled = true;
+      m_sampling_controller->start();
+   }
+   else
+   {
+      setModelsEnabled(true);
+   }
 }
 
 void Simulator::disableModels()
 {
    stopTimer();
-   m_enabled = false;
+
+   if (m_sampling_controller)
+      m_sampling_controller->stop();
+   setModelsEnabled(false);
+}
+
+void Simulator::setModelsEnabled(bool enabled)
+{
+   m_enabled = enabled;
    for (UInt32 i = 0; i < m_config.getNumLocalTiles(); i++)
-      m_tile_manager->getTileFromIndex(i)->disablePerformanceModels();
+   {
+      if (enabled)
+         m_tile_manager->getTileFromIndex(i)->enablePerformanceModels();
+      else
+         m_tile_manager->getTileFromIndex(i)->disablePerformanceModels();
+   }
 }
 
 void Simulator::enablePerformanceModelsInCurrentProcess()
@@ -17,6 +17,8 @@ class SimThreadManager;
 class ClockSkewMinimizationManager;
 class StatisticsManager;
 class StatisticsThread;
+class SamplingController;
+class TraceCapture;
 
 class Simulator
 {
@@ -41,6 +43,8 @@ public:
    ClockSkewMinimizationManager *getClockSkewMinimizationManager() { return m_clock_skew_minimization_manager; }
    StatisticsManager *getStatisticsManager() { return m_statistics_manager; } 
    StatisticsThread *getStatisticsThread() { return m_statistics_thread; } 
+   SamplingController *getSamplingController() { return m_sampling_controller; }
+   TraceCapture *getTraceCapture() { return m_trace_capture; }
    Config *getConfig() { return &m_config; }
    config::Config *getCfg() { return m_config_file; }
 
@@ -52,6 +56,8 @@ public:
 
    void enableModels();
    void disableModels();
+   // Enables/disables the models of the tiles without touching the timers or the sampling
+   void setModelsEnabled(bool enabled);
 
    bool isEnabled() const { return m_enabled; }
 
@@ -86,6 +92,8 @@ private:
    ClockSkewMinimizationManager *m_clock_skew_minimization_manager;
    StatisticsManager *m_statistics_manager;
    StatisticsThread *m_statistics_thread;
+   SamplingController *m_sampling_controller;
+   TraceCapture *m_trace_capture;
 
    static Simulator *m_singleton;
 
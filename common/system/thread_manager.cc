@@ -16,6 +16,7 @@
 #include "packetize.h"
 #include "clock_converter.h"
 #include "fxsupport.h"
+#include "trace_capture.h"
 
 ThreadManager::ThreadManager(TileManager *tile_manager)
    : m_thread_spawn_sem(0)
@@ -145,6 +146,9 @@ void ThreadManager::onThreadExit()
 {
    if (m_tile_manager->getCurrentTileID() == -1)
       return;
+
+   if (Sim()->getTraceCapture())
+      Sim()->getTraceCapture()->closeTrace();
  
    Core* core = m_tile_manager->getCurrentCore();
    Tile* tile = core->getTile();
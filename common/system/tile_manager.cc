@@ -341,6 +341,16 @@ tile_id_t TileManager::registerSimThread()
     return tile->getId();
 }
 
+void TileManager::registerCoreModelThread(Tile* tile)
+{
+    LOG_ASSERT_ERROR(getCurrentTile() == NULL, "registerCoreModelThread - Initialized thread twice");
+
+    // The model thread acts on behalf of the tile's core, so it shares the tile TLS
+    m_tile_tls->insert(tile);
+    m_tile_index_tls->insertInt(getTileIndexFromID(tile->getId()));
+    m_thread_type_tls->insertInt(CORE_MODEL_THREAD);
+}
+
 bool TileManager::amiSimThread()
 {
     return m_thread_type_tls ? (m_thread_type_tls->getInt() == SIM_THREAD) : false;
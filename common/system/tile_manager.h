@@ -24,6 +24,7 @@ public:
    void initializeThread(core_id_t core_id, thread_id_t thread_index = 0, thread_id_t thread_id = 0);
    void terminateThread();
    tile_id_t registerSimThread();
+   void registerCoreModelThread(Tile* tile);
 
    core_id_t getCurrentCoreID(); // id of currently active core (or INVALID_CORE_ID)
    tile_id_t getCurrentTileID(); // id of currently active core (or INVALID_TILE_ID)
@@ -62,7 +63,8 @@ private:
    enum ThreadType {
        INVALID,
        APP_THREAD,
-       SIM_THREAD
+       SIM_THREAD,
+       CORE_MODEL_THREAD
    };
 
    bool** m_initialized_threads;
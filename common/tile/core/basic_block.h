@@ -3,17 +3,22 @@
 
 #include <vector>
 
-class Instruction;
+#include "basic_block_summary.h"
+// The destructor deletes the instructions of dynamic basic blocks
+#include "instruction.h"
 
 class BasicBlock : public std::vector<Instruction*>
 {
 public:
    BasicBlock(bool dynamic = false) 
       : m_dynamic(dynamic)
+      , m_summary(NULL)
       {}
 
    ~BasicBlock()
       {
+         delete m_summary;
+
          if (m_dynamic)
          {
             // FIXME: I think there is a bug here
@@ -26,8 +31,24 @@ public:
 
    bool isDynamic() { return m_dynamic; }
 
+   // Called once all the instructions have been added
+   void summarize()
+      {
+         if (!m_dynamic && !m_summary)
+            m_summary = new BasicBlockSummary(*this);
+      }
+
+   // NULL if the basic block has not been summarized
+   BasicBlockSummary* getSummary()
+      {
+         if (m_summary && m_summary->isStale())
+            m_summary->refresh(*this);
+         return m_summary;
+      }
+
 private:
    bool m_dynamic;
+   BasicBlockSummary *m_summary;
 };
 
 #endif
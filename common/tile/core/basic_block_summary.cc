@@ -0,0 +1,89 @@
+#include "basic_block_summary.h"
+#include "basic_block.h"
+#include "instruction.h"
+#include "log.h"
+
+volatile UInt32 BasicBlockSummary::m_current_generation = 0;
+
+static bool isSummarized(Instruction *instruction)
+{
+   return ( !instruction->isDynamic() &&
+            !instruction->requiresDynamicInfo() &&
+            (instruction->getType() != INST_SPAWN) );
+}
+
+BasicBlockSummary::BasicBlockSummary(const BasicBlock &basic_block)
+   : m_entries(basic_block.size())
+   , m_generation(0)
+{
+   for (UInt32 i = 0; i < basic_block.size(); i++)
+   {
+      Entry &entry = m_entries[i];
+      entry.run_length = 0;
+      entry.first_register = m_registers.size();
+      entry.num_read_registers = 0;
+      entry.num_write_registers = 0;
+
+      Instruction *instruction = basic_block[i];
+      if (!isSummarized(instruction))
+         continue;
+
+      const OperandList &ops = instruction->getOperands();
+      for (unsigned int j = 0; j < ops.size(); j++)
+      {
+         if ( (ops[j].m_type == Operand::REG) && (ops[j].m_direction == Operand::READ) )
+         {
+            m_registers.push_back(ops[j].m_value);
+            entry.num_read_registers ++;
+         }
+      }
+      for (unsigned int j = 0; j < ops.size(); j++)
+      {
+         if ( (ops[j].m_type == Operand::REG) && (ops[j].m_direction == Operand::WRITE) )
+         {
+            m_registers.push_back(ops[j].m_value);
+            entry.num_write_registers ++;
+         }
+      }
+   }
+
+   // Run lengths are counted from the end of the block
+   UInt32 run_length = 0;
+   for (SInt32 i = basic_block.size() - 1; i >= 0; i--)
+   {
+      run_length = isSummarized(basic_block[i]) ? (run_length + 1) : 0;
+      m_entries[i].run_length = run_length;
+   }
+
+   computeCosts(basic_block);
+}
+
+BasicBlockSummary::~BasicBlockSummary()
+{}
+
+void BasicBlockSummary::refresh(const BasicBlock &basic_block)
+{
+   ScopedLock sl(m_lock);
+
+   // Another core may have got here first
+   if (isStale())
+      computeCosts(basic_block);
+}
+
+void BasicBlockSummary::computeCosts(const BasicBlock &basic_block)
+{
+   UInt32 generation = m_current_generation;
+
+   for (UInt32 i = 0; i < basic_block.size(); i++)
+   {
+      Entry &entry = m_entries[i];
+      entry.cost = (entry.run_length > 0) ? basic_block[i]->getCost() : 0;
+   }
+
+   m_generation = generation;
+}
+
+void BasicBlockSummary::invalidateAll()
+{
+   __sync_fetch_and_add(&m_current_generation, 1);
+}
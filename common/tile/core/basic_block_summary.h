@@ -0,0 +1,71 @@
+#ifndef BASIC_BLOCK_SUMMARY_H
+#define BASIC_BLOCK_SUMMARY_H
+
+#include <vector>
+
+#include "fixed_types.h"
+#include "lock.h"
+
+class BasicBlock;
+
+// Precompiled timing information of a basic block
+//
+// A run is a sequence of consecutive static instructions that have no memory
+// operands and are not branches. They need no dynamic info and their cost is
+// fixed, so the core models can charge them without walking their operand
+// lists.
+class BasicBlockSummary
+{
+public:
+   BasicBlockSummary(const BasicBlock &basic_block);
+   ~BasicBlockSummary();
+
+   // Number of instructions from index to the end of its run (0 if the
+   // instruction at index is not part of a run)
+   UInt32 getRunLength(UInt32 index) const
+   { return m_entries[index].run_length; }
+   UInt64 getCost(UInt32 index) const
+   { return m_entries[index].cost; }
+
+   // Register operands of the instruction at index
+   UInt32 getNumReadRegisters(UInt32 index) const
+   { return m_entries[index].num_read_registers; }
+   UInt32 getReadRegister(UInt32 index, UInt32 i) const
+   { return m_registers[m_entries[index].first_register + i]; }
+   UInt32 getNumWriteRegisters(UInt32 index) const
+   { return m_entries[index].num_write_registers; }
+   UInt32 getWriteRegister(UInt32 index, UInt32 i) const
+   { return m_registers[m_entries[index].first_register + m_entries[index].num_read_registers + i]; }
+
+   bool isStale() const
+   { return (m_generation != m_current_generation); }
+   // Recomputes the static costs of the basic block
+   void refresh(const BasicBlock &basic_block);
+
+   // Called when the static instruction costs or a core frequency change
+   static void invalidateAll();
+
+private:
+   void computeCosts(const BasicBlock &basic_block);
+
+   struct Entry
+   {
+      UInt32 run_length;
+      UInt64 cost;
+      UInt32 first_register;
+      UInt16 num_read_registers;
+      UInt16 num_write_registers;
+   };
+
+   std::vector<Entry> m_entries;
+   // Read registers followed by write registers of each instruction
+   std::vector<UInt32> m_registers;
+
+   // The block may be modeled by several cores at once
+   Lock m_lock;
+   volatile UInt32 m_generation;
+
+   static volatile UInt32 m_current_generation;
+};
+
+#endif
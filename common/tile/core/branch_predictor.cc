@@ -1,6 +1,9 @@
 #include "simulator.h"
 #include "branch_predictor.h"
 #include "one_bit_branch_predictor.h"
+#include "bimodal_branch_predictor.h"
+#include "gshare_branch_predictor.h"
+#include "tage_branch_predictor.h"
 
 BranchPredictor::BranchPredictor()
 {
@@ -31,6 +34,21 @@ BranchPredictor* BranchPredictor::create()
          UInt32 size = cfg->getInt("branch_predictor/size");
          return new OneBitBranchPredictor(size);
       }
+      else if (type == "bimodal")
+      {
+         UInt32 size = cfg->getInt("branch_predictor/size");
+         return new BimodalBranchPredictor(size);
+      }
+      else if (type == "gshare")
+      {
+         UInt32 size = cfg->getInt("branch_predictor/size");
+         return new GShareBranchPredictor(size);
+      }
+      else if (type == "tage")
+      {
+         UInt32 size = cfg->getInt("branch_predictor/size");
+         return new TAGEBranchPredictor(size);
+      }
       else
       {
          LOG_PRINT_ERROR("Invalid branch predictor type.");
@@ -63,9 +81,15 @@ void BranchPredictor::initializeCounters()
    m_incorrect_predictions = 0;
 }
 
-void BranchPredictor::outputSummary(std::ostream &os)
+void BranchPredictor::outputSummary(std::ostream &os, UInt64 num_instructions)
 {
+   UInt64 num_predictions = m_correct_predictions + m_incorrect_predictions;
+   double accuracy = (num_predictions > 0) ? ((double) m_correct_predictions / num_predictions) : 0;
+   double mpki = (num_instructions > 0) ? ((double) m_incorrect_predictions * 1000 / num_instructions) : 0;
+
    os << "  Branch predictor stats:" << endl
       << "    num correct: " << m_correct_predictions << endl
-      << "    num incorrect: " << m_incorrect_predictions << endl;
+      << "    num incorrect: " << m_incorrect_predictions << endl
+      << "    accuracy: " << accuracy << endl
+      << "    MPKI: " << mpki << endl;
 }
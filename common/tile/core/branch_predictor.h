@@ -17,13 +17,22 @@ public:
    UInt64 getMispredictPenalty();
    static BranchPredictor* create();
 
-   virtual void outputSummary(std::ostream &os);
+   virtual void outputSummary(std::ostream &os, UInt64 num_instructions);
    UInt64 getNumCorrectPredictions() { return m_correct_predictions; }
    UInt64 getNumIncorrectPredictions() { return m_incorrect_predictions; }
 
 protected:
    void updateCounters(bool predicted, bool actual);
 
+   // Saturating counters of the prediction tables
+   static void updateSaturatingCounter(UInt8 &counter, bool increment, UInt8 max)
+   {
+      if (increment && (counter < max))
+         counter ++;
+      else if (!increment && (counter > 0))
+         counter --;
+   }
+
 private:
    UInt64 m_correct_predictions;
    UInt64 m_incorrect_predictions;
@@ -0,0 +1,37 @@
+#include "simulator.h"
+#include "bimodal_branch_predictor.h"
+#include "utils.h"
+#include "log.h"
+
+// Counters start weakly not-taken
+BimodalBranchPredictor::BimodalBranchPredictor(UInt32 size)
+   : m_counters(size, 1)
+   , m_mask(size - 1)
+{
+   LOG_ASSERT_ERROR(isPower2(size), "Branch predictor size(%u) must be a power of 2", size);
+}
+
+BimodalBranchPredictor::~BimodalBranchPredictor()
+{
+}
+
+bool BimodalBranchPredictor::predict(IntPtr ip, IntPtr target)
+{
+   UInt32 index = ip & m_mask;
+   return (m_counters[index] >= 2);
+}
+
+void BimodalBranchPredictor::update(bool predicted, bool actual, IntPtr ip, IntPtr target)
+{
+   updateCounters(predicted, actual);
+   UInt32 index = ip & m_mask;
+   updateSaturatingCounter(m_counters[index], actual, 3);
+}
+
+void BimodalBranchPredictor::outputSummary(std::ostream &os, UInt64 num_instructions)
+{
+   BranchPredictor::outputSummary(os, num_instructions);
+   os << "    type: bimodal (" << m_counters.size() << ")" << endl;
+   os << "    table reads per prediction: 1" << endl;
+   os << "    storage (in bytes): " << m_counters.size() * sizeof(UInt8) << endl;
+}
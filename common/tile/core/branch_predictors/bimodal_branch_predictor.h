@@ -0,0 +1,25 @@
+#ifndef BIMODAL_BRANCH_PREDICTOR_H
+#define BIMODAL_BRANCH_PREDICTOR_H
+
+#include "branch_predictor.h"
+
+#include <vector>
+
+// Table of 2-bit saturating counters indexed by the branch address
+class BimodalBranchPredictor : public BranchPredictor
+{
+public:
+   BimodalBranchPredictor(UInt32 size);
+   ~BimodalBranchPredictor();
+
+   bool predict(IntPtr ip, IntPtr target);
+   void update(bool predicted, bool actual, IntPtr ip, IntPtr target);
+
+   void outputSummary(std::ostream &os, UInt64 num_instructions);
+
+private:
+   std::vector<UInt8> m_counters;
+   UInt32 m_mask;
+};
+
+#endif
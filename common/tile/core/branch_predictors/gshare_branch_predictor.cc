@@ -0,0 +1,37 @@
+#include "simulator.h"
+#include "gshare_branch_predictor.h"
+#include "utils.h"
+#include "log.h"
+
+// Counters start weakly not-taken
+GShareBranchPredictor::GShareBranchPredictor(UInt32 size)
+   : m_counters(size, 1)
+   , m_mask(size - 1)
+   , m_history(0)
+{
+   LOG_ASSERT_ERROR(isPower2(size), "Branch predictor size(%u) must be a power of 2", size);
+}
+
+GShareBranchPredictor::~GShareBranchPredictor()
+{
+}
+
+bool GShareBranchPredictor::predict(IntPtr ip, IntPtr target)
+{
+   return (m_counters[getIndex(ip)] >= 2);
+}
+
+void GShareBranchPredictor::update(bool predicted, bool actual, IntPtr ip, IntPtr target)
+{
+   updateCounters(predicted, actual);
+   updateSaturatingCounter(m_counters[getIndex(ip)], actual, 3);
+   m_history = ((m_history << 1) | (actual ? 1 : 0)) & m_mask;
+}
+
+void GShareBranchPredictor::outputSummary(std::ostream &os, UInt64 num_instructions)
+{
+   BranchPredictor::outputSummary(os, num_instructions);
+   os << "    type: gshare (" << m_counters.size() << ")" << endl;
+   os << "    table reads per prediction: 1" << endl;
+   os << "    storage (in bytes): " << m_counters.size() * sizeof(UInt8) << endl;
+}
@@ -0,0 +1,30 @@
+#ifndef GSHARE_BRANCH_PREDICTOR_H
+#define GSHARE_BRANCH_PREDICTOR_H
+
+#include "branch_predictor.h"
+
+#include <vector>
+
+// Table of 2-bit saturating counters indexed by the branch address
+// XORed with the global branch history
+class GShareBranchPredictor : public BranchPredictor
+{
+public:
+   GShareBranchPredictor(UInt32 size);
+   ~GShareBranchPredictor();
+
+   bool predict(IntPtr ip, IntPtr target);
+   void update(bool predicted, bool actual, IntPtr ip, IntPtr target);
+
+   void outputSummary(std::ostream &os, UInt64 num_instructions);
+
+private:
+   UInt32 getIndex(IntPtr ip) { return (ip ^ m_history) & m_mask; }
+
+   std::vector<UInt8> m_counters;
+   UInt32 m_mask;
+   // As many outcomes as there are index bits
+   UInt32 m_history;
+};
+
+#endif
@@ -2,7 +2,7 @@
 #include "one_bit_branch_predictor.h"
 
 OneBitBranchPredictor::OneBitBranchPredictor(UInt32 size)
-   : m_bits(size)
+   : m_bits(size, 0)
 {
 }
 
@@ -13,7 +13,7 @@ OneBitBranchPredictor::~OneBitBranchPredictor()
 bool OneBitBranchPredictor::predict(IntPtr ip, IntPtr target)
 {
    UInt32 index = ip % m_bits.size();
-   return m_bits[index];
+   return (m_bits[index] != 0);
 }
 
 void OneBitBranchPredictor::update(bool predicted, bool actual, IntPtr ip, IntPtr target)
@@ -23,8 +23,10 @@ void OneBitBranchPredictor::update(bool predicted, bool actual, IntPtr ip, IntPt
    m_bits[index] = actual;
 }
 
-void OneBitBranchPredictor::outputSummary(std::ostream &os)
+void OneBitBranchPredictor::outputSummary(std::ostream &os, UInt64 num_instructions)
 {
-   BranchPredictor::outputSummary(os);
+   BranchPredictor::outputSummary(os, num_instructions);
    os << "    type: one-bit (" << m_bits.size() << ")" << endl;
+   os << "    table reads per prediction: 1" << endl;
+   os << "    storage (in bytes): " << m_bits.size() * sizeof(UInt8) << endl;
 }
@@ -14,10 +14,10 @@ public:
    bool predict(IntPtr ip, IntPtr target);
    void update(bool predicted, bool actual, IntPtr ip, IntPtr target);
 
-   void outputSummary(std::ostream &os);
+   void outputSummary(std::ostream &os, UInt64 num_instructions);
 
 private:
-   std::vector<bool> m_bits;
+   std::vector<UInt8> m_bits;
 };
 
 #endif
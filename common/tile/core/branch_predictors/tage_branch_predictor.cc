@@ -0,0 +1,144 @@
+#include "simulator.h"
+#include "tage_branch_predictor.h"
+#include "utils.h"
+#include "log.h"
+
+const UInt32 TAGEBranchPredictor::HISTORY_LENGTHS[NUM_TAGGED_TABLES] = { 5, 11, 22, 44 };
+
+// Every table (the base table and each tagged table) has size entries
+TAGEBranchPredictor::TAGEBranchPredictor(UInt32 size)
+   : m_size(size)
+   , m_base_counters(size, 1)
+   , m_tags(NUM_TAGGED_TABLES * size, 0)
+   , m_counters(NUM_TAGGED_TABLES * size, 3)
+   , m_useful(NUM_TAGGED_TABLES * size, 0)
+   , m_history(0)
+   , m_num_updates(0)
+   , m_lookup_ip(0)
+   , m_lookup_valid(false)
+   , m_base_index(0)
+   , m_provider(-1)
+   , m_provider_prediction(false)
+   , m_alt_prediction(false)
+{
+   LOG_ASSERT_ERROR(isPower2(size), "Branch predictor size(%u) must be a power of 2", size);
+   m_index_bits = floorLog2(size);
+}
+
+TAGEBranchPredictor::~TAGEBranchPredictor()
+{
+}
+
+// XORs the last length outcomes together in chunks of bits
+UInt32 TAGEBranchPredictor::foldHistory(UInt32 length, UInt32 bits)
+{
+   UInt64 history = (length >= 64) ? m_history : (m_history & ((1ULL << length) - 1));
+   UInt32 folded = 0;
+   while (history)
+   {
+      folded ^= (UInt32) (history & ((1ULL << bits) - 1));
+      history >>= bits;
+   }
+   return folded;
+}
+
+void TAGEBranchPredictor::lookup(IntPtr ip)
+{
+   UInt32 index_mask = m_size - 1;
+   UInt32 tag_mask = (1 << TAG_BITS) - 1;
+
+   m_base_index = ip & index_mask;
+
+   m_provider = -1;
+   SInt32 alt_provider = -1;
+   for (SInt32 i = 0; i < NUM_TAGGED_TABLES; i++)
+   {
+      m_indices[i] = i * m_size +
+                     ((ip ^ (ip >> m_index_bits) ^ foldHistory(HISTORY_LENGTHS[i], m_index_bits)) & index_mask);
+      m_lookup_tags[i] = (ip ^ (ip >> TAG_BITS) ^ (foldHistory(HISTORY_LENGTHS[i], TAG_BITS - 1) << 1)) & tag_mask;
+
+      if (m_tags[m_indices[i]] == m_lookup_tags[i])
+      {
+         alt_provider = m_provider;
+         m_provider = i;
+      }
+   }
+
+   bool base_prediction = (m_base_counters[m_base_index] >= 2);
+   m_alt_prediction = (alt_provider >= 0) ? (m_counters[m_indices[alt_provider]] >= 4) : base_prediction;
+   m_provider_prediction = (m_provider >= 0) ? (m_counters[m_indices[m_provider]] >= 4) : base_prediction;
+
+   m_lookup_ip = ip;
+   m_lookup_valid = true;
+}
+
+bool TAGEBranchPredictor::predict(IntPtr ip, IntPtr target)
+{
+   lookup(ip);
+   return m_provider_prediction;
+}
+
+void TAGEBranchPredictor::update(bool predicted, bool actual, IntPtr ip, IntPtr target)
+{
+   updateCounters(predicted, actual);
+
+   if (!m_lookup_valid || (m_lookup_ip != ip))
+      lookup(ip);
+   m_lookup_valid = false;
+
+   // Train the provider
+   if (m_provider >= 0)
+   {
+      UInt32 entry = m_indices[m_provider];
+      updateSaturatingCounter(m_counters[entry], actual, 7);
+      if (m_provider_prediction != m_alt_prediction)
+         updateSaturatingCounter(m_useful[entry], (m_provider_prediction == actual), 3);
+   }
+   else
+   {
+      updateSaturatingCounter(m_base_counters[m_base_index], actual, 3);
+   }
+
+   // Allocate an entry in a longer history table on a misprediction
+   if ((m_provider_prediction != actual) && (m_provider < (NUM_TAGGED_TABLES - 1)))
+   {
+      bool allocated = false;
+      for (SInt32 i = m_provider + 1; i < NUM_TAGGED_TABLES; i++)
+      {
+         UInt32 entry = m_indices[i];
+         if (m_useful[entry] == 0)
+         {
+            m_tags[entry] = m_lookup_tags[i];
+            m_counters[entry] = actual ? 4 : 3;
+            allocated = true;
+            break;
+         }
+      }
+
+      if (!allocated)
+      {
+         for (SInt32 i = m_provider + 1; i < NUM_TAGGED_TABLES; i++)
+            updateSaturatingCounter(m_useful[m_indices[i]], false, 3);
+      }
+   }
+
+   if ((++m_num_updates % USEFUL_RESET_PERIOD) == 0)
+   {
+      for (UInt32 i = 0; i < m_useful.size(); i++)
+         m_useful[i] >>= 1;
+   }
+
+   m_history = (m_history << 1) | (actual ? 1 : 0);
+}
+
+void TAGEBranchPredictor::outputSummary(std::ostream &os, UInt64 num_instructions)
+{
+   BranchPredictor::outputSummary(os, num_instructions);
+   os << "    type: tage (" << m_size << ")" << endl;
+   os << "    table reads per prediction: " << (1 + NUM_TAGGED_TABLES) << endl;
+   os << "    storage (in bytes): "
+      << (m_base_counters.size() * sizeof(UInt8) +
+          m_tags.size() * sizeof(UInt16) +
+          m_counters.size() * sizeof(UInt8) +
+          m_useful.size() * sizeof(UInt8)) << endl;
+}
@@ -0,0 +1,62 @@
+#ifndef TAGE_BRANCH_PREDICTOR_H
+#define TAGE_BRANCH_PREDICTOR_H
+
+#include "branch_predictor.h"
+
+#include <vector>
+
+// Small TAGE (TAgged GEometric history length) predictor
+//
+// A bimodal base table backed by NUM_TAGGED_TABLES tagged tables, indexed by the
+// branch address hashed with geometrically longer global histories. The
+// longest matching table provides the prediction. Entries are allocated in
+// longer tables on mispredictions.
+class TAGEBranchPredictor : public BranchPredictor
+{
+public:
+   TAGEBranchPredictor(UInt32 size);
+   ~TAGEBranchPredictor();
+
+   bool predict(IntPtr ip, IntPtr target);
+   void update(bool predicted, bool actual, IntPtr ip, IntPtr target);
+
+   void outputSummary(std::ostream &os, UInt64 num_instructions);
+
+private:
+   enum
+   {
+      NUM_TAGGED_TABLES = 4,
+      TAG_BITS = 10
+   };
+   static const UInt32 HISTORY_LENGTHS[NUM_TAGGED_TABLES];
+   // Useful counters are aged every so many branches
+   static const UInt64 USEFUL_RESET_PERIOD = 256 * 1024;
+
+   void lookup(IntPtr ip);
+   UInt32 foldHistory(UInt32 length, UInt32 bits);
+
+   UInt32 m_size;
+   UInt32 m_index_bits;
+
+   // Base table of 2-bit counters
+   std::vector<UInt8> m_base_counters;
+   // Tagged tables, one after the other, of 3-bit counters and 2-bit useful counters
+   std::vector<UInt16> m_tags;
+   std::vector<UInt8> m_counters;
+   std::vector<UInt8> m_useful;
+
+   UInt64 m_history;
+   UInt64 m_num_updates;
+
+   // Result of the last lookup, reused by the update of the same branch
+   IntPtr m_lookup_ip;
+   bool m_lookup_valid;
+   UInt32 m_base_index;
+   UInt32 m_indices[NUM_TAGGED_TABLES];
+   UInt16 m_lookup_tags[NUM_TAGGED_TABLES];
+   SInt32 m_provider;
+   bool m_provider_prediction;
+   bool m_alt_prediction;
+};
+
+#endif
@@ -1,8 +1,10 @@
 #include "tile.h"
 #include "core.h"
 #include "core_model.h"
+#include "core_model_thread.h"
 #include "simple_core_model.h"
 #include "iocoom_core_model.h"
+#include "interval_core_model.h"
 #include "branch_predictor.h"
 #include "simulator.h"
 #include "tile_manager.h"
@@ -19,6 +21,8 @@ CoreModel* CoreModel::create(Core* core)
       return new IOCOOMCoreModel(core, frequency);
    else if (core_model == "simple")
       return new SimpleCoreModel(core, frequency);
+   else if (core_model == "interval")
+      return new IntervalCoreModel(core, frequency);
    else
    {
       LOG_PRINT_ERROR("Invalid perf model type: %s", core_model.c_str());
@@ -36,7 +40,10 @@ CoreModel::CoreModel(Core *core, float frequency)
    , m_total_time(0)
    , m_checkpointed_cycle_count(0)
    , m_enabled(false)
+   , m_dynamic_info_queue(DYNAMIC_INFO_QUEUE_SIZE)
    , m_current_ins_index(0)
+   , m_model_thread(NULL)
+   , m_use_model_thread(false)
    , m_bp(0)
 {
    // Create Branch Predictor
@@ -44,10 +51,20 @@ CoreModel::CoreModel(Core *core, float frequency)
 
    // Initialize Pipeline Stall Counters
    initializePipelineStallCounters();
+
+   try
+   {
+      m_use_model_thread = Sim()->getCfg()->getBool("core/performance_model_thread", false);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read core/performance_model_thread from the cfg file");
+   }
 }
 
 CoreModel::~CoreModel()
 {
+   delete m_model_thread; m_model_thread = 0;
    delete m_bp; m_bp = 0;
 }
 
@@ -67,7 +84,10 @@ void CoreModel::outputSummary(ostream& os)
 
    // Branch Predictor Summary
    if (m_bp)
-      m_bp->outputSummary(os);
+      m_bp->outputSummary(os, m_instruction_count);
+
+   if (m_model_thread)
+      m_model_thread->outputSummary(os);
 }
 
 void CoreModel::enable()
@@ -77,6 +97,13 @@ void CoreModel::enable()
    if (m_core->getTile()->getId() >= (tile_id_t) Config::getSingleton()->getApplicationTiles())
       return;
 
+   // The model thread is started the first time the model is enabled
+   if (m_use_model_thread && !m_model_thread)
+   {
+      m_model_thread = new CoreModelThread(this);
+      m_model_thread->spawn();
+   }
+
    m_enabled = true;
    LOG_PRINT("enable() end");
 }
@@ -84,6 +111,35 @@ void CoreModel::enable()
 void CoreModel::disable()
 {
    m_enabled = false;
+
+   // Nothing more is queued from here on, so let the model thread finish its backlog
+   if (m_model_thread)
+      m_model_thread->drain();
+}
+
+void CoreModel::discardQueuedInstructions()
+{
+   LOG_ASSERT_ERROR(!m_enabled, "Queued instructions discarded with the model enabled");
+
+   if (m_model_thread)
+   {
+      m_model_thread->discard();
+      return;
+   }
+
+   ScopedLock sl(m_basic_block_queue_lock);
+
+   while (!m_basic_block_queue.empty())
+   {
+      BasicBlock *bb = m_basic_block_queue.front();
+      if (bb->isDynamic())
+         delete bb;
+      m_basic_block_queue.pop();
+   }
+   m_current_ins_index = 0;
+
+   while (!m_dynamic_info_queue.empty())
+      m_dynamic_info_queue.pop();
 }
 
 // This function is called:
@@ -91,6 +147,7 @@ void CoreModel::disable()
 void CoreModel::updateInternalVariablesOnFrequencyChange(volatile float frequency)
 {
    recomputeAverageFrequency();
+   BasicBlockSummary::invalidateAll();
    
    volatile float old_frequency = m_frequency;
    volatile float new_frequency = frequency;
@@ -119,6 +176,8 @@ void CoreModel::setCycleCount(UInt64 cycle_count)
 // 2) Whenever frequency is changed
 void CoreModel::recomputeAverageFrequency()
 {
+   synchronize();
+
    volatile double cycles_elapsed = (double) (m_cycle_count - m_checkpointed_cycle_count);
    volatile double total_cycles_executed = (m_average_frequency * m_total_time) + cycles_elapsed;
    volatile double total_time_taken = m_total_time + (cycles_elapsed / m_frequency);
@@ -169,6 +228,13 @@ void CoreModel::queueDynamicInstruction(Instruction *i)
 
    BasicBlock *bb = new BasicBlock(true);
    bb->push_back(i);
+
+   if (m_model_thread)
+   {
+      m_model_thread->queueBasicBlock(bb);
+      return;
+   }
+
    ScopedLock sl(m_basic_block_queue_lock);
    m_basic_block_queue.push(bb);
 }
@@ -178,17 +244,26 @@ void CoreModel::queueBasicBlock(BasicBlock *basic_block)
    if (!m_enabled || !Config::getSingleton()->getEnablePerformanceModeling())
       return;
 
+   if (m_model_thread)
+   {
+      m_model_thread->queueBasicBlock(basic_block);
+      return;
+   }
+
    ScopedLock sl(m_basic_block_queue_lock);
    m_basic_block_queue.push(basic_block);
 }
 
 void CoreModel::iterate()
 {
-   // Because we will sometimes not have info available (we will throw
-   // a DynamicInstructionInfoNotAvailable), we need to be able to
-   // continue from the middle of a basic block. m_current_ins_index
-   // tracks which instruction we are currently on within the basic
-   // block.
+   // Because we will sometimes not have info available (handleInstruction()
+   // returns INSTRUCTION_NEEDS_INFO), we need to be able to continue from
+   // the middle of a basic block. m_current_ins_index tracks which
+   // instruction we are currently on within the basic block.
+
+   // The model thread does the work
+   if (m_model_thread)
+      return;
 
    ScopedLock sl(m_basic_block_queue_lock);
 
@@ -197,32 +272,65 @@ void CoreModel::iterate()
       LOG_PRINT("Basic Block Queue Size(%lu)", m_basic_block_queue.size());
       BasicBlock *current_bb = m_basic_block_queue.front();
 
-      try
+      if (!modelInstructions(current_bb, m_current_ins_index))
+      {
+         LOG_PRINT("Dynamic Instruction Info not available");
+         return;
+      }
+
+      if (current_bb->isDynamic())
+         delete current_bb;
+
+      m_basic_block_queue.pop();
+      m_current_ins_index = 0; // move to beginning of next bb
+   }
+}
+
+bool CoreModel::modelInstructions(BasicBlock *basic_block, UInt32 &index)
+{
+   BasicBlockSummary *summary = basic_block->getSummary();
+
+   while (index < basic_block->size())
+   {
+      UInt32 run_length = summary ? summary->getRunLength(index) : 0;
+      if (run_length > 0)
       {
-         for( ; m_current_ins_index < current_bb->size(); m_current_ins_index++)
-         {
-            try
-            {
-               handleInstruction(current_bb->at(m_current_ins_index));
-            }
-            catch (AbortInstructionException)
-            {
-               // move on to next ...
-            }
-         }
-
-         if (current_bb->isDynamic())
-            delete current_bb;
-
-         m_basic_block_queue.pop();
-         m_current_ins_index = 0; // move to beginning of next bb
+         handleInstructionRun(basic_block, index, *summary);
+         index += run_length;
       }
-      catch (DynamicInstructionInfoNotAvailableException)
+      // Aborted instructions just move on to the next one
+      else if (handleInstruction(basic_block->at(index)) == INSTRUCTION_NEEDS_INFO)
       {
-         LOG_PRINT("Throwing DynamicInstructionInfoNotAvailable!");
-         return;
+         return false;
+      }
+      else
+      {
+         index ++;
       }
    }
+   return true;
+}
+
+void CoreModel::handleInstructionRun(BasicBlock *basic_block, UInt32 index, const BasicBlockSummary &summary)
+{
+   UInt32 end = index + summary.getRunLength(index);
+   for ( ; index < end; index++)
+      handleInstruction(basic_block->at(index));
+}
+
+void CoreModel::modelBasicBlock(BasicBlock *basic_block)
+{
+   UInt32 index = 0;
+   if (!modelInstructions(basic_block, index))
+      LOG_PRINT_ERROR("Dynamic Instruction Info not available");
+
+   if (basic_block->isDynamic())
+      delete basic_block;
+}
+
+void CoreModel::synchronizeWithModelThread()
+{
+   m_model_thread->synchronize();
 }
 
 void CoreModel::pushDynamicInstructionInfo(DynamicInstructionInfo &i)
@@ -230,44 +338,68 @@ void CoreModel::pushDynamicInstructionInfo(DynamicInstructionInfo &i)
    if (!m_enabled || !Config::getSingleton()->getEnablePerformanceModeling())
       return;
 
+   if (m_model_thread)
+   {
+      m_model_thread->pushDynamicInstructionInfo(i);
+      return;
+   }
+
    LOG_PRINT("Push Info(%u)", i.type);
-   ScopedLock sl(m_dynamic_info_queue_lock);
+   LOG_ASSERT_ERROR(!m_dynamic_info_queue.full(),
+                    "Dynamic info queue is growing too big.");
    m_dynamic_info_queue.push(i);
 }
 
 void CoreModel::popDynamicInstructionInfo()
 {
+   if (m_model_thread)
+   {
+      m_model_thread->popDynamicInstructionInfo();
+      return;
+   }
+
    if (!m_enabled || !Config::getSingleton()->getEnablePerformanceModeling())
       return;
 
-   ScopedLock sl(m_dynamic_info_queue_lock);
-   LOG_ASSERT_ERROR(m_dynamic_info_queue.size() > 0,
+   LOG_ASSERT_ERROR(!m_dynamic_info_queue.empty(),
                     "Expected some dynamic info to be available.");
-   LOG_ASSERT_ERROR(m_dynamic_info_queue.size() < 5000,
-                    "Dynamic info queue is growing too big.");
    LOG_PRINT("Pop Info(%u)", m_dynamic_info_queue.front().type);
    m_dynamic_info_queue.pop();
 }
 
-DynamicInstructionInfo& CoreModel::getDynamicInstructionInfo()
+CoreModel::InstructionStatus CoreModel::getInstructionCost(Instruction *instruction, UInt64 &cost)
 {
-   ScopedLock sl(m_dynamic_info_queue_lock);
-
    // Information is needed to model the instruction, but isn't
    // available. This is handled in iterate() by returning early and
    // continuing from that instruction later.
 
-   // FIXME: Note this assumes that either none of the info for an
-   // instruction is available or all of it! This works for
-   // performance modeling in the same thread as functional modeling,
-   // but it WILL NOT work if performance modeling is moved to a
-   // separate thread!
+   // Note this assumes that either none of the info for an
+   // instruction is available or all of it! This holds for
+   // performance modeling in the same thread as functional modeling.
+   // CoreModelThread never models the newest basic block, so all the
+   // info it needs is available.
+   if (instruction->requiresDynamicInfo() && !m_model_thread && m_dynamic_info_queue.empty())
+      return INSTRUCTION_NEEDS_INFO;
 
-   if (m_dynamic_info_queue.empty())
-      throw DynamicInstructionInfoNotAvailableException();
+   if (instruction->getType() == INST_SPAWN)
+   {
+      setCycleCount(((SpawnInstruction*) instruction)->getTime());
+      return INSTRUCTION_ABORTED;
+   }
 
-   LOG_ASSERT_ERROR(m_dynamic_info_queue.size() < 5000,
-                    "Dynamic info queue is growing too big.");
+   cost = instruction->getCost();
+   return INSTRUCTION_DONE;
+}
+
+DynamicInstructionInfo& CoreModel::getDynamicInstructionInfo()
+{
+   // The model thread only models a basic block once all of its info is available
+   if (m_model_thread)
+      return m_model_thread->getDynamicInstructionInfo();
+
+   // getInstructionCost() has made sure the info is available
+   LOG_ASSERT_ERROR(!m_dynamic_info_queue.empty(),
+                    "Expected some dynamic info to be available.");
 
    LOG_PRINT("Get Info(%u)", m_dynamic_info_queue.front().type);
    return m_dynamic_info_queue.front();
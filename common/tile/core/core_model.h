@@ -9,11 +9,13 @@
 // Forward Decls
 class Core;
 class BranchPredictor;
+class CoreModelThread;
 
 #include "instruction.h"
 #include "basic_block.h"
 #include "fixed_types.h"
 #include "lock.h"
+#include "spsc_queue.h"
 #include "dynamic_instruction_info.h"
 
 class CoreModel
@@ -31,9 +33,14 @@ public:
    virtual void updateInternalVariablesOnFrequencyChange(volatile float frequency);
    void recomputeAverageFrequency(); 
 
-   UInt64 getCycleCount() { return m_cycle_count; }
+   UInt64 getCycleCount() { synchronize(); return m_cycle_count; }
+   UInt64 getInstructionCount() { synchronize(); return m_instruction_count; }
    void setCycleCount(UInt64 cycle_count);
 
+   // With a separate performance model thread, waits till the model has caught
+   // up with the application thread (a no-op otherwise)
+   void synchronize() { if (m_model_thread) synchronizeWithModelThread(); }
+
    void pushDynamicInstructionInfo(DynamicInstructionInfo &i);
    void popDynamicInstructionInfo();
    DynamicInstructionInfo& getDynamicInstructionInfo();
@@ -45,12 +52,12 @@ public:
    void enable();
    void disable();
    bool isEnabled() { return m_enabled; }
+   // Drops the basic blocks and the dynamic info that have not been modeled.
+   // Called by the application thread of the core, with the model disabled.
+   void discardQueuedInstructions();
 
    virtual void outputSummary(std::ostream &os) = 0;
 
-   class AbortInstructionException { };
-
-
 protected:
    enum RegType
    {
@@ -66,7 +73,18 @@ protected:
    {
    };
 
-   friend class SpawnInstruction;
+   // Outcome of modeling an instruction
+   enum InstructionStatus
+   {
+      INSTRUCTION_DONE = 0,
+      // The dynamic info of the instruction has not been pushed yet. Nothing
+      // has been modeled and the instruction is retried later.
+      INSTRUCTION_NEEDS_INFO,
+      // The instruction is not modeled any further (e.g., a spawn)
+      INSTRUCTION_ABORTED
+   };
+
+   friend class CoreModelThread;
 
    typedef std::queue<DynamicInstructionInfo> DynamicInstructionInfoQueue;
    typedef std::queue<BasicBlock *> BasicBlockQueue;
@@ -80,11 +98,25 @@ protected:
 
    void updatePipelineStallCounters(Instruction* i, UInt64 memory_stall_cycles, UInt64 execution_unit_stall_cycles);
 
+   // Called first by handleInstruction(). Returns INSTRUCTION_DONE along with
+   // the cost if the instruction is to be modeled.
+   InstructionStatus getInstructionCost(Instruction *instruction, UInt64 &cost);
+
 private:
 
-   class DynamicInstructionInfoNotAvailableException { };
+   static const UInt32 DYNAMIC_INFO_QUEUE_SIZE = 4096;
 
-   virtual void handleInstruction(Instruction *instruction) = 0;
+   virtual InstructionStatus handleInstruction(Instruction *instruction) = 0;
+   // Models the run of summarized instructions that starts at index
+   // (see BasicBlockSummary). Instructions are handled one by one by default.
+   virtual void handleInstructionRun(BasicBlock *basic_block, UInt32 index, const BasicBlockSummary &summary);
+
+   // Models the instructions of a basic block from index on. Returns false
+   // if the dynamic info of an instruction is not available yet.
+   bool modelInstructions(BasicBlock *basic_block, UInt32 &index);
+   // Models all the instructions of a basic block in order
+   void modelBasicBlock(BasicBlock *basic_block);
+   void synchronizeWithModelThread();
 
    // Pipeline Stall Counters
    void initializePipelineStallCounters();
@@ -100,11 +132,15 @@ private:
    BasicBlockQueue m_basic_block_queue;
    Lock m_basic_block_queue_lock;
 
-   DynamicInstructionInfoQueue m_dynamic_info_queue;
-   Lock m_dynamic_info_queue_lock;
+   // Only accessed by the application thread of the core
+   SPSCQueue<DynamicInstructionInfo> m_dynamic_info_queue;
 
    UInt32 m_current_ins_index;
 
+   // Runs the model on its own host thread (NULL if the model runs inline)
+   CoreModelThread *m_model_thread;
+   bool m_use_model_thread;
+
    BranchPredictor *m_bp;
 
    // Pipeline Stall Counters
@@ -0,0 +1,173 @@
+#include <sched.h>
+
+#include "core_model_thread.h"
+#include "core_model.h"
+#include "core.h"
+#include "tile.h"
+#include "simulator.h"
+#include "tile_manager.h"
+#include "log.h"
+
+using std::endl;
+
+// Lets the model thread make progress on a full queue or a backlog
+static void yieldToModelThread()
+{
+   sched_yield();
+}
+
+CoreModelThread::CoreModelThread(CoreModel* core_model)
+   : m_core_model(core_model)
+   , m_thread(NULL)
+   , m_basic_block_queue(BASIC_BLOCK_QUEUE_SIZE)
+   , m_dynamic_info_queue(DYNAMIC_INFO_QUEUE_SIZE)
+   , m_producer_waiting(0)
+   , m_quit(false)
+   , m_num_synchronizations(0)
+   , m_num_stalled_synchronizations(0)
+{}
+
+CoreModelThread::~CoreModelThread()
+{
+   if (m_thread)
+   {
+      m_quit = true;
+      m_work_sem.signal();
+      m_exit_sem.wait();
+      delete m_thread;
+   }
+}
+
+void CoreModelThread::spawn()
+{
+   m_thread = Thread::create(this);
+   m_thread->run();
+}
+
+void CoreModelThread::run()
+{
+   Sim()->getTileManager()->registerCoreModelThread(m_core_model->getCore()->getTile());
+   LOG_PRINT("Core model thread starting...");
+
+   while (true)
+   {
+      // Blocks still queued at exit are left unmodeled, as with the inline model
+      if (m_quit)
+      {
+         break;
+      }
+      else if (m_basic_block_queue.size() >= 2)
+      {
+         m_core_model->modelBasicBlock(m_basic_block_queue.front());
+         m_basic_block_queue.pop();
+         notifyProducer();
+      }
+      else
+      {
+         m_work_sem.wait();
+      }
+   }
+
+   LOG_PRINT("Core model thread exiting");
+   m_exit_sem.signal();
+}
+
+void CoreModelThread::queueBasicBlock(BasicBlock* basic_block)
+{
+   while (m_basic_block_queue.full())
+      yieldToModelThread();
+
+   m_basic_block_queue.push(basic_block);
+   m_work_sem.signal();
+}
+
+void CoreModelThread::pushDynamicInstructionInfo(DynamicInstructionInfo& info)
+{
+   while (m_dynamic_info_queue.full())
+      yieldToModelThread();
+
+   m_dynamic_info_queue.push(info);
+}
+
+bool CoreModelThread::amiProducer()
+{
+   // Only the application thread running on this core feeds the model.
+   // Other threads (e.g., the sim thread) see the cycle count as it is.
+   TileManager* tile_manager = Sim()->getTileManager();
+   return ( tile_manager->amiAppThread() &&
+            (tile_manager->getCurrentCore() == m_core_model->getCore()) );
+}
+
+void CoreModelThread::synchronize()
+{
+   if (m_basic_block_queue.size() <= 1)
+      return;
+   if (!amiProducer())
+      return;
+
+   m_num_synchronizations ++;
+
+   // Announce the waiter before re-checking the queue, so that the model thread
+   // either is seen to have caught up here or sees the waiter and wakes it up
+   m_producer_waiting = 1;
+   __sync_synchronize();
+   if ( (m_basic_block_queue.size() <= 1) && __sync_bool_compare_and_swap(&m_producer_waiting, 1, 0) )
+      return;
+
+   m_num_stalled_synchronizations ++;
+   m_caught_up_sem.wait();
+}
+
+void CoreModelThread::notifyProducer()
+{
+   __sync_synchronize();
+   if ( m_producer_waiting && (m_basic_block_queue.size() <= 1) &&
+        __sync_bool_compare_and_swap(&m_producer_waiting, 1, 0) )
+   {
+      m_caught_up_sem.signal();
+   }
+}
+
+void CoreModelThread::drain()
+{
+   // A basic block is popped only after it has been modeled
+   while (m_basic_block_queue.size() > 1)
+      yieldToModelThread();
+}
+
+void CoreModelThread::discard()
+{
+   // The model thread is idle and does not look at the queues again till two
+   // basic blocks are queued, so the application thread may pop them here
+   while (!m_basic_block_queue.empty())
+   {
+      BasicBlock *basic_block = m_basic_block_queue.front();
+      if (basic_block->isDynamic())
+         delete basic_block;
+      m_basic_block_queue.pop();
+   }
+
+   while (!m_dynamic_info_queue.empty())
+      m_dynamic_info_queue.pop();
+}
+
+DynamicInstructionInfo& CoreModelThread::getDynamicInstructionInfo()
+{
+   // The info of all but the newest basic block has been pushed before the
+   // model thread starts on a block
+   LOG_ASSERT_ERROR(!m_dynamic_info_queue.empty(), "Expected some dynamic info to be available.");
+   return m_dynamic_info_queue.front();
+}
+
+void CoreModelThread::popDynamicInstructionInfo()
+{
+   LOG_ASSERT_ERROR(!m_dynamic_info_queue.empty(), "Expected some dynamic info to be available.");
+   m_dynamic_info_queue.pop();
+}
+
+void CoreModelThread::outputSummary(std::ostream& os)
+{
+   os << "    Performance Model Thread:" << endl;
+   os << "      Synchronizations: " << m_num_synchronizations << endl;
+   os << "      Stalled Synchronizations: " << m_num_stalled_synchronizations << endl;
+}
@@ -0,0 +1,76 @@
+#ifndef CORE_MODEL_THREAD_H
+#define CORE_MODEL_THREAD_H
+
+#include <iostream>
+
+#include "thread.h"
+#include "spsc_queue.h"
+#include "adaptive_semaphore.h"
+#include "basic_block.h"
+#include "dynamic_instruction_info.h"
+#include "fixed_types.h"
+
+class CoreModel;
+
+// Host thread that runs the timing model of a core, decoupled from the
+// application thread that executes it functionally
+//
+// The application thread is the only producer of basic blocks and dynamic
+// instruction info; the model thread is the only consumer. As in
+// CoreModel::iterate(), a basic block is modeled only once the next one has
+// been queued, so all of its dynamic info is already available. The
+// application thread calls synchronize() whenever it needs a timing result
+// and then waits till every block but the newest one has been modeled.
+class CoreModelThread : public Runnable
+{
+public:
+   CoreModelThread(CoreModel* core_model);
+   ~CoreModelThread();
+
+   void spawn();
+
+   // Called by the application thread
+   void queueBasicBlock(BasicBlock* basic_block);
+   void pushDynamicInstructionInfo(DynamicInstructionInfo& info);
+   void synchronize();
+
+   // Called by any thread once no more basic blocks are queued. Waits till
+   // the model thread is idle.
+   void drain();
+   // Called by the application thread once drain() has returned. Drops what
+   // is still queued.
+   void discard();
+
+   // Called by the model thread
+   DynamicInstructionInfo& getDynamicInstructionInfo();
+   void popDynamicInstructionInfo();
+
+   void outputSummary(std::ostream& os);
+
+private:
+   static const UInt32 BASIC_BLOCK_QUEUE_SIZE = 1024;
+   static const UInt32 DYNAMIC_INFO_QUEUE_SIZE = 4096;
+
+   void run();
+   bool amiProducer();
+   void notifyProducer();
+
+   CoreModel* m_core_model;
+   Thread* m_thread;
+
+   SPSCQueue<BasicBlock*> m_basic_block_queue;
+   SPSCQueue<DynamicInstructionInfo> m_dynamic_info_queue;
+
+   // Signalled on every queued basic block
+   AdaptiveSemaphore m_work_sem;
+   // Signalled when a waiting application thread has been caught up with
+   AdaptiveSemaphore m_caught_up_sem;
+   AdaptiveSemaphore m_exit_sem;
+   volatile int m_producer_waiting;
+   volatile bool m_quit;
+
+   UInt64 m_num_synchronizations;
+   UInt64 m_num_stalled_synchronizations;
+};
+
+#endif
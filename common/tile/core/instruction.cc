@@ -4,6 +4,8 @@
 #include "tile.h"
 #include "core_model.h"
 #include "branch_predictor.h"
+#include "basic_block_summary.h"
+#include "mcpat_core_interface.h"
 
 // Instruction
 
@@ -14,8 +16,15 @@ Instruction::Instruction(InstructionType type, UInt64 opcode, OperandList &opera
    , m_opcode(opcode)
    , m_address(0)
    , m_size(0)
+   , m_requires_dynamic_info(type == INST_BRANCH)
+   , m_mcpat_events(NULL)
    , m_operands(operands)
 {
+   for (unsigned int i = 0; i < m_operands.size(); i++)
+   {
+      if (m_operands[i].m_type == Operand::MEMORY)
+         m_requires_dynamic_info = true;
+   }
 }
 
 Instruction::Instruction(InstructionType type)
@@ -23,7 +32,14 @@ Instruction::Instruction(InstructionType type)
    , m_opcode(0)
    , m_address(0)
    , m_size(0)
+   , m_requires_dynamic_info(false)
+   , m_mcpat_events(NULL)
+{
+}
+
+Instruction::~Instruction()
 {
+   delete m_mcpat_events;
 }
 
 UInt64 Instruction::getCost()
@@ -69,6 +85,8 @@ void Instruction::initializeStaticInstructionModel()
        UInt32 instruction_cost = Sim()->getCfg()->getInt(key_name, 0);
        m_instruction_costs[i] = instruction_cost;
    }
+
+   BasicBlockSummary::invalidateAll();
 }
 
 // DynamicInstruction
@@ -101,13 +119,6 @@ SpawnInstruction::SpawnInstruction(UInt64 time)
    , m_time(time)
 { }
 
-UInt64 SpawnInstruction::getCost()
-{
-   CoreModel *perf = Sim()->getTileManager()->getCurrentCore()->getPerformanceModel();
-   perf->setCycleCount(m_time);
-   throw CoreModel::AbortInstructionException(); // exit out of handleInstruction
-}
-
 // BranchInstruction
 
 BranchInstruction::BranchInstruction(UInt64 opcode, OperandList &l)
@@ -5,6 +5,8 @@
 #include <vector>
 #include "fixed_types.h"
 
+class McPATInstructionEvents;
+
 enum InstructionType
 {
    INST_GENERIC,
@@ -71,7 +73,7 @@ public:
 
    Instruction(InstructionType type);
 
-   virtual ~Instruction() { };
+   virtual ~Instruction();
    virtual UInt64 getCost();
 
    static void initializeStaticInstructionModel();
@@ -93,11 +95,21 @@ public:
    { m_size = size; }
 
    bool isSimpleMemoryLoad() const;
+   // Branches and memory accesses are modeled only once their dynamic info is available
+   bool requiresDynamicInfo() const
+   { return m_requires_dynamic_info; }
    bool isDynamic() const
    { return ((m_type == INST_DYNAMIC_MISC) || (m_type == INST_RECV) || (m_type == INST_SYNC)); }
 
    void print() const;
 
+   // Power modeling events of the instruction, classified once
+   McPATInstructionEvents* getMcPATEvents() const
+   { return m_mcpat_events; }
+   // Returns false if another core has set them first
+   bool setMcPATEvents(McPATInstructionEvents *events)
+   { return __sync_bool_compare_and_swap(&m_mcpat_events, (McPATInstructionEvents*) NULL, events); }
+
 private:
    typedef std::vector<unsigned int> StaticInstructionCosts;
    static StaticInstructionCosts m_instruction_costs;
@@ -108,6 +120,10 @@ private:
    IntPtr m_address;
    UInt32 m_size;
 
+   bool m_requires_dynamic_info;
+
+   McPATInstructionEvents* volatile m_mcpat_events;
+
 protected:
    OperandList m_operands;
 };
@@ -164,12 +180,13 @@ public:
    SyncInstruction(UInt64 cost);
 };
 
-// set clock to particular time
+// set clock to particular time (see CoreModel::getInstructionCost())
 class SpawnInstruction : public Instruction
 {
 public:
    SpawnInstruction(UInt64 time);
-   UInt64 getCost();
+   UInt64 getTime() const
+   { return m_time; }
 
 private:
    UInt64 m_time;
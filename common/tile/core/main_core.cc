@@ -9,11 +9,15 @@
 #include "simulator.h"
 #include "log.h"
 #include "tile_manager.h"
+#include "trace_capture.h"
 
 using namespace std;
 
 MainCore::MainCore(Tile* tile)
    : Core(tile, MAIN_CORE_TYPE)
+   , m_last_fetched_line(0)
+   , m_last_fetched_line_version(0)
+   , m_last_fetched_line_valid(false)
 {}
 
 MainCore::~MainCore()
@@ -43,8 +47,34 @@ MainCore::readInstructionMemory(IntPtr address, UInt32 instruction_size)
 {
    LOG_PRINT("Instruction: Address(%#lx), Size(%u), Start READ", address, instruction_size);
 
+   MemoryManager* memory_manager = getMemoryManager();
+   Cache* l1_icache = memory_manager->getL1ICache();
+   UInt32 cache_line_size = memory_manager->getCacheLineSize();
+   IntPtr line = address - (address % cache_line_size);
+   bool single_line = ((address + instruction_size) <= (line + cache_line_size));
+
+   // Fast path: an L1-I hit that does not go through the memory manager
+   if ( m_last_fetched_line_valid && (line == m_last_fetched_line) && single_line &&
+        (l1_icache->getVersion() == m_last_fetched_line_version) )
+   {
+      l1_icache->recordBypassedReadHit();
+      UInt64 latency = memory_manager->getL1ICacheHitLatency();
+      getShmemPerfModel()->incrTotalMemoryAccessLatency(latency);
+      return latency;
+   }
+
+   // Read before the access, so that any line change made meanwhile (including
+   // the fill of a miss) sends the next fetch down the slow path
+   UInt32 version = l1_icache->getVersion();
+
    Byte buf[instruction_size];
-   return initiateMemoryAccess(MemComponent::L1_ICACHE, Core::NONE, Core::READ, address, buf, instruction_size).second;
+   pair<UInt32, UInt64> ret = initiateMemoryAccess(MemComponent::L1_ICACHE, Core::NONE, Core::READ, address, buf, instruction_size);
+
+   m_last_fetched_line = line;
+   m_last_fetched_line_version = version;
+   m_last_fetched_line_valid = single_line && (ret.first == 0);
+
+   return ret.second;
 }
 
 pair<UInt32, UInt64>
@@ -58,6 +88,14 @@ MainCore::initiateMemoryAccess(MemComponent::Type mem_component,
 {
    LOG_ASSERT_ERROR(Config::getSingleton()->isSimulatingSharedMemory(), "Shared Memory Disabled");
 
+   // Only the accesses of the memory operands of instructions are traced
+   TraceCapture *trace_capture = Sim()->getTraceCapture();
+   if (trace_capture && push_info && (mem_component == MemComponent::L1_DCACHE) && Sim()->isEnabled())
+      trace_capture->recordMemoryAccess(mem_op_type, lock_signal, address, data_size);
+
+   // The memory system must not be entered while the model thread may still be using it
+   getPerformanceModel()->synchronize();
+
    if (data_size == 0)
    {
       if (push_info)
@@ -70,7 +108,12 @@ MainCore::initiateMemoryAccess(MemComponent::Type mem_component,
 
    // Setting the initial time
    UInt64 initial_time = (time == 0) ? getPerformanceModel()->getCycleCount() : time;
-   UInt64 curr_time = initial_time;
+   UInt64 final_time = initial_time;
+
+   // The cache lines of a data access are independent, so their misses are all
+   // issued at the initial time and overlap (as far as the L1-D MSHRs allow)
+   // Locked accesses are performed one line after another
+   bool overlap_lines = (mem_component == MemComponent::L1_DCACHE) && (lock_signal == NONE);
 
    LOG_PRINT("Time(%llu), %s - ADDR(%#lx), data_size(%u), START",
              initial_time, ((mem_op_type == READ) ? "READ" : "WRITE"), address, data_size);
@@ -117,6 +160,8 @@ MainCore::initiateMemoryAccess(MemComponent::Type mem_component,
       LOG_PRINT("Start coreInitiateMemoryAccess: ADDR(%#lx), offset(%u), curr_size(%u), core_id(%i, %i)",
                 curr_addr_aligned, curr_offset, curr_size, getId().tile_id, getId().core_type);
 
+      UInt64 curr_time = overlap_lines ? initial_time : final_time;
+
       if (!getMemoryManager()->coreInitiateMemoryAccess(mem_component, lock_signal, mem_op_type, 
                                                         curr_addr_aligned, curr_offset, 
                                                         curr_data_buffer_head, curr_size,
@@ -131,6 +176,9 @@ MainCore::initiateMemoryAccess(MemComponent::Type mem_component,
          num_misses ++;
       }
 
+      if (final_time < curr_time)
+         final_time = curr_time;
+
       LOG_PRINT("End InitiateSharedMemReq: ADDR(%#lx), offset(%u), curr_size(%u), core_id(%i,%i)",
                 curr_addr_aligned, curr_offset, curr_size, getId().tile_id, getId().core_type);
 
@@ -138,8 +186,6 @@ MainCore::initiateMemoryAccess(MemComponent::Type mem_component,
       curr_data_buffer_head += curr_size;
    }
 
-   // Get the final cycle time
-   UInt64 final_time = curr_time;
    LOG_ASSERT_ERROR(final_time >= initial_time, "final_time(%llu) < initial_time(%llu)", final_time, initial_time);
    
    LOG_PRINT("Time(%llu), %s - ADDR(%#lx), data_size(%u), END\n", 
@@ -20,6 +20,14 @@ public:
                                              Byte* data_buf, UInt32 data_size,
                                              bool push_info = false,
                                              UInt64 time = 0);
+
+private:
+   // Line of the last instruction fetch that hit in the L1-I cache, and the
+   // version of the L1-I cache before that fetch. Fetches from the same line
+   // hit as well, as long as the L1-I cache has not changed since.
+   IntPtr m_last_fetched_line;
+   UInt32 m_last_fetched_line_version;
+   bool m_last_fetched_line_valid;
 };
 
 #endif
@@ -0,0 +1,231 @@
+#include "core.h"
+#include "interval_core_model.h"
+#include "memory_manager.h"
+#include "branch_predictor.h"
+#include "dynamic_instruction_info.h"
+#include "config.hpp"
+#include "simulator.h"
+#include "log.h"
+
+using std::endl;
+
+IntervalCoreModel::IntervalCoreModel(Core *core, float frequency)
+   : CoreModel(core, frequency)
+   , m_num_dispatched_instructions(0)
+   , m_window_start(0)
+   , m_window_latency(0)
+   , m_window_valid(false)
+{
+   config::Config *cfg = Sim()->getCfg();
+
+   try
+   {
+      m_dispatch_width = cfg->getInt("core/interval/dispatch_width", 4);
+      m_rob_size = cfg->getInt("core/interval/rob_size", 128);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Config info not available.");
+   }
+
+   LOG_ASSERT_ERROR(m_dispatch_width > 0, "Dispatch width must be > 0");
+   LOG_ASSERT_ERROR(m_rob_size > 0, "ROB size must be > 0");
+
+   initializePipelineStallCounters();
+}
+
+IntervalCoreModel::~IntervalCoreModel()
+{}
+
+void IntervalCoreModel::initializePipelineStallCounters()
+{
+   m_total_l1icache_stall_cycles = 0;
+   m_total_branch_misprediction_stall_cycles = 0;
+   m_total_long_latency_load_stall_cycles = 0;
+   m_total_long_latency_loads = 0;
+   m_total_overlapped_long_latency_loads = 0;
+}
+
+void IntervalCoreModel::outputSummary(std::ostream &os)
+{
+   CoreModel::outputSummary(os);
+
+   os << "    Interval Model:" << endl;
+   os << "      L1-I Cache Miss Stall Time (in ns): " << (UInt64) ((double) m_total_l1icache_stall_cycles / m_frequency) << endl;
+   os << "      Branch Misprediction Stall Time (in ns): " << (UInt64) ((double) m_total_branch_misprediction_stall_cycles / m_frequency) << endl;
+   os << "      Long Latency Load Stall Time (in ns): " << (UInt64) ((double) m_total_long_latency_load_stall_cycles / m_frequency) << endl;
+   os << "      Long Latency Loads: " << m_total_long_latency_loads << endl;
+   os << "      Overlapped Long Latency Loads: " << m_total_overlapped_long_latency_loads << endl;
+}
+
+void IntervalCoreModel::updateInternalVariablesOnFrequencyChange(volatile float frequency)
+{
+   volatile float old_frequency = m_frequency;
+   volatile float new_frequency = frequency;
+
+   // Update Pipeline stall counters
+   m_total_l1icache_stall_cycles = (UInt64) (((double) m_total_l1icache_stall_cycles / old_frequency) * new_frequency);
+   m_total_branch_misprediction_stall_cycles = (UInt64) (((double) m_total_branch_misprediction_stall_cycles / old_frequency) * new_frequency);
+   m_total_long_latency_load_stall_cycles = (UInt64) (((double) m_total_long_latency_load_stall_cycles / old_frequency) * new_frequency);
+
+   CoreModel::updateInternalVariablesOnFrequencyChange(frequency);
+}
+
+CoreModel::InstructionStatus IntervalCoreModel::handleInstruction(Instruction *instruction)
+{
+   // Execute this first so that instructions have the opportunity to
+   // abort further processing, or wait for their dynamic info
+   UInt64 cost = 0;
+   InstructionStatus status = getInstructionCost(instruction, cost);
+   if (status != INSTRUCTION_DONE)
+      return status;
+
+   UInt64 memory_stall_cycles = 0;
+   UInt64 execution_unit_stall_cycles = 0;
+
+   // Dynamic instructions stall the pipeline
+   if (instruction->isDynamic())
+   {
+      stall(cost);
+      m_instruction_count++;
+      updatePipelineStallCounters(instruction, 0, 0);
+      return INSTRUCTION_DONE;
+   }
+
+   // Instruction Fetch
+   UInt64 icache_stall_cycles = modelICache(instruction->getAddress(), instruction->getSize());
+   memory_stall_cycles += icache_stall_cycles;
+   m_total_l1icache_stall_cycles += icache_stall_cycles;
+
+   // Memory operands
+   const OperandList &ops = instruction->getOperands();
+   for (unsigned int i = 0; i < ops.size(); i++)
+   {
+      const Operand &o = ops[i];
+
+      if (o.m_type != Operand::MEMORY)
+         continue;
+
+      DynamicInstructionInfo &info = getDynamicInstructionInfo();
+
+      if (o.m_direction == Operand::READ)
+      {
+         LOG_ASSERT_ERROR(info.type == DynamicInstructionInfo::MEMORY_READ,
+                          "Expected memory read info, got: %d.", info.type);
+
+         UInt64 load_stall_cycles = modelLoad(info);
+         memory_stall_cycles += load_stall_cycles;
+         m_total_long_latency_load_stall_cycles += load_stall_cycles;
+      }
+      else
+      {
+         // Stores retire into the store buffer
+         LOG_ASSERT_ERROR(info.type == DynamicInstructionInfo::MEMORY_WRITE,
+                          "Expected memory write info, got: %d.", info.type);
+      }
+
+      popDynamicInstructionInfo();
+   }
+
+   // Branch Misprediction (the cost of a branch is the misprediction penalty)
+   UInt64 branch_stall_cycles = 0;
+   if ((instruction->getType() == INST_BRANCH) && (cost > 1))
+   {
+      branch_stall_cycles = cost;
+      m_total_branch_misprediction_stall_cycles += cost;
+   }
+
+   // Dispatch, then stall for the miss events
+   UInt64 dispatch_start = m_cycle_count;
+   dispatch(1);
+   stall(memory_stall_cycles + branch_stall_cycles);
+   execution_unit_stall_cycles = (m_cycle_count - dispatch_start) - memory_stall_cycles;
+
+   // update counters
+   m_instruction_count++;
+
+   // Update Common Counters
+   updatePipelineStallCounters(instruction, memory_stall_cycles, execution_unit_stall_cycles);
+
+   return INSTRUCTION_DONE;
+}
+
+void IntervalCoreModel::handleInstructionRun(BasicBlock *basic_block, UInt32 index, const BasicBlockSummary &summary)
+{
+   UInt32 run_length = summary.getRunLength(index);
+
+   // The run has no memory operands and no branches, so only I-cache misses
+   // interrupt it. Each fetch is issued at the time the previous instruction
+   // is dispatched.
+   UInt64 memory_stall_cycles = 0;
+   UInt64 dispatch_start = m_cycle_count;
+   for (UInt32 i = index; i < index + run_length; i++)
+   {
+      Instruction *instruction = basic_block->at(i);
+      UInt64 icache_stall_cycles = modelICache(instruction->getAddress(), instruction->getSize());
+      dispatch(1);
+      stall(icache_stall_cycles);
+      memory_stall_cycles += icache_stall_cycles;
+   }
+   m_total_l1icache_stall_cycles += memory_stall_cycles;
+   UInt64 execution_unit_stall_cycles = (m_cycle_count - dispatch_start) - memory_stall_cycles;
+
+   m_instruction_count += run_length;
+
+   // None of the instructions is a recv or a sync
+   updatePipelineStallCounters(basic_block->at(index), memory_stall_cycles, execution_unit_stall_cycles);
+}
+
+UInt64 IntervalCoreModel::modelICache(IntPtr ins_address, UInt32 ins_size)
+{
+   // The latency of a hit is hidden by the front-end pipeline
+   UInt64 latency = getCore()->readInstructionMemory(ins_address, ins_size);
+   UInt64 hit_latency = getCore()->getMemoryManager()->getL1ICacheHitLatency();
+   return (latency > hit_latency) ? (latency - hit_latency) : 0;
+}
+
+UInt64 IntervalCoreModel::modelLoad(const DynamicInstructionInfo &info)
+{
+   // L1-D hits are hidden by the out-of-order window
+   if (info.memory_info.num_misses == 0)
+      return 0;
+
+   UInt64 latency = info.memory_info.latency;
+   m_total_long_latency_loads ++;
+
+   // Misses within a ROB-sized window of the first one are issued before
+   // the first one completes. Only the part of their latency that extends
+   // beyond the window stalls dispatch.
+   if (m_window_valid && ((m_instruction_count - m_window_start) < m_rob_size))
+   {
+      m_total_overlapped_long_latency_loads ++;
+      if (latency <= m_window_latency)
+         return 0;
+
+      UInt64 stall_cycles = latency - m_window_latency;
+      m_window_latency = latency;
+      return stall_cycles;
+   }
+
+   m_window_valid = true;
+   m_window_start = m_instruction_count;
+   m_window_latency = latency;
+   return latency;
+}
+
+void IntervalCoreModel::dispatch(UInt32 num_instructions)
+{
+   m_num_dispatched_instructions += num_instructions;
+   m_cycle_count += (m_num_dispatched_instructions / m_dispatch_width);
+   m_num_dispatched_instructions %= m_dispatch_width;
+}
+
+// A stall ends the current dispatch group
+void IntervalCoreModel::stall(UInt64 cycles)
+{
+   if (cycles == 0)
+      return;
+
+   m_cycle_count += cycles;
+   m_num_dispatched_instructions = 0;
+}
@@ -0,0 +1,59 @@
+#ifndef INTERVAL_CORE_MODEL_H
+#define INTERVAL_CORE_MODEL_H
+
+#include "core_model.h"
+
+/*
+  Out-of-order core modeled with interval analysis.
+  Instructions are dispatched at a fixed rate (dispatch_width per cycle) and
+  only miss events interrupt the flow of instructions:
+  - L1-I misses stall dispatch for the miss latency
+  - Branch mispredictions stall dispatch for the misprediction penalty
+  - L1-D load misses stall dispatch for the miss latency once they reach the
+    head of the ROB. The load misses within a ROB-sized window of the first
+    one overlap with it and only add the part of their latency that is not
+    hidden.
+  Register dependences and execution unit latencies are assumed to be hidden
+  by the out-of-order window.
+ */
+class IntervalCoreModel : public CoreModel
+{
+public:
+   IntervalCoreModel(Core* core, float frequency);
+   ~IntervalCoreModel();
+
+   void updateInternalVariablesOnFrequencyChange(volatile float frequency);
+   void outputSummary(std::ostream &os);
+
+private:
+   InstructionStatus handleInstruction(Instruction *instruction);
+   void handleInstructionRun(BasicBlock *basic_block, UInt32 index, const BasicBlockSummary &summary);
+
+   // Each returns the number of cycles dispatch is stalled for
+   UInt64 modelICache(IntPtr ins_address, UInt32 ins_size);
+   UInt64 modelLoad(const DynamicInstructionInfo &info);
+   void dispatch(UInt32 num_instructions);
+   void stall(UInt64 cycles);
+
+   void initializePipelineStallCounters();
+
+   UInt32 m_dispatch_width;
+   UInt32 m_rob_size;
+
+   // Instructions dispatched in the current cycle
+   UInt32 m_num_dispatched_instructions;
+
+   // Window of the last long-latency load
+   UInt64 m_window_start;
+   UInt64 m_window_latency;
+   bool m_window_valid;
+
+   // Pipeline Stall Counters
+   UInt64 m_total_l1icache_stall_cycles;
+   UInt64 m_total_branch_misprediction_stall_cycles;
+   UInt64 m_total_long_latency_load_stall_cycles;
+   UInt64 m_total_long_latency_loads;
+   UInt64 m_total_overlapped_long_latency_loads;
+};
+
+#endif
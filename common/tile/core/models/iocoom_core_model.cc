@@ -32,9 +32,13 @@ IOCOOMCoreModel::IOCOOMCoreModel(Core *core, float frequency)
    initializeRegisterWaitUnitList();
    
    // For Power and AreaModeling
-   m_mcpat_core_interface = new McPATCoreInterface(
-                            cfg->getInt("core/iocoom/num_outstanding_loads", 3),
-                            cfg->getInt("core/iocoom/num_store_buffer_entries", 1));
+   m_mcpat_core_interface = NULL;
+   if (Config::getSingleton()->getEnablePowerModeling())
+   {
+      m_mcpat_core_interface = new McPATCoreInterface(
+                               cfg->getInt("core/iocoom/num_outstanding_loads", 3),
+                               cfg->getInt("core/iocoom/num_store_buffer_entries", 1));
+   }
 
    initializePipelineStallCounters();
 }
@@ -62,6 +66,9 @@ void IOCOOMCoreModel::outputSummary(std::ostream &os)
 {
    CoreModel::outputSummary(os);
 
+   if (m_mcpat_core_interface)
+      m_mcpat_core_interface->outputSummary(os);
+
 //   os << "    Total Load Buffer Stall Time (in ns): " << (UInt64) ((double) m_total_load_buffer_stall_cycles / m_frequency) << endl;
 //   os << "    Total Store Buffer Stall Time (in ns): " << (UInt64) ((double) m_total_store_buffer_stall_cycles / m_frequency) << endl;
 //   os << "    Total L1-I Cache Stall Time (in ns): " << (UInt64) ((double) m_total_l1icache_stall_cycles / m_frequency) << endl;
@@ -90,11 +97,14 @@ void IOCOOMCoreModel::updateInternalVariablesOnFrequencyChange(volatile float fr
    CoreModel::updateInternalVariablesOnFrequencyChange(frequency);
 }
 
-void IOCOOMCoreModel::handleInstruction(Instruction *instruction)
+CoreModel::InstructionStatus IOCOOMCoreModel::handleInstruction(Instruction *instruction)
 {
    // Execute this first so that instructions have the opportunity to
-   // abort further processing (via AbortInstructionException)
-   UInt64 cost = instruction->getCost();
+   // abort further processing, or wait for their dynamic info
+   UInt64 cost = 0;
+   InstructionStatus status = getInstructionCost(instruction, cost);
+   if (status != INSTRUCTION_DONE)
+      return status;
 
    // Model Instruction Fetch Stage
    UInt64 instruction_ready = m_cycle_count;
@@ -323,7 +333,10 @@ void IOCOOMCoreModel::handleInstruction(Instruction *instruction)
    updatePipelineStallCounters(instruction, memory_stall_cycles, execution_unit_stall_cycles);
 
    // Update Event Counters
-   m_mcpat_core_interface->updateEventCounters(instruction, m_cycle_count);
+   if (m_mcpat_core_interface)
+      m_mcpat_core_interface->updateEventCounters(instruction, m_cycle_count);
+
+   return INSTRUCTION_DONE;
 }
 
 pair<UInt64,UInt64>
@@ -349,6 +362,88 @@ UInt64 IOCOOMCoreModel::executeStore(UInt64 time, const DynamicInstructionInfo &
    return m_store_buffer->executeStore(time, latency, info.memory_info.addr);
 }
 
+// Same as handleInstruction() for instructions without memory operands, but
+// with the register operands and costs taken from the basic block summary
+void IOCOOMCoreModel::handleInstructionRun(BasicBlock *basic_block, UInt32 index, const BasicBlockSummary &summary)
+{
+   UInt32 end = index + summary.getRunLength(index);
+   for ( ; index < end; index++)
+   {
+      Instruction *instruction = basic_block->at(index);
+
+      // Model Instruction Fetch Stage
+      UInt64 instruction_ready = m_cycle_count;
+      UInt64 instruction_memory_access_latency = modelICache(instruction->getAddress(), instruction->getSize());
+      instruction_ready += (instruction_memory_access_latency - 1);
+
+      // Time when register operands are ready (waiting for either the load unit or the execution unit)
+      UInt64 read_register_operands_ready_load_unit_wait = instruction_ready;
+      UInt64 read_register_operands_ready_execution_unit_wait = instruction_ready;
+
+      // REG read operands
+      for (UInt32 i = 0; i < summary.getNumReadRegisters(index); i++)
+      {
+         UInt32 reg = summary.getReadRegister(index, i);
+         LOG_ASSERT_ERROR(reg < m_register_scoreboard.size(),
+                          "Register value out of range: %u", reg);
+
+         if (m_register_wait_unit_list[reg] == LOAD_UNIT)
+         {
+            if (read_register_operands_ready_load_unit_wait < m_register_scoreboard[reg])
+               read_register_operands_ready_load_unit_wait = m_register_scoreboard[reg];
+         }
+         else if (m_register_wait_unit_list[reg] == EXECUTION_UNIT)
+         {
+            if (read_register_operands_ready_execution_unit_wait < m_register_scoreboard[reg])
+               read_register_operands_ready_execution_unit_wait = m_register_scoreboard[reg];
+         }
+         else
+         {
+            LOG_ASSERT_ERROR(m_register_scoreboard[reg] <= instruction_ready,
+                             "Unrecognized Core Unit(%u)", m_register_wait_unit_list[reg]);
+         }
+      }
+
+      // No memory operands, so the read operands are ready along with the registers
+      UInt64 read_operands_ready = max<UInt64>(read_register_operands_ready_load_unit_wait,
+                                               read_register_operands_ready_execution_unit_wait);
+      UInt64 write_operands_ready = read_operands_ready + summary.getCost(index);
+
+      // REG write operands
+      for (UInt32 i = 0; i < summary.getNumWriteRegisters(index); i++)
+      {
+         UInt32 reg = summary.getWriteRegister(index, i);
+         m_register_scoreboard[reg] = write_operands_ready;
+         m_register_wait_unit_list[reg] = EXECUTION_UNIT;
+      }
+
+      UInt64 memory_stall_cycles = 0;
+      UInt64 execution_unit_stall_cycles = 0;
+
+      // L1-I Cache
+      memory_stall_cycles += (instruction_ready - m_cycle_count);
+      m_total_l1icache_stall_cycles += (instruction_ready - m_cycle_count);
+
+      // Register Read Operands
+      execution_unit_stall_cycles += (read_register_operands_ready_execution_unit_wait - instruction_ready);
+      m_total_inter_ins_execution_unit_stall_cycles += (read_register_operands_ready_execution_unit_wait - instruction_ready);
+      memory_stall_cycles += (read_operands_ready - read_register_operands_ready_execution_unit_wait);
+      m_total_inter_ins_l1dcache_read_stall_cycles += (read_operands_ready - read_register_operands_ready_execution_unit_wait);
+
+      m_cycle_count = read_operands_ready + 1;
+
+      // Update Statistics
+      m_instruction_count++;
+
+      // Update Common Pipeline Stall Counters
+      updatePipelineStallCounters(instruction, memory_stall_cycles, execution_unit_stall_cycles);
+
+      // Update Event Counters
+      if (m_mcpat_core_interface)
+         m_mcpat_core_interface->updateEventCounters(instruction, m_cycle_count);
+   }
+}
+
 UInt64 IOCOOMCoreModel::modelICache(IntPtr ins_address, UInt32 ins_size)
 {
    return getCore()->readInstructionMemory(ins_address, ins_size);
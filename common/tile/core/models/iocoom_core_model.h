@@ -31,7 +31,8 @@ private:
       EXECUTION_UNIT = 3
    };
 
-   void handleInstruction(Instruction *instruction);
+   InstructionStatus handleInstruction(Instruction *instruction);
+   void handleInstructionRun(BasicBlock *basic_block, UInt32 index, const BasicBlockSummary &summary);
 
    UInt64 modelICache(IntPtr ins_address, UInt32 ins_size);
    std::pair<UInt64,UInt64> executeLoad(UInt64 time, const DynamicInstructionInfo &);
@@ -43,11 +43,14 @@ void SimpleCoreModel::updateInternalVariablesOnFrequencyChange(volatile float fr
    CoreModel::updateInternalVariablesOnFrequencyChange(frequency);
 }
 
-void SimpleCoreModel::handleInstruction(Instruction *instruction)
+CoreModel::InstructionStatus SimpleCoreModel::handleInstruction(Instruction *instruction)
 {
    // Execute this first so that instructions have the opportunity to
-   // abort further processing (via AbortInstructionException)
-   UInt64 cost = instruction->getCost();
+   // abort further processing, or wait for their dynamic info
+   UInt64 cost = 0;
+   InstructionStatus status = getInstructionCost(instruction, cost);
+   if (status != INSTRUCTION_DONE)
+      return status;
 
    UInt64 memory_stall_cycles = 0;
    UInt64 execution_unit_stall_cycles = 0;
@@ -105,6 +108,33 @@ void SimpleCoreModel::handleInstruction(Instruction *instruction)
 
    // Update Common Counters
    updatePipelineStallCounters(instruction, memory_stall_cycles, execution_unit_stall_cycles);
+
+   return INSTRUCTION_DONE;
+}
+
+void SimpleCoreModel::handleInstructionRun(BasicBlock *basic_block, UInt32 index, const BasicBlockSummary &summary)
+{
+   UInt32 run_length = summary.getRunLength(index);
+
+   // Each fetch is issued at the time the previous instruction completes
+   UInt64 memory_stall_cycles = 0;
+   UInt64 execution_unit_stall_cycles = 0;
+   for (UInt32 i = index; i < index + run_length; i++)
+   {
+      Instruction *instruction = basic_block->at(i);
+      UInt64 instruction_memory_access_latency = modelICache(instruction->getAddress(), instruction->getSize());
+      m_cycle_count += (instruction_memory_access_latency + summary.getCost(i));
+
+      memory_stall_cycles += instruction_memory_access_latency;
+      execution_unit_stall_cycles += summary.getCost(i);
+   }
+   m_total_l1icache_stall_cycles += memory_stall_cycles;
+
+   // update counters
+   m_instruction_count += run_length;
+
+   // None of the instructions is a recv or a sync
+   updatePipelineStallCounters(basic_block->at(index), memory_stall_cycles, execution_unit_stall_cycles);
 }
 
 UInt64 SimpleCoreModel::modelICache(IntPtr ins_address, UInt32 ins_size)
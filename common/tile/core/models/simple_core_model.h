@@ -13,7 +13,8 @@ public:
    void outputSummary(std::ostream &os);
 
 private:
-   void handleInstruction(Instruction *instruction);
+   InstructionStatus handleInstruction(Instruction *instruction);
+   void handleInstructionRun(BasicBlock *basic_block, UInt32 index, const BasicBlockSummary &summary);
    
    UInt64 modelICache(IntPtr ins_address, UInt32 ins_size);
    void initializePipelineStallCounters();
@@ -1,26 +1,57 @@
+#include <unistd.h>
+#include <cstdlib>
+
 #include "address_home_lookup.h"
+#include "utils.h"
 #include "log.h"
 
 AddressHomeLookup::AddressHomeLookup(UInt32 ahl_param, vector<tile_id_t>& tile_list, UInt32 cache_line_size):
    _ahl_param(ahl_param),
-   _tile_list(tile_list),
+   _home_table(tile_list),
    _cache_line_size(cache_line_size)
 {
    LOG_ASSERT_ERROR((1 << _ahl_param) >= (SInt32) _cache_line_size,
                     "[1 << AHL param](%u) must be >= [Cache Block Size](%u)",
                     1 << _ahl_param, _cache_line_size);
    _total_modules = tile_list.size();
+   LOG_ASSERT_ERROR(_total_modules > 0, "No modules to home addresses on");
+
+   _is_power2 = isPower2(_total_modules);
+   _module_mask = _total_modules - 1;
+   _log_total_modules = _is_power2 ? floorLog2(_total_modules) : 0;
+   LOG_PRINT("AHL param(%u), total modules(%u), power of 2(%s)",
+             _ahl_param, _total_modules, _is_power2 ? "true" : "false");
 }
 
 AddressHomeLookup::~AddressHomeLookup()
 {}
 
-tile_id_t
-AddressHomeLookup::getHome(IntPtr address) const
+UInt32
+AddressHomeLookup::parseInterleavingGranularity(const string& granularity, UInt32 cache_line_size)
 {
-   SInt32 module_num = (address >> _ahl_param) % _total_modules;
-   LOG_ASSERT_ERROR(0 <= module_num && module_num < (SInt32) _total_modules, "module_num(%i), total_modules(%u)", module_num, _total_modules);
-   
-   LOG_PRINT("address(%#lx), module_num(%i)", address, module_num);
-   return (_tile_list[module_num]);
+   UInt32 num_bytes = 0;
+   if (granularity == "line")
+   {
+      num_bytes = cache_line_size;
+   }
+   else if (granularity == "page")
+   {
+      num_bytes = sysconf(_SC_PAGESIZE);
+   }
+   else
+   {
+      char* end = NULL;
+      SInt32 num_lines = strtol(granularity.c_str(), &end, 10);
+      if ((end == granularity.c_str()) || (*end != '\0') || (num_lines <= 0) || !isPower2(num_lines))
+      {
+         LOG_PRINT_ERROR("Unrecognized interleaving granularity(%s): must be 'line', 'page' or a power-of-2 number of lines",
+                         granularity.c_str());
+      }
+      num_bytes = num_lines * cache_line_size;
+   }
+
+   LOG_ASSERT_ERROR(isPower2(num_bytes) && (num_bytes >= cache_line_size),
+                    "Interleaving granularity(%u bytes) must be a power of 2 and >= cache line size(%u)",
+                    num_bytes, cache_line_size);
+   return floorLog2(num_bytes);
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <string>
 #include <vector>
 using namespace std;
 
@@ -18,16 +19,59 @@ using namespace std;
  * Maybe allow the ability to have public and private memory space?
  */
 
+// Addresses are interleaved across the modules in chunks of (1 << ahl_param) bytes.
+// With a power-of-2 number of modules, the module is picked by masking the chunk number.
+// Otherwise, the chunk number is hashed and mapped onto the modules by a multiplicative
+// reduction, which avoids a 64-bit divide on every lookup
 class AddressHomeLookup
 {
 public:
    AddressHomeLookup(UInt32 ahl_param, vector<tile_id_t>& tile_list, UInt32 cache_line_size);
    ~AddressHomeLookup();
-   tile_id_t getHome(IntPtr address) const;
+
+   tile_id_t getHome(IntPtr address) const
+   {
+      UInt64 chunk_num = (UInt64) (address >> _ahl_param);
+      UInt32 module_num = _is_power2 ? (UInt32) (chunk_num & _module_mask)
+                                     : (UInt32) (((UInt64) hashChunkNum(chunk_num) * _total_modules) >> 32);
+      return _home_table[module_num];
+   }
+
+   // Address within the share of the address space homed on a module: the bits
+   // that select the module are removed, so that the chunks of a module are
+   // contiguous. With a non-power-of-2 number of modules, the chunks of a module
+   // are spread by the hash and the address is returned unchanged.
+   IntPtr getLocalAddress(IntPtr address) const
+   {
+      if (!_is_power2)
+         return address;
+      IntPtr chunk_offset = address & ((((IntPtr) 1) << _ahl_param) - 1);
+      return ((address >> (_ahl_param + _log_total_modules)) << _ahl_param) | chunk_offset;
+   }
+   // Inverse of getLocalAddress() for the module that home_address is homed on
+   IntPtr getGlobalAddress(IntPtr local_address, IntPtr home_address) const
+   {
+      if (!_is_power2)
+         return local_address;
+      IntPtr chunk_offset = local_address & ((((IntPtr) 1) << _ahl_param) - 1);
+      IntPtr module_bits = home_address & (((IntPtr) _module_mask) << _ahl_param);
+      return ((local_address >> _ahl_param) << (_ahl_param + _log_total_modules)) | module_bits | chunk_offset;
+   }
+
+   // Returns the AHL param for an interleaving granularity given as
+   // 'line', 'page' or a power-of-2 number of cache lines
+   static UInt32 parseInterleavingGranularity(const string& granularity, UInt32 cache_line_size);
 
 private:
    UInt32 _ahl_param;
-   vector<tile_id_t> _tile_list;
+   vector<tile_id_t> _home_table;
    UInt32 _total_modules;
    UInt32 _cache_line_size;
+   bool _is_power2;
+   UInt64 _module_mask;
+   UInt32 _log_total_modules;
+
+   // Fibonacci hashing: the upper 32 bits of the product are well mixed
+   static UInt32 hashChunkNum(UInt64 chunk_num)
+   { return (UInt32) ((chunk_num * 0x9E3779B97F4A7C15ULL) >> 32); }
 };
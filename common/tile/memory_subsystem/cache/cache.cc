@@ -1,3 +1,6 @@
+#include <cstdlib>
+#include <cstring>
+#include <new>
 #include "simulator.h"
 #include "cache.h"
 #include "cache_set.h"
@@ -34,15 +37,14 @@ Cache::Cache(string name,
    , _power_model(NULL)
    , _area_model(NULL)
    , _track_miss_types(track_miss_types)
+   , _num_bypassed_read_hits(0)
+   , _version(0)
 {
    _num_sets = _cache_size / (_associativity * _line_size);
    _log_line_size = floorLog2(_line_size);
    
-   _sets = new CacheSet*[_num_sets];
-   for (UInt32 i = 0; i < _num_sets; i++)
-   {
-      _sets[i] = new CacheSet(i, caching_protocol_type, cache_level, _replacement_policy, _associativity, _line_size);
-   }
+   _cache_line_info_size = CacheLineInfo::getSize(caching_protocol_type, cache_level);
+   allocateArena(caching_protocol_type, cache_level);
 
    if (Config::getSingleton()->getEnablePowerModeling())
    {
@@ -68,9 +70,50 @@ Cache::Cache(string name,
 
 Cache::~Cache()
 {
-   for (SInt32 i = 0; i < (SInt32) _num_sets; i++)
-      delete _sets[i];
-   delete [] _sets;
+   for (UInt32 i = 0; i < _num_sets; i++)
+      _sets[i].~CacheSet();
+   free(_arena);
+}
+
+// All the sets, line info pointers, line infos and line data of the cache are carved
+// out of a single cache-line-aligned allocation (in that order) instead of thousands
+// of small scattered ones
+void
+Cache::allocateArena(CachingProtocolType caching_protocol_type, SInt32 cache_level)
+{
+   UInt32 num_lines = _num_sets * _associativity;
+
+   size_t sets_size = alignToArenaBoundary(_num_sets * sizeof(CacheSet));
+   size_t line_info_ptrs_size = alignToArenaBoundary(num_lines * sizeof(CacheLineInfo*));
+   size_t line_infos_size = alignToArenaBoundary(num_lines * _cache_line_info_size);
+   size_t lines_size = alignToArenaBoundary(num_lines * _line_size);
+
+   __attribute(__unused__) int status = posix_memalign((void**) &_arena, ARENA_ALIGNMENT,
+                                                       sets_size + line_info_ptrs_size + line_infos_size + lines_size);
+   LOG_ASSERT_ERROR(status == 0, "Could not allocate arena for cache(%s)", _name.c_str());
+
+   Byte* curr = _arena;
+   _sets = (CacheSet*) curr;
+   curr += sets_size;
+   CacheLineInfo** line_info_ptrs = (CacheLineInfo**) curr;
+   curr += line_info_ptrs_size;
+   Byte* line_infos = curr;
+   curr += line_infos_size;
+   Byte* lines = curr;
+
+   for (UInt32 i = 0; i < _num_sets; i++)
+   {
+      new (&_sets[i]) CacheSet(i, caching_protocol_type, cache_level, _replacement_policy, _associativity, _line_size,
+                               &line_info_ptrs[i * _associativity],
+                               &line_infos[i * _associativity * _cache_line_info_size], _cache_line_info_size,
+                               &lines[i * _associativity * _line_size]);
+   }
+}
+
+size_t
+Cache::alignToArenaBoundary(size_t size)
+{
+   return (size + ARENA_ALIGNMENT - 1) & ~((size_t) ARENA_ALIGNMENT - 1);
 }
 
 void
@@ -121,6 +164,7 @@ Cache::insertCacheLine(IntPtr inserted_address, CacheLineInfo* inserted_cache_li
    // Write into the data array
    set->insert(inserted_cache_line_info, fill_buf,
                eviction, evicted_cache_line_info, writeback_buf);
+   _version ++;
   
    // Evicted address 
    *evicted_address = getAddressFromTag(evicted_cache_line_info->getTag());
@@ -196,7 +240,7 @@ Cache::getCacheLineInfo(IntPtr address, CacheLineInfo* cache_line_info)
 
    // Assign it to the second argument in the function (copies it over) 
    if (line_info)
-      cache_line_info->assign(line_info);
+      memcpy((void*) cache_line_info, (void*) line_info, _cache_line_info_size);
 
    if (_enabled)
    {
@@ -236,7 +280,8 @@ Cache::setCacheLineInfo(IntPtr address, CacheLineInfo* updated_cache_line_info)
       _invalidated_address_set.insert(address);
 
    // Update the cache line info   
-   cache_line_info->assign(updated_cache_line_info);
+   memcpy((void*) cache_line_info, (void*) updated_cache_line_info, _cache_line_info_size);
+   _version ++;
    
    if (_enabled)
    {
@@ -391,9 +436,25 @@ Cache::getCacheLineStateCounters(vector<UInt64>& cache_line_state_counters) cons
    cache_line_state_counters = _cache_line_state_counters;
 }
 
+// Each bypassed read hit stands for the tag check and the data read of a hit
+void
+Cache::accountBypassedReadHits()
+{
+   UInt64 num_hits = __sync_fetch_and_and(&_num_bypassed_read_hits, 0);
+
+   _total_cache_accesses += num_hits;
+   _total_read_accesses += num_hits;
+   _tag_array_reads += num_hits;
+   _data_array_reads += num_hits;
+   if (_power_model)
+      _power_model->updateDynamicEnergy(2 * num_hits);
+}
+
 void
 Cache::outputSummary(ostream& out)
 {
+   accountBypassedReadHits();
+
    // Cache Miss Summary
    out << "  Cache " << _name << ":\n";
    out << "    Cache Accesses: " << _total_cache_accesses << endl;
@@ -461,7 +522,7 @@ CacheSet*
 Cache::getSet(IntPtr address) const
 {
    UInt32 set_num = _hash_fn->compute(address);
-   return _sets[set_num];
+   return &_sets[set_num];
 }
 
 UInt32
@@ -92,6 +92,14 @@ public:
    // Get cache line state counters
    void getCacheLineStateCounters(vector<UInt64>& cache_line_state_counters) const;
 
+   // Read hit that bypassed the cache controller (see MainCore::readInstructionMemory())
+   // Safe without the memory manager lock - the counters are updated in bulk at the end
+   void recordBypassedReadHit()
+   { if (_enabled) __sync_fetch_and_add(&_num_bypassed_read_hits, 1); }
+   // Changes whenever a line is inserted, invalidated or changes state
+   UInt32 getVersion() const
+   { return _version; }
+
    // Parse Miss Type
    static MissType parseMissType(string miss_type);
    
@@ -109,7 +117,12 @@ private:
    string _name;
    CacheCategory _cache_category;
    WritePolicy _write_policy;
-   CacheSet** _sets;
+   CacheSet* _sets;
+
+   // Single arena holding the sets, line infos and line data
+   static const UInt32 ARENA_ALIGNMENT = 64;
+   Byte* _arena;
+   UInt32 _cache_line_info_size;
 
    // Cache params
    UInt32 _cache_size;
@@ -158,7 +171,16 @@ private:
 
    // Track miss types ?
    bool _track_miss_types;
+
+   // Bypassed read hits and line changes
+   volatile UInt64 _num_bypassed_read_hits;
+   volatile UInt32 _version;
+   void accountBypassedReadHits();
   
+   // Arena allocation
+   void allocateArena(CachingProtocolType caching_protocol_type, SInt32 cache_level);
+   static size_t alignToArenaBoundary(size_t size);
+
    // Utilities
    CacheSet* getSet(IntPtr address) const;
    UInt32 getLineOffset(IntPtr address) const;
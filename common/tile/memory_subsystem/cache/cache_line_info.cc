@@ -1,6 +1,7 @@
 #include "cache_line_info.h"
 #include "pr_l1_pr_l2_dram_directory_msi/cache_line_info.h"
 #include "pr_l1_pr_l2_dram_directory_mosi/cache_line_info.h"
+#include "pr_l1_pr_l2_dram_directory_mesi/cache_line_info.h"
 #include "pr_l1_sh_l2_msi/cache_line_info.h"
 #include "log.h"
 
@@ -9,22 +10,45 @@ CacheLineInfo::CacheLineInfo(IntPtr tag, CacheState::Type cstate)
    , _cstate(cstate)
 {}
 
-CacheLineInfo::~CacheLineInfo()
-{}
+UInt32
+CacheLineInfo::getSize(CachingProtocolType caching_protocol_type, SInt32 cache_level)
+{
+   switch (caching_protocol_type)
+   {
+   case PR_L1_PR_L2_DRAM_DIRECTORY_MSI:
+      return PrL1PrL2DramDirectoryMSI::getCacheLineInfoSize(cache_level);
+
+   case PR_L1_PR_L2_DRAM_DIRECTORY_MOSI:
+      return PrL1PrL2DramDirectoryMOSI::getCacheLineInfoSize(cache_level);
+
+   case PR_L1_PR_L2_DRAM_DIRECTORY_MESI:
+      return PrL1PrL2DramDirectoryMESI::getCacheLineInfoSize(cache_level);
+
+   case PR_L1_SH_L2_MSI:
+      return PrL1ShL2MSI::getCacheLineInfoSize(cache_level);
+
+   default:
+      LOG_PRINT_ERROR("Unrecognized caching protocol type(%u)", caching_protocol_type);
+      return 0;
+   }
+}
 
 CacheLineInfo*
-CacheLineInfo::create(CachingProtocolType caching_protocol_type, SInt32 cache_level)
+CacheLineInfo::init(CachingProtocolType caching_protocol_type, SInt32 cache_level, Byte* storage)
 {
    switch (caching_protocol_type)
    {
    case PR_L1_PR_L2_DRAM_DIRECTORY_MSI:
-      return PrL1PrL2DramDirectoryMSI::createCacheLineInfo(cache_level);
+      return PrL1PrL2DramDirectoryMSI::initCacheLineInfo(cache_level, storage);
 
    case PR_L1_PR_L2_DRAM_DIRECTORY_MOSI:
-      return PrL1PrL2DramDirectoryMOSI::createCacheLineInfo(cache_level);
+      return PrL1PrL2DramDirectoryMOSI::initCacheLineInfo(cache_level, storage);
+
+   case PR_L1_PR_L2_DRAM_DIRECTORY_MESI:
+      return PrL1PrL2DramDirectoryMESI::initCacheLineInfo(cache_level, storage);
 
    case PR_L1_SH_L2_MSI:
-      return PrL1ShL2MSI::createCacheLineInfo(cache_level);
+      return PrL1ShL2MSI::initCacheLineInfo(cache_level, storage);
 
    default:
       LOG_PRINT_ERROR("Unrecognized caching protocol type(%u)", caching_protocol_type);
@@ -40,7 +64,7 @@ CacheLineInfo::invalidate()
 }
 
 void
-CacheLineInfo::assign(CacheLineInfo* cache_line_info)
+CacheLineInfo::assign(const CacheLineInfo* cache_line_info)
 {
    _tag = cache_line_info->getTag();
    _cstate = cache_line_info->getCState();
@@ -5,18 +5,23 @@
 #include "cache_utils.h"
 #include "caching_protocol_type.h"
 
+// Plain (non-virtual) cache line metadata. The per-protocol line infos derive
+// from this struct and only add plain fields, so the Cache can lay them out
+// back-to-back in its arena and copy them with memcpy
 class CacheLineInfo
 {
 // This can be extended to include other information
 // for different cache coherence protocols and cache types
 public:
    CacheLineInfo(IntPtr tag = ~0, CacheState::Type cstate = CacheState::INVALID);
-   virtual ~CacheLineInfo();
 
-   static CacheLineInfo* create(CachingProtocolType caching_protocol_type, SInt32 cache_level);
+   // Size of the protocol-specific line info for the given cache level
+   static UInt32 getSize(CachingProtocolType caching_protocol_type, SInt32 cache_level);
+   // Construct the protocol-specific line info in-place at 'storage'
+   static CacheLineInfo* init(CachingProtocolType caching_protocol_type, SInt32 cache_level, Byte* storage);
 
-   virtual void invalidate();
-   virtual void assign(CacheLineInfo* cache_line_info);
+   void invalidate();
+   void assign(const CacheLineInfo* cache_line_info);
 
    bool isValid() const                        
    { return (_tag != ((IntPtr) ~0)); }
@@ -11,6 +11,7 @@ class CachePowerModel
       ~CachePowerModel() {}
 
       void updateDynamicEnergy() { _total_dynamic_energy += _dynamic_energy; }
+      void updateDynamicEnergy(UInt64 num_accesses) { _total_dynamic_energy += (_dynamic_energy * num_accesses); }
       volatile double getTotalDynamicEnergy() { return _total_dynamic_energy; }
       volatile double getTotalStaticPower() { return _total_static_power; }
 
@@ -4,29 +4,27 @@
 #include "log.h"
 
 CacheSet::CacheSet(UInt32 set_num, CachingProtocolType caching_protocol_type, SInt32 cache_level,
-                   CacheReplacementPolicy* replacement_policy, UInt32 associativity, UInt32 line_size)
-   : _set_num(set_num)
+                   CacheReplacementPolicy* replacement_policy, UInt32 associativity, UInt32 line_size,
+                   CacheLineInfo** cache_line_info_array, Byte* cache_line_info_storage, UInt32 cache_line_info_size,
+                   Byte* lines)
+   : _cache_line_info_array(cache_line_info_array)
+   , _lines(lines)
+   , _set_num(set_num)
    , _replacement_policy(replacement_policy)
    , _associativity(associativity)
    , _line_size(line_size)
+   , _cache_line_info_size(cache_line_info_size)
 {
-   _cache_line_info_array = new CacheLineInfo*[_associativity];
    for (UInt32 i = 0; i < _associativity; i++)
    {
-      _cache_line_info_array[i] = CacheLineInfo::create(caching_protocol_type, cache_level);
+      _cache_line_info_array[i] = CacheLineInfo::init(caching_protocol_type, cache_level,
+                                                      &cache_line_info_storage[i * _cache_line_info_size]);
    }
-   _lines = new char[_associativity * _line_size];
-   
    memset(_lines, 0x00, _associativity * _line_size);
 }
 
 CacheSet::~CacheSet()
-{
-   for (UInt32 i = 0; i < _associativity; i++)
-      delete _cache_line_info_array[i];
-   delete [] _cache_line_info_array;
-   delete [] _lines;
-}
+{}
 
 void 
 CacheSet::read_line(UInt32 line_index, UInt32 offset, Byte *out_buf, UInt32 bytes)
@@ -84,7 +82,7 @@ CacheSet::insert(CacheLineInfo* inserted_cache_line_info, Byte* fill_buf,
    if (_cache_line_info_array[index]->isValid())
    {
       *eviction = true;
-      evicted_cache_line_info->assign(_cache_line_info_array[index]);
+      memcpy((void*) evicted_cache_line_info, (void*) _cache_line_info_array[index], _cache_line_info_size);
       if (writeback_buf != NULL)
          memcpy((void*) writeback_buf, &_lines[index * _line_size], _line_size);
    }
@@ -94,7 +92,7 @@ CacheSet::insert(CacheLineInfo* inserted_cache_line_info, Byte* fill_buf,
       // Get the line info for the purpose of getting the utilization and birth time
    }
 
-   _cache_line_info_array[index]->assign(inserted_cache_line_info);
+   memcpy((void*) _cache_line_info_array[index], (void*) inserted_cache_line_info, _cache_line_info_size);
    if (fill_buf != NULL)
       memcpy(&_lines[index * _line_size], (void*) fill_buf, _line_size);
 
@@ -5,11 +5,15 @@
 #include "cache_replacement_policy.h"
 
 // Everything related to cache sets
+// The line info pointers, line infos and line data of a set are not owned by the set;
+// they are carved out of the enclosing Cache's arena
 class CacheSet
 {
 public:
    CacheSet(UInt32 set_num, CachingProtocolType caching_protocol_type, SInt32 cache_level,
-            CacheReplacementPolicy* replacement_policy, UInt32 associativity, UInt32 line_size);
+            CacheReplacementPolicy* replacement_policy, UInt32 associativity, UInt32 line_size,
+            CacheLineInfo** cache_line_info_array, Byte* cache_line_info_storage, UInt32 cache_line_info_size,
+            Byte* lines);
    ~CacheSet();
 
    void read_line(UInt32 line_index, UInt32 offset, Byte *out_buf, UInt32 bytes);
@@ -20,9 +24,10 @@ public:
 
 private:
    CacheLineInfo** _cache_line_info_array;
-   char* _lines;
+   Byte* _lines;
    UInt32 _set_num;
    CacheReplacementPolicy* _replacement_policy;
    UInt32 _associativity;
    UInt32 _line_size;
+   UInt32 _cache_line_info_size;
 };
@@ -15,6 +15,7 @@ DirectoryCache::DirectoryCache(Tile* tile,
                                UInt32 max_hw_sharers,
                                UInt32 max_num_sharers,
                                UInt32 num_directory_slices,
+                               AddressHomeLookup* home_lookup,
                                string directory_access_time_str)
    : _tile(tile)
    , _caching_protocol_type(caching_protocol_type)
@@ -24,9 +25,12 @@ DirectoryCache::DirectoryCache(Tile* tile,
    , _associativity(associativity)
    , _cache_line_size(cache_line_size)
    , _num_directory_slices(num_directory_slices)
+   , _home_lookup(home_lookup)
    , _directory_access_time_str(directory_access_time_str)
    , _power_model(NULL)
    , _area_model(NULL)
+   , _directory_entry_pool_size(0)
+   , _replaced_directory_entries_high_water_mark(0)
    , _enabled(false)
 {
    LOG_PRINT("Directory Cache ctor enter");
@@ -67,7 +71,6 @@ DirectoryCache::DirectoryCache(Tile* tile,
 
    _log_num_sets = floorLog2(_num_sets);
    _log_cache_line_size = floorLog2(_cache_line_size);
-   _log_num_directory_slices = ceilLog2(_num_directory_slices); 
    
    initializeEventCounters();
 
@@ -76,6 +79,16 @@ DirectoryCache::DirectoryCache(Tile* tile,
 
 DirectoryCache::~DirectoryCache()
 {
+   for (ReplacedDirectoryEntryMap::iterator it = _replaced_directory_entry_map.begin();
+        it != _replaced_directory_entry_map.end(); it++)
+   {
+      delete it->second;
+   }
+   for (vector<DirectoryEntry*>::iterator it = _free_directory_entry_list.begin();
+        it != _free_directory_entry_list.end(); it++)
+   {
+      delete (*it);
+   }
    delete _directory;
 }
 
@@ -115,42 +128,39 @@ DirectoryCache::getDirectoryEntry(IntPtr address)
    // Assume that it always hit in the Dram Directory Cache for now
    splitAddress(address, tag, set_index);
    
-   // Find the relevant directory entry
+   // Find the relevant directory entry and the first free entry in a single pass over the set
+   DirectoryEntry* free_directory_entry = NULL;
    for (UInt32 i = 0; i < _associativity; i++)
    {
       DirectoryEntry* directory_entry = _directory->getDirectoryEntry(set_index * _associativity + i);
+      IntPtr entry_address = directory_entry->getAddress();
 
-      if (directory_entry->getAddress() == address)
+      if (entry_address == address)
       {
          if (getShmemPerfModel())
             getShmemPerfModel()->incrCycleCount(directory_entry->getLatency());
          // Simple check for now. Make sophisticated later
          return directory_entry;
       }
-   }
-
-   // Find a free directory entry if one does not currently exist
-   for (UInt32 i = 0; i < _associativity; i++)
-   {
-      DirectoryEntry* directory_entry = _directory->getDirectoryEntry(set_index * _associativity + i);
-      if (directory_entry->getAddress() == INVALID_ADDRESS)
+      else if ((entry_address == INVALID_ADDRESS) && (free_directory_entry == NULL))
       {
-         // Simple check for now. Make sophisticated later
-         directory_entry->setAddress(address);
-         return directory_entry;
+         free_directory_entry = directory_entry;
       }
    }
 
-   // Check in the _replaced_directory_entry_list
-   vector<DirectoryEntry*>::iterator it;
-   for (it = _replaced_directory_entry_list.begin(); it != _replaced_directory_entry_list.end(); it++)
+   // Use a free directory entry if one does not currently exist
+   if (free_directory_entry)
    {
-      if ((*it)->getAddress() == address)
-      {
-         return (*it);
-      }
+      // Simple check for now. Make sophisticated later
+      free_directory_entry->setAddress(address);
+      return free_directory_entry;
    }
 
+   // Check in the _replaced_directory_entry_map
+   ReplacedDirectoryEntryMap::iterator it = _replaced_directory_entry_map.find(address);
+   if (it != _replaced_directory_entry_map.end())
+      return it->second;
+
    return (DirectoryEntry*) NULL;
 }
 
@@ -177,7 +187,7 @@ DirectoryCache::replaceDirectoryEntry(IntPtr replaced_address, IntPtr address)
    splitAddress(replaced_address, tag, set_index);
 
    DirectoryEntry* replaced_directory_entry = NULL;
-   DirectoryEntry* new_directory_entry = DirectoryEntry::create(_caching_protocol_type, _directory_type, _max_hw_sharers, _max_num_sharers);
+   DirectoryEntry* new_directory_entry = allocateDirectoryEntry();
    new_directory_entry->setAddress(address);
 
    for (UInt32 i = 0; i < _associativity; i++)
@@ -192,7 +202,11 @@ DirectoryCache::replaceDirectoryEntry(IntPtr replaced_address, IntPtr address)
    }
 
    LOG_ASSERT_ERROR(replaced_directory_entry, "Could not find address(%#lx) to replace", replaced_address);
-   _replaced_directory_entry_list.push_back(replaced_directory_entry);
+   __attribute(__unused__) bool inserted =
+      _replaced_directory_entry_map.insert(make_pair(replaced_address, replaced_directory_entry)).second;
+   LOG_ASSERT_ERROR(inserted, "Address(%#lx) already being replaced", replaced_address);
+   if (_replaced_directory_entry_map.size() > _replaced_directory_entries_high_water_mark)
+      _replaced_directory_entries_high_water_mark = _replaced_directory_entry_map.size();
 
    if (_enabled)
    {
@@ -214,20 +228,38 @@ DirectoryCache::replaceDirectoryEntry(IntPtr replaced_address, IntPtr address)
 void
 DirectoryCache::invalidateDirectoryEntry(IntPtr address)
 {
-   vector<DirectoryEntry*>::iterator it;
-   for (it = _replaced_directory_entry_list.begin(); it != _replaced_directory_entry_list.end(); it++)
+   ReplacedDirectoryEntryMap::iterator it = _replaced_directory_entry_map.find(address);
+   if (it == _replaced_directory_entry_map.end())
    {
-      if ((*it)->getAddress() == address)
-      {
-         delete (*it);
-         _replaced_directory_entry_list.erase(it);
+      // Should not reach here
+      LOG_PRINT_ERROR("Address(%#lx) not found for invalidation", address);
+      return;
+   }
 
-         return;
-      }
+   releaseDirectoryEntry(it->second);
+   _replaced_directory_entry_map.erase(it);
+}
+
+DirectoryEntry*
+DirectoryCache::allocateDirectoryEntry()
+{
+   if (_free_directory_entry_list.empty())
+   {
+      _directory_entry_pool_size ++;
+      return DirectoryEntry::create(_caching_protocol_type, _directory_type, _max_hw_sharers, _max_num_sharers);
    }
 
-   // Should not reach here
-   LOG_PRINT_ERROR("Address(%#lx) not found for invalidation", address);
+   DirectoryEntry* directory_entry = _free_directory_entry_list.back();
+   _free_directory_entry_list.pop_back();
+   return directory_entry;
+}
+
+void
+DirectoryCache::releaseDirectoryEntry(DirectoryEntry* directory_entry)
+{
+   // Reset in-place so that the entry can be handed out again on the next replacement
+   directory_entry->reset();
+   _free_directory_entry_list.push_back(directory_entry);
 }
 
 void
@@ -330,13 +362,17 @@ DirectoryCache::computeDirectoryAccessTime()
 IntPtr
 DirectoryCache::computeSetIndex(IntPtr address)
 {
-   LOG_PRINT("Computing Set for address(%#lx), _log_cache_line_size(%u), _log_num_sets(%u), _log_num_directory_slices(%u)",
-             address, _log_cache_line_size, _log_num_sets, _log_num_directory_slices);
+   // The bits that select the slice are the same for all the addresses of
+   // this slice, so they are removed (whatever the interleaving granularity)
+   IntPtr local_address = _home_lookup->getLocalAddress(address);
+
+   LOG_PRINT("Computing Set for address(%#lx), local address(%#lx), _log_cache_line_size(%u), _log_num_sets(%u)",
+             address, local_address, _log_cache_line_size, _log_num_sets);
 
    IntPtr set = 0;
-   for (UInt32 i = _log_cache_line_size + _log_num_directory_slices; (i + _log_num_sets) <= (sizeof(IntPtr)*8); i += _log_num_sets)
+   for (UInt32 i = _log_cache_line_size; (i + _log_num_sets) <= (sizeof(IntPtr)*8); i += _log_num_sets)
    {
-      IntPtr addr_bits = getBits<IntPtr>(address, i + _log_num_sets, i);
+      IntPtr addr_bits = getBits<IntPtr>(local_address, i + _log_num_sets, i);
       set = set ^ addr_bits;
    }
 
@@ -352,6 +388,8 @@ DirectoryCache::outputSummary(ostream& out)
    out << "    Total Accesses: " << _total_directory_accesses << endl;
    out << "    Total Evictions: " << _total_evictions << endl;
    out << "    Total Back-Invalidations: " << _total_back_invalidations << endl;
+   out << "    Entry Pool Size: " << _directory_entry_pool_size << endl;
+   out << "    Replaced Entries High-Water Mark: " << _replaced_directory_entries_high_water_mark << endl;
 
    // The power and area model summary
    if (Config::getSingleton()->getEnablePowerModeling())
@@ -367,6 +405,8 @@ DirectoryCache::dummyOutputSummary(ostream& out, tile_id_t tile_id)
    out << "    Total Accesses: " << endl;
    out << "    Total Evictions: " << endl;
    out << "    Total Back-Invalidations: " << endl;
+   out << "    Entry Pool Size: " << endl;
+   out << "    Replaced Entries High-Water Mark: " << endl;
 
    // The power and area model summary
    if (Config::getSingleton()->getEnablePowerModeling())
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <tr1/unordered_map>
 using std::string;
 using std::ostream;
 
@@ -12,6 +13,7 @@ using std::ostream;
 #include "directory_entry.h"
 #include "directory_type.h"
 #include "caching_protocol_type.h"
+#include "address_home_lookup.h"
 
 class DirectoryCache
 {
@@ -25,6 +27,7 @@ public:
                   UInt32 max_hw_sharers,
                   UInt32 max_num_sharers,
                   UInt32 num_directory_slices,
+                  AddressHomeLookup* home_lookup,
                   string directory_access_time_str);
    ~DirectoryCache();
 
@@ -43,12 +46,11 @@ public:
 private:
    Tile* _tile;
    Directory* _directory;
-   vector<DirectoryEntry*> _replaced_directory_entry_list;
-   
-   map<IntPtr,UInt64> _address_map;
-   vector<map<IntPtr,UInt64> > _set_specific_address_map;
-   map<IntPtr,UInt64> _replaced_address_map;
-   vector<UInt64> _set_replacement_histogram;
+   // Entries that have been replaced but whose sharers are still being nullified (indexed by address)
+   typedef std::tr1::unordered_map<IntPtr,DirectoryEntry*> ReplacedDirectoryEntryMap;
+   ReplacedDirectoryEntryMap _replaced_directory_entry_map;
+   // Pool of reset entries that can be reused on a replacement
+   vector<DirectoryEntry*> _free_directory_entry_list;
 
    CachingProtocolType _caching_protocol_type;
    DirectoryType _directory_type;
@@ -63,11 +65,12 @@ private:
    UInt32 _num_sets;
    UInt32 _cache_line_size;
    UInt32 _num_directory_slices;
+   // The set index is computed from the address local to the slice
+   AddressHomeLookup* _home_lookup;
 
    UInt32 _log_num_sets;
    UInt32 _log_cache_line_size;
    UInt32 _log_num_application_tiles;
-   UInt32 _log_num_directory_slices;
 
    string _directory_access_time_str;
    UInt64 _directory_access_time;
@@ -80,6 +83,9 @@ private:
    UInt64 _total_directory_accesses;
    UInt64 _total_evictions;
    UInt64 _total_back_invalidations;
+   // Directory entry pool counters
+   UInt64 _directory_entry_pool_size;
+   UInt64 _replaced_directory_entries_high_water_mark;
 
    bool _enabled;
 
@@ -91,6 +97,10 @@ private:
    UInt64 computeDirectoryAccessTime();
 
    void initializeEventCounters();
+
+   // Directory entry pool
+   DirectoryEntry* allocateDirectoryEntry();
+   void releaseDirectoryEntry(DirectoryEntry* directory_entry);
    void splitAddress(IntPtr address, IntPtr& tag, UInt32& set_index);
 
    void updateCounters();
@@ -0,0 +1,158 @@
+#include "prefetcher.h"
+#include "stride_prefetcher.h"
+#include "stream_prefetcher.h"
+#include "address_home_lookup.h"
+#include "utils.h"
+#include "log.h"
+
+using std::endl;
+
+Prefetcher::Prefetcher(UInt32 cache_line_size, UInt32 degree, const AddressHomeLookup* home_lookup)
+   : _degree(degree)
+   , _home_lookup(home_lookup)
+   , _num_prefetches(0)
+   , _num_useful_prefetches(0)
+   , _num_late_prefetches(0)
+   , _num_useless_prefetches(0)
+   , _num_uncovered_misses(0)
+{
+   LOG_ASSERT_ERROR(isPower2(cache_line_size), "Cache line size(%u) must be a power of 2", cache_line_size);
+   LOG_ASSERT_ERROR(degree > 0, "Prefetch degree must be > 0");
+   _log_cache_line_size = floorLog2(cache_line_size);
+}
+
+Prefetcher::~Prefetcher()
+{}
+
+Prefetcher*
+Prefetcher::create(string type_str, UInt32 cache_line_size, UInt32 degree, UInt32 table_size,
+                   const AddressHomeLookup* home_lookup)
+{
+   Type type = parse(type_str);
+
+   switch (type)
+   {
+   case NONE:
+      return (Prefetcher*) NULL;
+   case STRIDE:
+      return new StridePrefetcher(cache_line_size, degree, table_size, home_lookup);
+   case STREAM:
+      return new StreamPrefetcher(cache_line_size, degree, home_lookup);
+   default:
+      LOG_PRINT_ERROR("Unrecognized Prefetcher Type(%u)", type);
+      return (Prefetcher*) NULL;
+   }
+}
+
+Prefetcher::Type
+Prefetcher::parse(string type_str)
+{
+   if (type_str == "none")
+      return NONE;
+   else if (type_str == "stride")
+      return STRIDE;
+   else if (type_str == "stream")
+      return STREAM;
+   else
+   {
+      LOG_PRINT_ERROR("Unrecognized Prefetcher Type(%s)", type_str.c_str());
+      return NUM_TYPES;
+   }
+}
+
+void
+Prefetcher::train(IntPtr address, vector<IntPtr>& prefetch_list)
+{
+   vector<IntPtr> candidate_list;
+   if (_home_lookup)
+      computePrefetchCandidates(_home_lookup->getLocalAddress(address), candidate_list);
+   else
+      computePrefetchCandidates(address, candidate_list);
+
+   // Lines already on their way need not be requested again
+   for (vector<IntPtr>::iterator it = candidate_list.begin(); it != candidate_list.end(); it++)
+   {
+      IntPtr candidate = _home_lookup ? _home_lookup->getGlobalAddress(*it, address) : *it;
+      if ( !isOutstanding(candidate) && (_prefetched_line_map.find(candidate) == _prefetched_line_map.end()) )
+         prefetch_list.push_back(candidate);
+   }
+}
+
+void
+Prefetcher::recordIssue(IntPtr address)
+{
+   _outstanding_prefetch_map.insert(std::make_pair(address, false));
+   _num_prefetches ++;
+}
+
+void
+Prefetcher::recordFill(IntPtr address, UInt64 fill_time)
+{
+   OutstandingPrefetchMap::iterator it = _outstanding_prefetch_map.find(address);
+   LOG_ASSERT_ERROR(it != _outstanding_prefetch_map.end(), "Address(%#lx) not prefetched", address);
+
+   bool demanded = it->second;
+   _outstanding_prefetch_map.erase(it);
+   if (!demanded)
+      _prefetched_line_map[address] = fill_time;
+}
+
+void
+Prefetcher::recordLateDemandMiss(IntPtr address)
+{
+   OutstandingPrefetchMap::iterator it = _outstanding_prefetch_map.find(address);
+   LOG_ASSERT_ERROR(it != _outstanding_prefetch_map.end(), "Address(%#lx) not prefetched", address);
+
+   // Count a prefetch only once, however many misses wait on it
+   if (it->second)
+      return;
+
+   it->second = true;
+   _num_useful_prefetches ++;
+   _num_late_prefetches ++;
+}
+
+bool
+Prefetcher::recordDemandAccess(IntPtr address, UInt64& time)
+{
+   PrefetchedLineMap::iterator it = _prefetched_line_map.find(address);
+   if (it == _prefetched_line_map.end())
+      return false;
+
+   UInt64 fill_time = it->second;
+   _prefetched_line_map.erase(it);
+   _num_useful_prefetches ++;
+
+   if (fill_time > time)
+   {
+      _num_late_prefetches ++;
+      time = fill_time;
+   }
+   return true;
+}
+
+void
+Prefetcher::recordEviction(IntPtr address)
+{
+   if (_prefetched_line_map.erase(address) > 0)
+      _num_useless_prefetches ++;
+}
+
+void
+Prefetcher::outputSummary(ostream& out)
+{
+   UInt64 num_demand_misses = _num_useful_prefetches + _num_uncovered_misses;
+   UInt64 num_timely_prefetches = _num_useful_prefetches - _num_late_prefetches;
+
+   out << "    Prefetcher:" << endl;
+   out << "      Prefetches: " << _num_prefetches << endl;
+   out << "      Useful Prefetches: " << _num_useful_prefetches << endl;
+   out << "      Late Prefetches: " << _num_late_prefetches << endl;
+   out << "      Useless Prefetches: " << _num_useless_prefetches << endl;
+   out << "      Accuracy: "
+       << ((_num_prefetches > 0) ? (100.0 * _num_useful_prefetches / _num_prefetches) : 0) << endl;
+   out << "      Coverage: "
+       << ((num_demand_misses > 0) ? (100.0 * _num_useful_prefetches / num_demand_misses) : 0) << endl;
+   out << "      Timeliness: "
+       << ((_num_useful_prefetches > 0) ? (100.0 * num_timely_prefetches / _num_useful_prefetches) : 0) << endl;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <tr1/unordered_map>
+using std::ostream;
+using std::string;
+using std::vector;
+
+#include "fixed_types.h"
+
+class AddressHomeLookup;
+
+// Hardware prefetcher attached to an L2 cache controller
+// The controller trains it on demand misses (and on demand hits to prefetched
+// lines), issues the returned candidates through its normal miss path and
+// reports fills, demand uses and evictions back so that accuracy, coverage
+// and timeliness can be measured
+//
+// With a home lookup (a shared L2 slice), the prefetcher is trained on and
+// computes its candidates in the address space homed on the slice, so that
+// the next lines are the next ones the slice is the home of
+class Prefetcher
+{
+public:
+   enum Type
+   {
+      NONE = 0,
+      STRIDE,
+      STREAM,
+      NUM_TYPES
+   };
+
+   Prefetcher(UInt32 cache_line_size, UInt32 degree, const AddressHomeLookup* home_lookup);
+   virtual ~Prefetcher();
+
+   // Returns NULL for 'none'
+   static Prefetcher* create(string type_str, UInt32 cache_line_size, UInt32 degree, UInt32 table_size,
+                             const AddressHomeLookup* home_lookup = NULL);
+   static Type parse(string type_str);
+
+   // Trains on a demand access to 'address' and returns the lines to prefetch
+   void train(IntPtr address, vector<IntPtr>& prefetch_list);
+
+   bool isOutstanding(IntPtr address)
+   { return (_outstanding_prefetch_map.find(address) != _outstanding_prefetch_map.end()); }
+   UInt32 getNumOutstanding() { return _outstanding_prefetch_map.size(); }
+
+   // Bookkeeping of prefetches issued by the cache controller
+   void recordIssue(IntPtr address);
+   void recordFill(IntPtr address, UInt64 fill_time);
+   // A demand miss to a line whose prefetch is still outstanding
+   void recordLateDemandMiss(IntPtr address);
+   // A demand miss not covered by any prefetch
+   void recordDemandMiss() { _num_uncovered_misses ++; }
+   // A demand access to a line present in the cache
+   // Returns true if the line was prefetched and moves 'time' up to its fill
+   bool recordDemandAccess(IntPtr address, UInt64& time);
+   // The line is evicted or invalidated
+   void recordEviction(IntPtr address);
+
+   void outputSummary(ostream& out);
+
+protected:
+   UInt32 _log_cache_line_size;
+   UInt32 _degree;
+   const AddressHomeLookup* _home_lookup;
+
+   // Prefetch candidates must stay within the page of the access
+   static const UInt32 _log_page_size = 12;
+
+   IntPtr getLineNum(IntPtr address) { return (address >> _log_cache_line_size); }
+   IntPtr getPageNum(IntPtr address) { return (address >> _log_page_size); }
+
+   virtual void computePrefetchCandidates(IntPtr address, vector<IntPtr>& prefetch_list) = 0;
+
+private:
+   // Outstanding prefetches (value = a demand miss is waiting on it)
+   typedef std::tr1::unordered_map<IntPtr,bool> OutstandingPrefetchMap;
+   // Prefetched lines not yet used by a demand access (value = fill time)
+   typedef std::tr1::unordered_map<IntPtr,UInt64> PrefetchedLineMap;
+
+   OutstandingPrefetchMap _outstanding_prefetch_map;
+   PrefetchedLineMap _prefetched_line_map;
+
+   // Performance Counters
+   UInt64 _num_prefetches;
+   UInt64 _num_useful_prefetches;
+   UInt64 _num_late_prefetches;
+   UInt64 _num_useless_prefetches;
+   UInt64 _num_uncovered_misses;
+};
@@ -0,0 +1,23 @@
+#include "stream_prefetcher.h"
+
+StreamPrefetcher::StreamPrefetcher(UInt32 cache_line_size, UInt32 degree, const AddressHomeLookup* home_lookup)
+   : Prefetcher(cache_line_size, degree, home_lookup)
+{}
+
+StreamPrefetcher::~StreamPrefetcher()
+{}
+
+void
+StreamPrefetcher::computePrefetchCandidates(IntPtr address, vector<IntPtr>& prefetch_list)
+{
+   IntPtr page_num = getPageNum(address);
+   IntPtr line_num = getLineNum(address);
+
+   for (UInt32 i = 1; i <= _degree; i++)
+   {
+      IntPtr prefetch_address = (line_num + i) << _log_cache_line_size;
+      if (getPageNum(prefetch_address) != page_num)
+         break;
+      prefetch_list.push_back(prefetch_address);
+   }
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <vector>
+using std::vector;
+
+#include "prefetcher.h"
+
+// Next-N-line prefetcher: fetches the 'degree' lines following the access
+class StreamPrefetcher : public Prefetcher
+{
+public:
+   StreamPrefetcher(UInt32 cache_line_size, UInt32 degree, const AddressHomeLookup* home_lookup);
+   ~StreamPrefetcher();
+
+private:
+   void computePrefetchCandidates(IntPtr address, vector<IntPtr>& prefetch_list);
+};
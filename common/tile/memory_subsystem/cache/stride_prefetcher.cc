@@ -0,0 +1,80 @@
+#include "stride_prefetcher.h"
+#include "log.h"
+
+StridePrefetcher::StridePrefetcher(UInt32 cache_line_size, UInt32 degree, UInt32 table_size, const AddressHomeLookup* home_lookup)
+   : Prefetcher(cache_line_size, degree, home_lookup)
+   , _num_accesses(0)
+{
+   LOG_ASSERT_ERROR(table_size > 0, "Prefetcher table size must be > 0");
+   Entry entry = {INVALID_ADDRESS, 0, 0, 0, 0};
+   _table.resize(table_size, entry);
+}
+
+StridePrefetcher::~StridePrefetcher()
+{}
+
+StridePrefetcher::Entry&
+StridePrefetcher::getEntry(IntPtr page_num, bool& found)
+{
+   // The entry tracking the page, else the least recently used entry
+   UInt32 index = 0;
+   for (UInt32 i = 0; i < _table.size(); i++)
+   {
+      if (_table[i].page_num == page_num)
+      {
+         found = true;
+         return _table[i];
+      }
+      if (_table[i].last_access < _table[index].last_access)
+         index = i;
+   }
+   found = false;
+   return _table[index];
+}
+
+void
+StridePrefetcher::computePrefetchCandidates(IntPtr address, vector<IntPtr>& prefetch_list)
+{
+   IntPtr page_num = getPageNum(address);
+   IntPtr line_num = getLineNum(address);
+
+   bool found;
+   Entry& entry = getEntry(page_num, found);
+   entry.last_access = ++_num_accesses;
+
+   if (!found)
+   {
+      entry.page_num = page_num;
+      entry.last_line_num = line_num;
+      entry.stride = 0;
+      entry.confidence = 0;
+      return;
+   }
+
+   SInt64 stride = (SInt64) (line_num - entry.last_line_num);
+   if (stride == 0)
+      return;
+
+   if (stride == entry.stride)
+   {
+      if (entry.confidence < _max_confidence)
+         entry.confidence ++;
+   }
+   else
+   {
+      entry.stride = stride;
+      entry.confidence = 0;
+   }
+   entry.last_line_num = line_num;
+
+   if (entry.confidence < _confidence_threshold)
+      return;
+
+   for (UInt32 i = 1; i <= _degree; i++)
+   {
+      IntPtr prefetch_address = (line_num + i * entry.stride) << _log_cache_line_size;
+      if (getPageNum(prefetch_address) != page_num)
+         break;
+      prefetch_list.push_back(prefetch_address);
+   }
+}
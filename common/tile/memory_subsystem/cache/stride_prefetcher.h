@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+using std::vector;
+
+#include "prefetcher.h"
+
+// Detects constant strides between successive misses to the same page
+// (no PC is available at the L2, so the page plays the role of the stream id)
+class StridePrefetcher : public Prefetcher
+{
+public:
+   StridePrefetcher(UInt32 cache_line_size, UInt32 degree, UInt32 table_size, const AddressHomeLookup* home_lookup);
+   ~StridePrefetcher();
+
+private:
+   struct Entry
+   {
+      IntPtr page_num;
+      IntPtr last_line_num;
+      SInt64 stride;
+      UInt32 confidence;
+      UInt64 last_access;
+   };
+
+   // Confidence needed before prefetches are issued: the same stride has
+   // been seen twice in a row
+   static const UInt32 _confidence_threshold = 1;
+   static const UInt32 _max_confidence = 3;
+
+   vector<Entry> _table;
+   UInt64 _num_accesses;
+
+   void computePrefetchCandidates(IntPtr address, vector<IntPtr>& prefetch_list);
+   Entry& getEntry(IntPtr page_num, bool& found);
+};
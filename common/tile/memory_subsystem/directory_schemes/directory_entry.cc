@@ -90,6 +90,15 @@ DirectoryEntry::getSize(DirectoryType directory_type, SInt32 max_hw_sharers, SIn
    }
 }
 
+void
+DirectoryEntry::reset()
+{
+   _address = INVALID_ADDRESS;
+   _owner_id = INVALID_TILE_ID;
+   _directory_block_info->setDState(DirectoryState::UNCACHED);
+   _utilization_vec.clear();
+}
+
 DirectoryBlockInfo*
 DirectoryEntry::getDirectoryBlockInfo()
 {
@@ -21,6 +21,9 @@ public:
                                  SInt32 max_hw_sharers, SInt32 max_num_sharers);
    static UInt32 getSize(DirectoryType directory_type, SInt32 max_hw_sharers, SInt32 max_num_sharers);
 
+   // Return the entry to the state it had right after construction (used when recycling entries)
+   virtual void reset();
+
    DirectoryBlockInfo* getDirectoryBlockInfo();
 
    virtual bool hasSharer(tile_id_t sharer_id) = 0;
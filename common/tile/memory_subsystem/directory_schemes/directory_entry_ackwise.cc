@@ -10,6 +10,14 @@ DirectoryEntryAckwise::DirectoryEntryAckwise(SInt32 max_hw_sharers)
 DirectoryEntryAckwise::~DirectoryEntryAckwise()
 {}
 
+void
+DirectoryEntryAckwise::reset()
+{
+   DirectoryEntryLimited::reset();
+   _global_enabled = false;
+   _num_untracked_sharers = 0;
+}
+
 // Returns: Says whether the sharer was successfully added
 //              'True' if it was successfully added
 //              'False' if there will be an eviction before adding
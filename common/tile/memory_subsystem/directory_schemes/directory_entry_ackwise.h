@@ -7,6 +7,8 @@ class DirectoryEntryAckwise : public DirectoryEntryLimited
 public:
    DirectoryEntryAckwise(SInt32 max_hw_sharers);
    ~DirectoryEntryAckwise();
+
+   void reset();
   
    bool addSharer(tile_id_t sharer_id); 
    void removeSharer(tile_id_t sharer_id, bool reply_expected);
@@ -14,6 +14,13 @@ DirectoryEntryFullMap::~DirectoryEntryFullMap()
    delete _sharers;
 }
 
+void
+DirectoryEntryFullMap::reset()
+{
+   DirectoryEntry::reset();
+   _sharers->reset();
+}
+
 bool
 DirectoryEntryFullMap::hasSharer(tile_id_t sharer_id)
 {
@@ -48,17 +55,8 @@ bool
 DirectoryEntryFullMap::getSharersList(vector<tile_id_t>& sharers_list)
 {
    sharers_list.resize(_sharers->size());
-
-   _sharers->resetFind();
-
-   tile_id_t new_sharer = -1;
-   SInt32 i = 0;
-   while ((new_sharer = _sharers->find()) != -1)
-   {
-      sharers_list[i] = new_sharer;
-      i++;
-      assert (i <= (tile_id_t) _sharers->size());
-   }
+   if (!sharers_list.empty())
+      _sharers->getSetBits(&sharers_list[0]);
 
    return false;
 }
@@ -66,11 +64,8 @@ DirectoryEntryFullMap::getSharersList(vector<tile_id_t>& sharers_list)
 tile_id_t
 DirectoryEntryFullMap::getOneSharer()
 {
-   vector<tile_id_t> sharers_list;
-   getSharersList(sharers_list);
-
-   SInt32 index = _rand_num.next(sharers_list.size());
-   return sharers_list[index];
+   SInt32 index = _rand_num.next(_sharers->size());
+   return _sharers->findNth(index);
 }
 
 SInt32
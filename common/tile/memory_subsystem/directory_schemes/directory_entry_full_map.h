@@ -9,6 +9,8 @@ class DirectoryEntryFullMap : public DirectoryEntry
 public:
    DirectoryEntryFullMap(SInt32 max_hw_sharers);
    ~DirectoryEntryFullMap();
+
+   void reset();
    
    bool hasSharer(tile_id_t sharer_id);
    bool addSharer(tile_id_t sharer_id);
@@ -15,6 +15,15 @@ DirectoryEntryLimited::DirectoryEntryLimited(SInt32 max_hw_sharers)
 DirectoryEntryLimited::~DirectoryEntryLimited()
 {}
 
+void
+DirectoryEntryLimited::reset()
+{
+   DirectoryEntry::reset();
+   for (SInt32 i = 0; i < _max_hw_sharers; i++)
+      _sharers[i] = INVALID_SHARER;
+   _num_tracked_sharers = 0;
+}
+
 bool
 DirectoryEntryLimited::hasSharer(tile_id_t sharer_id)
 {
@@ -9,6 +9,8 @@ public:
    DirectoryEntryLimited(SInt32 max_hw_sharers);
    ~DirectoryEntryLimited();
 
+   void reset();
+
    bool hasSharer(tile_id_t sharer_id);
    bool addSharer(tile_id_t sharer_id);
    void removeSharer(tile_id_t sharer_id);
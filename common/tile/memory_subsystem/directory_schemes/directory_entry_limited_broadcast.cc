@@ -13,6 +13,14 @@ DirectoryEntryLimitedBroadcast::DirectoryEntryLimitedBroadcast(SInt32 max_hw_sha
 DirectoryEntryLimitedBroadcast::~DirectoryEntryLimitedBroadcast()
 {}
 
+void
+DirectoryEntryLimitedBroadcast::reset()
+{
+   DirectoryEntryLimited::reset();
+   _global_enabled = false;
+   _num_sharers = 0;
+}
+
 // Returns: Says whether the sharer was successfully added
 //              'True' if it was successfully added
 //              'False' if there will be an eviction before adding
@@ -7,6 +7,8 @@ class DirectoryEntryLimitedBroadcast : public DirectoryEntryLimited
 public:
    DirectoryEntryLimitedBroadcast(SInt32 max_hw_sharers);
    ~DirectoryEntryLimitedBroadcast();
+
+   void reset();
    
    bool addSharer(tile_id_t sharer_id);
    void removeSharer(tile_id_t sharer_id, bool reply_expected);
@@ -25,6 +25,16 @@ DirectoryEntryLimitless::~DirectoryEntryLimitless()
       delete _software_sharers;
 }
 
+void
+DirectoryEntryLimitless::reset()
+{
+   DirectoryEntryLimited::reset();
+   // Keep the software sharers bit vector around for when the entry is reused
+   if (_software_sharers)
+      _software_sharers->reset();
+   _software_trap_enabled = false;
+}
+
 bool
 DirectoryEntryLimitless::hasSharer(tile_id_t sharer_id)
 {
@@ -57,7 +67,8 @@ DirectoryEntryLimitless::addSharer(tile_id_t sharer_id)
       {
          // Migrate the sharers from hardware to software
          _software_trap_enabled = true;
-         _software_sharers = new BitVector(_max_num_sharers);
+         if (!_software_sharers)
+            _software_sharers = new BitVector(_max_num_sharers);
          for (SInt32 i = 0; i < _max_hw_sharers; i++)
          {
             if (_sharers[i] != INVALID_SHARER)
@@ -104,17 +115,8 @@ DirectoryEntryLimitless::getSharersList(vector<tile_id_t>& sharers_list)
    if (_software_trap_enabled) // Explicit software tracking of sharers
    {
       sharers_list.resize(_software_sharers->size());
-      
-      _software_sharers->resetFind();
-
-      tile_id_t new_sharer = -1;
-      SInt32 i = 0;
-      while ((new_sharer = _software_sharers->find()) != -1)
-      {
-         sharers_list[i] = new_sharer;
-         i++;
-         assert (i <= (tile_id_t) _software_sharers->size());
-      }
+      if (!sharers_list.empty())
+         _software_sharers->getSetBits(&sharers_list[0]);
    }
    else // (!_software_trap_enabled) - Explicit hardware tracking of sharers
    {
@@ -8,6 +8,8 @@ class DirectoryEntryLimitless : public DirectoryEntryLimited
 public:
    DirectoryEntryLimitless(SInt32 max_hw_sharers, SInt32 max_num_sharers);
    ~DirectoryEntryLimitless();
+
+   void reset();
    
    bool hasSharer(tile_id_t sharer_id);
    bool addSharer(tile_id_t sharer_id);
@@ -0,0 +1,88 @@
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cstring>
+#include <cassert>
+#include <vector>
+using std::vector;
+
+#include "dram_backing_store.h"
+#include "log.h"
+
+DramBackingStore::DramBackingStore(UInt32 cache_line_size)
+   : _last_region_num(INVALID_ADDRESS)
+   , _last_region(NULL)
+   , _cache_line_size(cache_line_size)
+{
+   LOG_ASSERT_ERROR(REGION_SIZE % _cache_line_size == 0,
+                    "Cache Line Size(%u) must divide the region size(%llu)", _cache_line_size, REGION_SIZE);
+}
+
+DramBackingStore::~DramBackingStore()
+{
+   for (RegionMap::iterator it = _region_map.begin(); it != _region_map.end(); it++)
+      munmap((void*) it->second, REGION_SIZE);
+}
+
+void
+DramBackingStore::readLine(IntPtr address, Byte* data_buf)
+{
+   memcpy((void*) data_buf, (void*) getLine(address), _cache_line_size);
+}
+
+void
+DramBackingStore::writeLine(IntPtr address, const Byte* data_buf)
+{
+   memcpy((void*) getLine(address), (const void*) data_buf, _cache_line_size);
+}
+
+Byte*
+DramBackingStore::getLine(IntPtr address)
+{
+   assert((address % _cache_line_size) == 0);
+
+   IntPtr region_num = address >> LOG_REGION_SIZE;
+   if (region_num != _last_region_num)
+   {
+      // A single lookup; the region is created (untouched) if it is not there yet
+      Byte*& region = _region_map[region_num];
+      if (region == NULL)
+         region = allocateRegion();
+      _last_region_num = region_num;
+      _last_region = region;
+   }
+   return _last_region + (address & (REGION_SIZE-1));
+}
+
+Byte*
+DramBackingStore::allocateRegion()
+{
+   // Anonymous mappings are zero-filled by the OS on first touch
+   void* region = mmap(NULL, REGION_SIZE, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+   LOG_ASSERT_ERROR(region != MAP_FAILED, "Could not mmap DRAM backing store region");
+   return (Byte*) region;
+}
+
+UInt64
+DramBackingStore::getMappedBytes() const
+{
+   return _region_map.size() * REGION_SIZE;
+}
+
+UInt64
+DramBackingStore::getResidentBytes() const
+{
+   UInt64 page_size = sysconf(_SC_PAGESIZE);
+   UInt64 num_pages_per_region = REGION_SIZE / page_size;
+   vector<unsigned char> page_residency(num_pages_per_region);
+
+   UInt64 num_resident_pages = 0;
+   for (RegionMap::const_iterator it = _region_map.begin(); it != _region_map.end(); it++)
+   {
+      if (mincore((void*) it->second, REGION_SIZE, &page_residency[0]) != 0)
+         continue;
+      for (UInt64 i = 0; i < num_pages_per_region; i++)
+         num_resident_pages += (page_residency[i] & 0x1);
+   }
+   return num_resident_pages * page_size;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <tr1/unordered_map>
+
+#include "fixed_types.h"
+
+// Simulated memory contents of a DRAM controller
+// Memory is kept in large anonymous mmap'ed regions (indexed by a hash table)
+// that the OS zero-fills lazily one page at a time, so that a line
+// read/write is a single lookup plus a memcpy
+class DramBackingStore
+{
+public:
+   DramBackingStore(UInt32 cache_line_size);
+   ~DramBackingStore();
+
+   void readLine(IntPtr address, Byte* data_buf);
+   void writeLine(IntPtr address, const Byte* data_buf);
+
+   // Bytes of simulated memory that have been reserved / actually touched
+   UInt64 getMappedBytes() const;
+   UInt64 getResidentBytes() const;
+
+private:
+   // 1 MB regions, each backed lazily by 4 KB host pages
+   static const UInt32 LOG_REGION_SIZE = 20;
+   static const UInt64 REGION_SIZE = 1ULL << LOG_REGION_SIZE;
+
+   typedef std::tr1::unordered_map<IntPtr,Byte*> RegionMap;
+   RegionMap _region_map;
+
+   // Most recently accessed region
+   IntPtr _last_region_num;
+   Byte* _last_region;
+
+   UInt32 _cache_line_size;
+
+   Byte* getLine(IntPtr address);
+   Byte* allocateRegion();
+};
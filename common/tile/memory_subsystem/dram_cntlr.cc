@@ -1,66 +1,101 @@
+#include <sstream>
+using std::ostringstream;
+
 #include "dram_cntlr.h"
 #include "tile.h"
 #include "memory_manager.h"
 #include "clock_converter.h"
+#include "simulator.h"
+#include "config.h"
 #include "log.h"
 
 DramCntlr::DramCntlr(Tile* tile,
+      AddressHomeLookup* dram_home_lookup,
       float dram_access_cost,
       float dram_bandwidth,
       bool dram_queue_model_enabled,
       string dram_queue_model_type,
       UInt32 cache_line_size)
    : _tile(tile)
+   , _dram_home_lookup(dram_home_lookup)
+   , _backing_store(cache_line_size)
+   , _hot_line_profiler(NULL)
    , _cache_line_size(cache_line_size)
 {
-   _dram_perf_model = new DramPerfModel(dram_access_cost, 
-                                        dram_bandwidth,
-                                        dram_queue_model_enabled,
-                                        dram_queue_model_type,
-                                        cache_line_size);
+   string dram_perf_model_type = Sim()->getCfg()->getString("dram/perf_model_type", "simple");
+   _dram_perf_model = DramPerfModel::create(dram_perf_model_type,
+                                            dram_access_cost,
+                                            dram_bandwidth,
+                                            dram_queue_model_enabled,
+                                            dram_queue_model_type,
+                                            cache_line_size);
 
-   _dram_access_count = new AccessCountMap[NUM_ACCESS_TYPES];
+   createHotLineProfiler();
 }
 
 DramCntlr::~DramCntlr()
 {
-   printDramAccessCount();
-   delete [] _dram_access_count;
+   if (_hot_line_profiler)
+   {
+      _hot_line_profiler->output(_hot_line_profile_filename);
+      delete _hot_line_profiler;
+   }
 
    delete _dram_perf_model;
 }
 
 void
-DramCntlr::getDataFromDram(IntPtr address, Byte* data_buf, bool modeled)
+DramCntlr::createHotLineProfiler()
 {
-   if (_data_map[address] == NULL)
+   bool enabled = false;
+   UInt32 num_tracked_lines = 0;
+   UInt32 sampling_interval = 0;
+   try
    {
-      _data_map[address] = new Byte[_cache_line_size];
-      memset((void*) _data_map[address], 0x00, _cache_line_size);
+      enabled = Sim()->getCfg()->getBool("dram/hot_line_profiler/enabled", false);
+      if (!enabled)
+         return;
+      num_tracked_lines = Sim()->getCfg()->getInt("dram/hot_line_profiler/num_tracked_lines");
+      sampling_interval = Sim()->getCfg()->getInt("dram/hot_line_profiler/sampling_interval");
    }
-   memcpy((void*) data_buf, (void*) _data_map[address], _cache_line_size);
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read [dram/hot_line_profiler] parameters from the cfg file");
+   }
+
+   _hot_line_profiler = new DramHotLineProfiler(_tile->getId(), num_tracked_lines, sampling_interval);
+
+   ostringstream filename;
+   filename << "dram_hot_lines_" << _tile->getId() << ".dat";
+   _hot_line_profile_filename = Sim()->getConfig()->formatOutputFileName(filename.str());
+}
 
-   UInt64 dram_access_latency = modeled ? runDramPerfModel() : 0;
+void
+DramCntlr::getDataFromDram(IntPtr address, Byte* data_buf, bool modeled)
+{
+   _backing_store.readLine(_dram_home_lookup->getLocalAddress(address), data_buf);
+
+   UInt64 dram_access_latency = modeled ? runDramPerfModel(address) : 0;
    LOG_PRINT("Dram Access Latency(%llu)", dram_access_latency);
    getShmemPerfModel()->incrCycleCount(dram_access_latency);
 
-   addToDramAccessCount(address, READ);
+   if (_hot_line_profiler)
+      _hot_line_profiler->record(address, false);
 }
 
 void
 DramCntlr::putDataToDram(IntPtr address, Byte* data_buf, bool modeled)
 {
-   LOG_ASSERT_ERROR(_data_map[address] != NULL, "Data Buffer does not exist");
-   
-   memcpy((void*) _data_map[address], (void*) data_buf, _cache_line_size);
+   _backing_store.writeLine(_dram_home_lookup->getLocalAddress(address), data_buf);
 
-   __attribute(__unused__) UInt64 dram_access_latency = modeled ? runDramPerfModel() : 0;
-   
-   addToDramAccessCount(address, WRITE);
+   __attribute(__unused__) UInt64 dram_access_latency = modeled ? runDramPerfModel(address) : 0;
+
+   if (_hot_line_profiler)
+      _hot_line_profiler->record(address, true);
 }
 
 UInt64
-DramCntlr::runDramPerfModel()
+DramCntlr::runDramPerfModel(IntPtr address)
 {
    UInt64 pkt_cycle_count = getShmemPerfModel()->getCycleCount();
    UInt64 pkt_size = (UInt64) _cache_line_size;
@@ -68,32 +103,25 @@ DramCntlr::runDramPerfModel()
    float tile_frequency = _tile->getCore()->getPerformanceModel()->getFrequency();
    UInt64 pkt_time = convertCycleCount(pkt_cycle_count, tile_frequency, 1.0);
 
-   UInt64 dram_access_latency = _dram_perf_model->getAccessLatency(pkt_time, pkt_size);
+   UInt64 dram_access_latency = _dram_perf_model->getAccessLatency(pkt_time, pkt_size, _dram_home_lookup->getLocalAddress(address));
    
    return convertCycleCount(dram_access_latency, 1.0, tile_frequency);
 }
 
 void
-DramCntlr::addToDramAccessCount(IntPtr address, AccessType access_type)
+DramCntlr::outputSummary(ostream& out)
 {
-   _dram_access_count[access_type][address] = _dram_access_count[access_type][address] + 1;
+   _dram_perf_model->outputSummary(out);
+   out << "    Backing Store Mapped (in KB): " << _backing_store.getMappedBytes() / 1024 << endl;
+   out << "    Backing Store Resident (in KB): " << _backing_store.getResidentBytes() / 1024 << endl;
 }
 
 void
-DramCntlr::printDramAccessCount()
+DramCntlr::dummyOutputSummary(ostream& out)
 {
-   for (UInt32 k = 0; k < NUM_ACCESS_TYPES; k++)
-   {
-      for (AccessCountMap::iterator i = _dram_access_count[k].begin(); i != _dram_access_count[k].end(); i++)
-      {
-         if ((*i).second > 100)
-         {
-            LOG_PRINT("Dram Cntlr(%i), Address(0x%x), Access Count(%llu), Access Type(%s)", 
-                  _tile->getId(), (*i).first, (*i).second,
-                  (k == READ)? "READ" : "WRITE");
-         }
-      }
-   }
+   DramPerfModel::dummyOutputSummary(out);
+   out << "    Backing Store Mapped (in KB): " << endl;
+   out << "    Backing Store Resident (in KB): " << endl;
 }
 
 ShmemPerfModel*
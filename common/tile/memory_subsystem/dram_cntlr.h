@@ -1,9 +1,9 @@
 #pragma once
 
-#include <map>
-using std::map;
-
 #include "tile.h"
+#include "address_home_lookup.h"
+#include "dram_backing_store.h"
+#include "dram_hot_line_profiler.h"
 #include "dram_perf_model.h"
 #include "shmem_perf_model.h"
 #include "fixed_types.h"
@@ -19,6 +19,7 @@ public:
    };
 
    DramCntlr(Tile* tile,
+             AddressHomeLookup* dram_home_lookup,
              volatile float dram_access_cost,
              volatile float dram_bandwidth,
              bool dram_queue_model_enabled,
@@ -30,20 +31,26 @@ public:
 
    void getDataFromDram(IntPtr address, Byte* data_buf, bool modeled);
    void putDataToDram(IntPtr address, Byte* data_buf, bool modeled);
+
+   void outputSummary(ostream& out);
+   static void dummyOutputSummary(ostream& out);
    
 private:
    Tile* _tile;
-   map<IntPtr, Byte*> _data_map;
+   AddressHomeLookup* _dram_home_lookup;
+   // Indexed by the addresses local to this controller, so that the lines it
+   // homes fill its regions densely whatever the interleaving
+   DramBackingStore _backing_store;
    DramPerfModel* _dram_perf_model;
 
-   typedef std::map<IntPtr,UInt64> AccessCountMap;
-   AccessCountMap* _dram_access_count;
+   // Opt-in profile of the most accessed lines ([dram/hot_line_profiler])
+   DramHotLineProfiler* _hot_line_profiler;
+   string _hot_line_profile_filename;
 
    ShmemPerfModel* getShmemPerfModel();
-   UInt64 runDramPerfModel();
+   UInt64 runDramPerfModel(IntPtr address);
 
-   void addToDramAccessCount(IntPtr address, AccessType access_type);
-   void printDramAccessCount();
+   void createHotLineProfiler();
 
 protected:
    UInt32 _cache_line_size;
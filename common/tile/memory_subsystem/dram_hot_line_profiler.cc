@@ -0,0 +1,150 @@
+#include <fstream>
+#include <algorithm>
+using std::ofstream;
+using std::endl;
+
+#include "dram_hot_line_profiler.h"
+#include "log.h"
+
+DramHotLineProfiler::DramHotLineProfiler(tile_id_t tile_id, UInt32 num_tracked_lines, UInt32 sampling_interval)
+   : _tile_id(tile_id)
+   , _num_tracked_lines(num_tracked_lines)
+   , _sampling_interval(sampling_interval)
+   , _accesses_until_sample(sampling_interval)
+   , _total_sampled_accesses(0)
+{
+   LOG_ASSERT_ERROR(_num_tracked_lines > 0, "Number of tracked lines must be > 0");
+   LOG_ASSERT_ERROR(_sampling_interval > 0, "Sampling interval must be > 0");
+
+   _entries.reserve(_num_tracked_lines);
+   _heap.reserve(_num_tracked_lines);
+   _heap_position.reserve(_num_tracked_lines);
+   _entry_index_map.rehash(2 * _num_tracked_lines);
+}
+
+DramHotLineProfiler::~DramHotLineProfiler()
+{}
+
+void
+DramHotLineProfiler::recordSample(IntPtr address, bool is_write)
+{
+   _total_sampled_accesses ++;
+
+   UInt32 index;
+   EntryIndexMap::iterator it = _entry_index_map.find(address);
+   if (it != _entry_index_map.end())
+   {
+      index = it->second;
+   }
+   else if (_entries.size() < _num_tracked_lines)
+   {
+      index = _entries.size();
+      Entry entry = {address, 0, 0, 0, 0};
+      _entries.push_back(entry);
+      _heap.push_back(index);
+      _heap_position.push_back(_heap.size() - 1);
+      siftUp(_heap.size() - 1);
+      _entry_index_map.insert(std::make_pair(address, index));
+   }
+   else
+   {
+      // Evict the entry with the minimum count; the newcomer inherits
+      // that count as its error bound
+      index = _heap[0];
+      Entry& entry = _entries[index];
+      _entry_index_map.erase(entry.address);
+      entry.address = address;
+      entry.error = entry.count;
+      entry.reads = 0;
+      entry.writes = 0;
+      _entry_index_map.insert(std::make_pair(address, index));
+   }
+
+   Entry& entry = _entries[index];
+   entry.count += _sampling_interval;
+   if (is_write)
+      entry.writes += _sampling_interval;
+   else
+      entry.reads += _sampling_interval;
+
+   siftDown(_heap_position[index]);
+}
+
+void
+DramHotLineProfiler::siftUp(UInt32 position)
+{
+   while (position > 0)
+   {
+      UInt32 parent = (position - 1) / 2;
+      if (_entries[_heap[parent]].count <= _entries[_heap[position]].count)
+         return;
+      swapHeapSlots(position, parent);
+      position = parent;
+   }
+}
+
+void
+DramHotLineProfiler::siftDown(UInt32 position)
+{
+   UInt32 heap_size = _heap.size();
+   while (true)
+   {
+      UInt32 smallest = position;
+      UInt32 left = 2 * position + 1;
+      UInt32 right = left + 1;
+      if ( (left < heap_size) && (_entries[_heap[left]].count < _entries[_heap[smallest]].count) )
+         smallest = left;
+      if ( (right < heap_size) && (_entries[_heap[right]].count < _entries[_heap[smallest]].count) )
+         smallest = right;
+      if (smallest == position)
+         return;
+      swapHeapSlots(position, smallest);
+      position = smallest;
+   }
+}
+
+void
+DramHotLineProfiler::swapHeapSlots(UInt32 position_1, UInt32 position_2)
+{
+   std::swap(_heap[position_1], _heap[position_2]);
+   _heap_position[_heap[position_1]] = position_1;
+   _heap_position[_heap[position_2]] = position_2;
+}
+
+static bool
+hasHigherCount(const std::pair<UInt64,UInt32>& a, const std::pair<UInt64,UInt32>& b)
+{
+   return (a.first > b.first);
+}
+
+void
+DramHotLineProfiler::output(const string& filename)
+{
+   ofstream out(filename.c_str());
+   if (!out)
+   {
+      LOG_PRINT_WARNING("Could not open DRAM hot line profile file(%s)", filename.c_str());
+      return;
+   }
+
+   vector<std::pair<UInt64,UInt32> > order;
+   order.reserve(_entries.size());
+   for (UInt32 i = 0; i < _entries.size(); i++)
+      order.push_back(std::make_pair(_entries[i].count, i));
+   std::stable_sort(order.begin(), order.end(), hasHigherCount);
+
+   out << "# Dram Cntlr: " << _tile_id << endl;
+   out << "# Sampling Interval: " << _sampling_interval << endl;
+   out << "# Sampled Accesses: " << _total_sampled_accesses << endl;
+   out << "# Counts are scaled by the sampling interval and over-estimate the sampled count by at most Error" << endl;
+   out << "# Address, Count, Error, Reads, Writes" << endl;
+   for (UInt32 i = 0; i < order.size(); i++)
+   {
+      const Entry& entry = _entries[order[i].second];
+      out << "0x" << std::hex << entry.address << std::dec << ", "
+          << entry.count << ", "
+          << entry.error << ", "
+          << entry.reads << ", "
+          << entry.writes << endl;
+   }
+}
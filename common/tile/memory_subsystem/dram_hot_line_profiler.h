@@ -0,0 +1,62 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <tr1/unordered_map>
+using std::string;
+using std::vector;
+
+#include "fixed_types.h"
+
+// Tracks the most frequently accessed lines of a DRAM controller
+// Uses the Space-Saving top-K sketch (Metwally et al.) over a sampled
+// access stream, so memory is bounded by the number of tracked lines and
+// each sampled access costs one hash lookup plus a heap sift
+class DramHotLineProfiler
+{
+public:
+   DramHotLineProfiler(tile_id_t tile_id, UInt32 num_tracked_lines, UInt32 sampling_interval);
+   ~DramHotLineProfiler();
+
+   void record(IntPtr address, bool is_write)
+   {
+      if (--_accesses_until_sample == 0)
+      {
+         _accesses_until_sample = _sampling_interval;
+         recordSample(address, is_write);
+      }
+   }
+
+   // Writes the tracked lines (hottest first) to the given file
+   void output(const string& filename);
+
+private:
+   struct Entry
+   {
+      IntPtr address;
+      // Estimated access count and the maximum over-estimation in it
+      UInt64 count;
+      UInt64 error;
+      UInt64 reads;
+      UInt64 writes;
+   };
+
+   typedef std::tr1::unordered_map<IntPtr,UInt32> EntryIndexMap;
+
+   tile_id_t _tile_id;
+   UInt32 _num_tracked_lines;
+   UInt32 _sampling_interval;
+   UInt32 _accesses_until_sample;
+   UInt64 _total_sampled_accesses;
+
+   vector<Entry> _entries;
+   EntryIndexMap _entry_index_map;
+   // Min-heap of entry indices ordered by count
+   vector<UInt32> _heap;
+   vector<UInt32> _heap_position;
+
+   void recordSample(IntPtr address, bool is_write);
+   void siftUp(UInt32 position);
+   void siftDown(UInt32 position);
+   void swapHeapSlots(UInt32 position_1, UInt32 position_2);
+};
@@ -5,6 +5,7 @@ using namespace std;
 #include "memory_manager.h"
 #include "pr_l1_pr_l2_dram_directory_msi/memory_manager.h"
 #include "pr_l1_pr_l2_dram_directory_mosi/memory_manager.h"
+#include "pr_l1_pr_l2_dram_directory_mesi/memory_manager.h"
 #include "pr_l1_sh_l2_msi/memory_manager.h"
 #include "network_model.h"
 #include "log.h"
@@ -35,6 +36,9 @@ MemoryManager::createMMU(std::string protocol_type,
    case PR_L1_PR_L2_DRAM_DIRECTORY_MOSI:
       return new PrL1PrL2DramDirectoryMOSI::MemoryManager(tile, network, shmem_perf_model);
 
+   case PR_L1_PR_L2_DRAM_DIRECTORY_MESI:
+      return new PrL1PrL2DramDirectoryMESI::MemoryManager(tile, network, shmem_perf_model);
+
    case PR_L1_SH_L2_MSI:
       return new PrL1ShL2MSI::MemoryManager(tile, network, shmem_perf_model);
 
@@ -51,6 +55,8 @@ MemoryManager::parseProtocolType(std::string& protocol_type)
       return PR_L1_PR_L2_DRAM_DIRECTORY_MSI;
    else if (protocol_type == "pr_l1_pr_l2_dram_directory_mosi")
       return PR_L1_PR_L2_DRAM_DIRECTORY_MOSI;
+   else if (protocol_type == "pr_l1_pr_l2_dram_directory_mesi")
+      return PR_L1_PR_L2_DRAM_DIRECTORY_MESI;
    else if (protocol_type == "pr_l1_sh_l2_msi")
       return PR_L1_SH_L2_MSI;
    else
@@ -88,6 +94,10 @@ MemoryManager::openCacheLineReplicationTraceFiles()
       PrL1PrL2DramDirectoryMOSI::MemoryManager::openCacheLineReplicationTraceFiles();
       break;
 
+   case PR_L1_PR_L2_DRAM_DIRECTORY_MESI:
+      PrL1PrL2DramDirectoryMESI::MemoryManager::openCacheLineReplicationTraceFiles();
+      break;
+
    case PR_L1_SH_L2_MSI:
    default:
       LOG_PRINT_ERROR("Caching Protocol (%u) does not support this feature", _caching_protocol_type);
@@ -108,6 +118,10 @@ MemoryManager::closeCacheLineReplicationTraceFiles()
       PrL1PrL2DramDirectoryMOSI::MemoryManager::closeCacheLineReplicationTraceFiles();
       break;
 
+   case PR_L1_PR_L2_DRAM_DIRECTORY_MESI:
+      PrL1PrL2DramDirectoryMESI::MemoryManager::closeCacheLineReplicationTraceFiles();
+      break;
+
    case PR_L1_SH_L2_MSI:
    default:
       LOG_PRINT_ERROR("Caching Protocol (%u) does not support this feature", _caching_protocol_type);
@@ -128,6 +142,10 @@ MemoryManager::outputCacheLineReplicationSummary()
       PrL1PrL2DramDirectoryMOSI::MemoryManager::outputCacheLineReplicationSummary();
       break;
 
+   case PR_L1_PR_L2_DRAM_DIRECTORY_MESI:
+      PrL1PrL2DramDirectoryMESI::MemoryManager::outputCacheLineReplicationSummary();
+      break;
+
    case PR_L1_SH_L2_MSI:
    default:
       LOG_PRINT_ERROR("Caching Protocol (%u) does not support this feature", _caching_protocol_type);
@@ -29,6 +29,9 @@ public:
 
    Tile* getTile()   { return _tile; }
    virtual UInt32 getCacheLineSize() = 0;
+   // Used by the instruction fetch fast path of the core
+   virtual Cache* getL1ICache() = 0;
+   virtual UInt64 getL1ICacheHitLatency() = 0;
    ShmemPerfModel* getShmemPerfModel() { return _shmem_perf_model; }
 
    virtual tile_id_t getShmemRequester(const void* pkt_data) = 0;
@@ -0,0 +1,79 @@
+#include "mshr.h"
+#include "log.h"
+
+using std::endl;
+
+MSHR::MSHR(UInt32 num_entries)
+   : _num_misses(0)
+   , _num_merged_accesses(0)
+   , _num_full_stalls(0)
+   , _total_full_stall_cycles(0)
+{
+   LOG_ASSERT_ERROR(num_entries > 0, "Number of MSHRs must be > 0");
+   Entry entry = {INVALID_ADDRESS, 0};
+   _entries.resize(num_entries, entry);
+}
+
+MSHR::~MSHR()
+{}
+
+UInt32
+MSHR::getEntryIndex(UInt64 time)
+{
+   // A free entry, else the entry that frees up first
+   UInt32 index = 0;
+   for (UInt32 i = 0; i < _entries.size(); i++)
+   {
+      if (_entries[i].completion_time <= time)
+         return i;
+      if (_entries[i].completion_time < _entries[index].completion_time)
+         index = i;
+   }
+   return index;
+}
+
+UInt64
+MSHR::getIssueTime(UInt64 time)
+{
+   UInt64 free_time = _entries[getEntryIndex(time)].completion_time;
+   if (free_time <= time)
+      return time;
+
+   _num_full_stalls ++;
+   _total_full_stall_cycles += (free_time - time);
+   return free_time;
+}
+
+void
+MSHR::insert(IntPtr address, UInt64 issue_time, UInt64 completion_time)
+{
+   Entry& entry = _entries[getEntryIndex(issue_time)];
+   entry.address = address;
+   entry.completion_time = completion_time;
+   _num_misses ++;
+}
+
+UInt64
+MSHR::getFillTime(IntPtr address, UInt64 time)
+{
+   for (UInt32 i = 0; i < _entries.size(); i++)
+   {
+      if ( (_entries[i].address == address) && (_entries[i].completion_time > time) )
+      {
+         _num_merged_accesses ++;
+         return _entries[i].completion_time;
+      }
+   }
+   return time;
+}
+
+void
+MSHR::outputSummary(ostream& out)
+{
+   out << "    MSHR:" << endl;
+   out << "      Misses: " << _num_misses << endl;
+   out << "      Accesses Merged With Outstanding Misses: " << _num_merged_accesses << endl;
+   out << "      Full Stalls: " << _num_full_stalls << endl;
+   out << "      Average Full Stall (in clock cycles): "
+       << ((_num_full_stalls > 0) ? ((float) _total_full_stall_cycles / _num_full_stalls) : 0) << endl;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+using std::ostream;
+using std::vector;
+
+#include "fixed_types.h"
+
+// Miss Status Holding Registers of an L1 cache
+// Misses are functionally serviced one at a time by the app thread, so
+// the MSHRs only track, in simulated time, the interval during which each
+// miss is outstanding. This bounds the number of overlapping misses and lets
+// accesses to a line that is still being filled wait for the fill instead
+// of seeing an immediate hit
+class MSHR
+{
+public:
+   MSHR(UInt32 num_entries);
+   ~MSHR();
+
+   // Returns the time (>= time) at which a miss can get an MSHR
+   UInt64 getIssueTime(UInt64 time);
+   // Records a miss to 'address' that got its MSHR at issue_time
+   void insert(IntPtr address, UInt64 issue_time, UInt64 completion_time);
+   // Returns the time (>= time) at which an outstanding fill of 'address' completes
+   UInt64 getFillTime(IntPtr address, UInt64 time);
+
+   void outputSummary(ostream& out);
+
+private:
+   struct Entry
+   {
+      IntPtr address;
+      UInt64 completion_time;
+   };
+
+   vector<Entry> _entries;
+
+   // Performance Counters
+   UInt64 _num_misses;
+   UInt64 _num_merged_accesses;
+   UInt64 _num_full_stalls;
+   UInt64 _total_full_stall_cycles;
+
+   UInt32 getEntryIndex(UInt64 time);
+};
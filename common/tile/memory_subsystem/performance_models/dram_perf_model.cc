@@ -4,62 +4,52 @@ using namespace std;
 #include "simulator.h"
 #include "config.h"
 #include "dram_perf_model.h"
-#include "queue_model_history_list.h"
-#include "queue_model_history_tree.h"
+#include "dram_perf_model_simple.h"
+#include "dram_perf_model_banked.h"
+#include "log.h"
 
-// Note: Each Dram Controller owns a single DramModel object
-// Hence, m_dram_bandwidth is the bandwidth for a single DRAM controller
-// Total Bandwidth = m_dram_bandwidth * Number of DRAM controllers
-// Number of DRAM controllers presently = Number of Cores
-// m_dram_bandwidth is expressed in GB/s
-// Assuming the frequency of a core is 1GHz, 
-// m_dram_bandwidth is also expressed in 'Bytes per clock cycle'
-// This DRAM model is not entirely correct.
-// It sort of increases the queueing delay to a huge value if
-// the arrival times of adjacent packets are spread over a large
-// simulated time period
-DramPerfModel::DramPerfModel(float dram_access_cost, 
-      float dram_bandwidth,
-      bool queue_model_enabled,
-      std::string queue_model_type, 
-      UInt32 cache_block_size):
-   m_dram_access_cost(UInt64(dram_access_cost)),
-   m_dram_bandwidth(dram_bandwidth),
-   m_cache_block_size(cache_block_size),
-   m_queue_model_type(queue_model_type),
-   m_queue_model_enabled(queue_model_enabled),
+DramPerfModel::DramPerfModel():
    m_enabled(false)
 {
    initializePerformanceCounters();
-   createQueueModels();
 }
 
 DramPerfModel::~DramPerfModel()
-{
-   destroyQueueModels();
-}
+{}
 
-void
-DramPerfModel::createQueueModels()
+DramPerfModel*
+DramPerfModel::create(std::string model_type,
+      float dram_access_cost,
+      float dram_bandwidth,
+      bool queue_model_enabled,
+      std::string queue_model_type,
+      UInt32 cache_block_size)
 {
-   if (m_queue_model_enabled)
+   switch (parseModelType(model_type))
    {
-      UInt64 min_processing_time = (UInt64) ((float) m_cache_block_size / m_dram_bandwidth) + 1;
-      m_queue_model = QueueModel::create(m_queue_model_type, min_processing_time);
-   }
-   else
-   {
-      m_queue_model = NULL;
+   case SIMPLE:
+      return new DramPerfModelSimple(dram_access_cost, dram_bandwidth,
+                                     queue_model_enabled, queue_model_type, cache_block_size);
+
+   case BANKED:
+      return new DramPerfModelBanked(dram_bandwidth, queue_model_enabled, queue_model_type, cache_block_size);
+
+   default:
+      LOG_PRINT_ERROR("Unsupported DramPerfModel type: %s", model_type.c_str());
+      return NULL;
    }
 }
 
-void
-DramPerfModel::destroyQueueModels()
+DramPerfModel::Type
+DramPerfModel::parseModelType(std::string model_type)
 {
-   if (m_queue_model_enabled)
-   {
-      delete m_queue_model;
-   }
+   if (model_type == "simple")
+      return SIMPLE;
+   else if (model_type == "banked")
+      return BANKED;
+   else
+      LOG_PRINT_ERROR("Unrecognized DramPerfModel type(%s): must be 'simple' or 'banked'", model_type.c_str());
+   return NUM_DRAM_PERF_MODEL_TYPES;
 }
 
 void
@@ -70,53 +60,12 @@ DramPerfModel::initializePerformanceCounters()
    m_total_queueing_delay = 0;
 }
 
-UInt64 
-DramPerfModel::getAccessLatency(UInt64 pkt_time, UInt64 pkt_size)
+void
+DramPerfModel::updateAccessCounters(UInt64 access_latency, UInt64 queue_delay)
 {
-   // pkt_size is in 'Bytes'
-   // m_dram_bandwidth is in 'Bytes per clock cycle'
-   if (!m_enabled) 
-   {
-      LOG_PRINT("Not enabled. Return 0");
-      return 0;
-   }
-
-   UInt64 processing_time = (UInt64) ((float) pkt_size/m_dram_bandwidth) + 1;
-   LOG_PRINT("Processing Time(%llu)", processing_time);
-
-   // Compute Queue Delay
-   UInt64 queue_delay;
-   if (m_queue_model)
-   {
-      queue_delay = m_queue_model->computeQueueDelay(pkt_time, processing_time);
-   }
-   else
-   {
-      queue_delay = 0;
-   }
-   LOG_PRINT("Queue Delay(%llu)", queue_delay);
-   UInt64 access_latency = queue_delay + processing_time + m_dram_access_cost;
-   LOG_PRINT("Access Latency(%llu)", access_latency);
-
-
-   // Update Memory Counters
    m_num_accesses ++;
    m_total_access_latency += (double) access_latency;
    m_total_queueing_delay += (double) queue_delay;
-
-   return access_latency;
-}
-
-void
-DramPerfModel::enable()
-{
-   m_enabled = true;
-}
-
-void
-DramPerfModel::disable()
-{
-   m_enabled = false;
 }
 
 void
@@ -128,32 +77,6 @@ DramPerfModel::outputSummary(ostream& out)
       (float) (m_total_access_latency / m_num_accesses) << endl;
    out << "    Average Dram Contention Delay (in ns): " << 
       (float) (m_total_queueing_delay / m_num_accesses) << endl;
-
-
-   std::string queue_model_type = Sim()->getCfg()->getString("dram/queue_model/type");
-   if (m_queue_model && ((queue_model_type == "history_list") || (queue_model_type == "history_tree")))
-   {
-      out << "    Queue Model:" << endl;
-       
-      if (queue_model_type == "history_list")
-      {  
-         float queue_utilization = ((QueueModelHistoryList*) m_queue_model)->getQueueUtilization();
-         float frac_requests_using_analytical_model = \
-            ((float) ((QueueModelHistoryList*) m_queue_model)->getTotalRequestsUsingAnalyticalModel()) / \
-            ((QueueModelHistoryList*) m_queue_model)->getTotalRequests();
-         out << "      Queue Utilization(\%): " << queue_utilization * 100 << endl;
-         out << "      Analytical Model Used(\%): " << frac_requests_using_analytical_model * 100 << endl;
-      }
-      else // (queue_model_type == "history_tree")
-      {
-         float queue_utilization = ((QueueModelHistoryTree*) m_queue_model)->getQueueUtilization();
-         float frac_requests_using_analytical_model = \
-            ((float) ((QueueModelHistoryTree*) m_queue_model)->getTotalRequestsUsingAnalyticalModel()) / \
-            ((QueueModelHistoryTree*) m_queue_model)->getTotalRequests();
-         out << "      Queue Utilization(\%): " << queue_utilization * 100 << endl;
-         out << "      Analytical Model Used(\%): " << frac_requests_using_analytical_model * 100 << endl;
-      }
-   }
 }
 
 void
@@ -163,13 +86,19 @@ DramPerfModel::dummyOutputSummary(ostream& out)
    out << "    Total Dram Accesses: " << endl;
    out << "    Average Dram Access Latency (in ns): " << endl;
    out << "    Average Dram Contention Delay (in ns): " << endl;
-   
-   bool queue_model_enabled = Sim()->getCfg()->getBool("dram/queue_model/enabled");
-   std::string queue_model_type = Sim()->getCfg()->getString("dram/queue_model/type");
-   if (queue_model_enabled && ((queue_model_type == "history_list") || (queue_model_type == "history_tree")))
+
+   std::string model_type = Sim()->getCfg()->getString("dram/perf_model_type", "simple");
+   switch (parseModelType(model_type))
    {
-      out << "    Queue Model:" << endl;
-      out << "      Queue Utilization(\%): " << endl;
-      out << "      Analytical Model Used(\%): " << endl;
+   case SIMPLE:
+      DramPerfModelSimple::dummyOutputSummary(out);
+      break;
+
+   case BANKED:
+      DramPerfModelBanked::dummyOutputSummary(out);
+      break;
+
+   default:
+      break;
    }
 }
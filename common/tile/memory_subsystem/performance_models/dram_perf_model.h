@@ -1,35 +1,45 @@
 #pragma once
 
-#include "queue_model.h"
+#include <iostream>
+#include <string>
+using std::ostream;
+
 #include "fixed_types.h"
-#include "moving_average.h"
-
-// Note: Each Dram Controller owns a single DramModel object
-// Hence, m_dram_bandwidth is the bandwidth for a single DRAM controller
-// Total Bandwidth = m_dram_bandwidth * Number of DRAM controllers
-// Number of DRAM controllers presently = Number of Cores
-// m_dram_bandwidth is expressed in GB/s
-// Assuming the frequency of a core is 1GHz, 
-// m_dram_bandwidth is also expressed in 'Bytes per clock cycle'
-// This DRAM model is not entirely correct.
-// It sort of increases the queueing delay to a huge value if
-// the arrival times of adjacent packets are spread over a large
-// simulated time period
+
+// Note: Each Dram Controller owns a single DramPerfModel object
+// The model type is selected by [dram] perf_model_type
 class DramPerfModel
 {
-   private:
-      // Dram Model Parameters
-      UInt64 m_dram_access_cost;
-      volatile float m_dram_bandwidth;
+   public:
+      enum Type
+      {
+         SIMPLE = 0,
+         BANKED,
+         NUM_DRAM_PERF_MODEL_TYPES
+      };
+
+      DramPerfModel();
+      virtual ~DramPerfModel();
+
+      static DramPerfModel* create(std::string model_type,
+            float dram_access_cost,
+            float dram_bandwidth,
+            bool queue_model_enabled,
+            std::string queue_model_type,
+            UInt32 cache_block_size);
+      static Type parseModelType(std::string model_type);
+
+      // pkt_time and the returned latency are in ns
+      virtual UInt64 getAccessLatency(UInt64 pkt_time, UInt64 pkt_size, IntPtr address) = 0;
+      void enable() { m_enabled = true; }
+      void disable() { m_enabled = false; }
 
-      UInt32 m_cache_block_size;
+      UInt64 getTotalAccesses() { return m_num_accesses; }
+      virtual void outputSummary(ostream& out);
 
+      static void dummyOutputSummary(ostream& out);
 
-      // Queue Model
-      QueueModel* m_queue_model;
-      std::string m_queue_model_type;
-      bool m_queue_model_enabled;
-      
+   protected:
       bool m_enabled;
 
       // Performance Counters
@@ -37,25 +47,8 @@ class DramPerfModel
       volatile double m_total_access_latency;
       volatile double m_total_queueing_delay;
 
-      void createQueueModels();
-      void destroyQueueModels();
-      void initializePerformanceCounters();
+      void updateAccessCounters(UInt64 access_latency, UInt64 queue_delay);
 
-   public:
-      DramPerfModel(float dram_access_cost, 
-            float dram_bandwidth,
-            bool queue_model_enabled,
-            std::string queue_model_type, 
-            UInt32 cache_block_size);
-
-      ~DramPerfModel();
-
-      UInt64 getAccessLatency(UInt64 pkt_time, UInt64 pkt_size);
-      void enable();
-      void disable();
-
-      UInt64 getTotalAccesses() { return m_num_accesses; }
-      void outputSummary(ostream& out);
-
-      static void dummyOutputSummary(ostream& out);
+   private:
+      void initializePerformanceCounters();
 };
@@ -0,0 +1,157 @@
+#include <iostream>
+using namespace std;
+
+#include "simulator.h"
+#include "config.h"
+#include "dram_perf_model_banked.h"
+#include "utils.h"
+#include "log.h"
+
+DramPerfModelBanked::DramPerfModelBanked(float dram_bandwidth,
+      bool queue_model_enabled,
+      std::string queue_model_type,
+      UInt32 cache_block_size):
+   m_last_completion_time(0)
+{
+   UInt32 num_banks_per_channel = 0;
+   UInt32 row_size = 0;
+   try
+   {
+      m_num_channels = Sim()->getCfg()->getInt("dram/banked/num_channels");
+      num_banks_per_channel = Sim()->getCfg()->getInt("dram/banked/num_banks_per_channel");
+      row_size = Sim()->getCfg()->getInt("dram/banked/row_size");
+      m_controller_latency = Sim()->getCfg()->getInt("dram/banked/controller_latency");
+      m_bank_access_time[ROW_HIT] = Sim()->getCfg()->getInt("dram/banked/row_hit_latency");
+      m_bank_access_time[ROW_MISS] = Sim()->getCfg()->getInt("dram/banked/row_miss_latency");
+      m_bank_access_time[ROW_CONFLICT] = Sim()->getCfg()->getInt("dram/banked/row_conflict_latency");
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read [dram/banked] parameters from the cfg file");
+   }
+
+   LOG_ASSERT_ERROR(isPower2(m_num_channels) && isPower2(num_banks_per_channel),
+                    "Number of channels(%u) and banks per channel(%u) must be powers of 2",
+                    m_num_channels, num_banks_per_channel);
+   LOG_ASSERT_ERROR(isPower2(row_size) && (row_size >= cache_block_size),
+                    "Row size(%u) must be a power of 2 and >= cache block size(%u)",
+                    row_size, cache_block_size);
+
+   m_num_banks = m_num_channels * num_banks_per_channel;
+   m_log_num_banks = floorLog2(m_num_banks);
+   m_log_row_size = floorLog2(row_size);
+   // The controller bandwidth is split evenly across its channels
+   m_channel_bandwidth = dram_bandwidth / m_num_channels;
+
+   m_banks.resize(m_num_banks);
+   for (UInt32 i = 0; i < m_num_banks; i++)
+   {
+      m_banks[i].row_open = false;
+      m_banks[i].open_row = 0;
+      m_banks[i].queue_model = queue_model_enabled ?
+                               QueueModel::create(queue_model_type, m_bank_access_time[ROW_HIT]) : NULL;
+      m_banks[i].busy_time = 0;
+   }
+
+   UInt64 min_transfer_time = (UInt64) ((float) cache_block_size / m_channel_bandwidth) + 1;
+   m_channel_queue_models.resize(m_num_channels, NULL);
+   if (queue_model_enabled)
+   {
+      for (UInt32 i = 0; i < m_num_channels; i++)
+         m_channel_queue_models[i] = QueueModel::create(queue_model_type, min_transfer_time);
+   }
+
+   for (UInt32 i = 0; i < NUM_ROW_BUFFER_RESULTS; i++)
+      m_num_row_buffer_accesses[i] = 0;
+}
+
+DramPerfModelBanked::~DramPerfModelBanked()
+{
+   for (UInt32 i = 0; i < m_num_banks; i++)
+      delete m_banks[i].queue_model;
+   for (UInt32 i = 0; i < m_num_channels; i++)
+      delete m_channel_queue_models[i];
+}
+
+UInt64
+DramPerfModelBanked::getAccessLatency(UInt64 pkt_time, UInt64 pkt_size, IntPtr address)
+{
+   IntPtr row = address >> m_log_row_size;
+   UInt32 bank_id = getBankId(row);
+   Bank& bank = m_banks[bank_id];
+
+   RowBufferResult result;
+   if (!bank.row_open)
+      result = ROW_MISS;
+   else if (bank.open_row == row)
+      result = ROW_HIT;
+   else
+      result = ROW_CONFLICT;
+   bank.row_open = true;
+   bank.open_row = row;
+
+   // The open rows are still tracked while the models are disabled, so that
+   // they are warm when the models are enabled
+   if (!m_enabled)
+      return 0;
+
+   UInt64 bank_access_time = m_bank_access_time[result];
+   UInt64 bank_queue_delay = bank.queue_model ?
+                             bank.queue_model->computeQueueDelay(pkt_time, bank_access_time) : 0;
+
+   // The data burst follows the bank access on the channel data bus
+   UInt64 transfer_time = (UInt64) ((float) pkt_size / m_channel_bandwidth) + 1;
+   UInt64 data_ready_time = pkt_time + bank_queue_delay + bank_access_time;
+   QueueModel* channel_queue_model = m_channel_queue_models[getChannelId(bank_id)];
+   UInt64 channel_queue_delay = channel_queue_model ?
+                                channel_queue_model->computeQueueDelay(data_ready_time, transfer_time) : 0;
+
+   UInt64 queue_delay = bank_queue_delay + channel_queue_delay;
+   UInt64 access_latency = m_controller_latency + queue_delay + bank_access_time + transfer_time;
+   LOG_PRINT("Address(%#lx), Bank(%u), Row Buffer Result(%u), Queue Delay(%llu), Access Latency(%llu)",
+             address, bank_id, result, queue_delay, access_latency);
+
+   // Update Memory Counters
+   m_num_row_buffer_accesses[result] ++;
+   bank.busy_time += bank_access_time;
+   m_last_completion_time = max<UInt64>(m_last_completion_time, pkt_time + access_latency);
+   updateAccessCounters(access_latency, queue_delay);
+
+   return access_latency;
+}
+
+float
+DramPerfModelBanked::getBankUtilization() const
+{
+   if (m_last_completion_time == 0)
+      return 0.0;
+
+   UInt64 total_busy_time = 0;
+   for (UInt32 i = 0; i < m_num_banks; i++)
+      total_busy_time += m_banks[i].busy_time;
+   return ((float) total_busy_time) / ((float) m_last_completion_time * m_num_banks);
+}
+
+void
+DramPerfModelBanked::outputSummary(ostream& out)
+{
+   DramPerfModel::outputSummary(out);
+
+   UInt64 num_accesses = max<UInt64>(m_num_accesses, 1);
+   out << "    Row Buffer Hit Rate (\%): " <<
+      100.0 * m_num_row_buffer_accesses[ROW_HIT] / num_accesses << endl;
+   out << "    Row Buffer Miss Rate (\%): " <<
+      100.0 * m_num_row_buffer_accesses[ROW_MISS] / num_accesses << endl;
+   out << "    Row Buffer Conflict Rate (\%): " <<
+      100.0 * m_num_row_buffer_accesses[ROW_CONFLICT] / num_accesses << endl;
+   out << "    Bank Utilization (\%): " << getBankUtilization() * 100 << endl;
+}
+
+void
+DramPerfModelBanked::dummyOutputSummary(ostream& out)
+{
+   out << "    Row Buffer Hit Rate (\%): " << endl;
+   out << "    Row Buffer Miss Rate (\%): " << endl;
+   out << "    Row Buffer Conflict Rate (\%): " << endl;
+   out << "    Bank Utilization (\%): " << endl;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+using std::vector;
+
+#include "dram_perf_model.h"
+#include "queue_model.h"
+#include "fixed_types.h"
+
+// Models each DRAM controller as a set of channels, each with a set of banks
+// that keep their last accessed row open (open-page policy)
+// An access costs the controller latency, the bank access time (row hit, row
+// miss on a closed bank or row conflict), the burst on the channel data bus
+// and the queueing delays at the bank and the channel
+// FR-FCFS scheduling is approximated by queueing requests per bank: a row hit
+// only occupies its bank for the row hit latency, so it fills the gaps that
+// the history-based queue models keep between longer row misses and conflicts
+// Rows are spread across banks (and banks across channels) by XOR-ing the
+// row number with its upper bits, so that strided streams do not camp on one bank
+// Addresses are local to the controller (see AddressHomeLookup::getLocalAddress()),
+// so that a row holds consecutive lines of this controller
+class DramPerfModelBanked : public DramPerfModel
+{
+   public:
+      DramPerfModelBanked(float dram_bandwidth,
+            bool queue_model_enabled,
+            std::string queue_model_type,
+            UInt32 cache_block_size);
+      ~DramPerfModelBanked();
+
+      UInt64 getAccessLatency(UInt64 pkt_time, UInt64 pkt_size, IntPtr address);
+
+      void outputSummary(ostream& out);
+
+      static void dummyOutputSummary(ostream& out);
+
+   private:
+      enum RowBufferResult
+      {
+         ROW_HIT = 0,
+         ROW_MISS,
+         ROW_CONFLICT,
+         NUM_ROW_BUFFER_RESULTS
+      };
+
+      struct Bank
+      {
+         bool row_open;
+         IntPtr open_row;
+         QueueModel* queue_model;
+         UInt64 busy_time;
+      };
+
+      // Organization
+      UInt32 m_num_channels;
+      UInt32 m_num_banks;
+      UInt32 m_log_num_banks;
+      UInt32 m_log_row_size;
+
+      // Timing (in ns)
+      UInt64 m_controller_latency;
+      UInt64 m_bank_access_time[NUM_ROW_BUFFER_RESULTS];
+      // In 'Bytes per ns'
+      float m_channel_bandwidth;
+
+      vector<Bank> m_banks;
+      vector<QueueModel*> m_channel_queue_models;
+
+      // Performance Counters
+      UInt64 m_num_row_buffer_accesses[NUM_ROW_BUFFER_RESULTS];
+      UInt64 m_last_completion_time;
+
+      UInt32 getBankId(IntPtr row) const
+      { return (UInt32) ((row ^ (row >> m_log_num_banks)) & (m_num_banks - 1)); }
+      UInt32 getChannelId(UInt32 bank_id) const
+      { return bank_id & (m_num_channels - 1); }
+
+      float getBankUtilization() const;
+};
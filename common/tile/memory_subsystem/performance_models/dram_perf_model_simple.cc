@@ -0,0 +1,140 @@
+#include <iostream>
+using namespace std;
+
+#include "simulator.h"
+#include "config.h"
+#include "dram_perf_model_simple.h"
+#include "queue_model_history_list.h"
+#include "queue_model_history_tree.h"
+
+// Note: Each Dram Controller owns a single DramModel object
+// Hence, m_dram_bandwidth is the bandwidth for a single DRAM controller
+// Total Bandwidth = m_dram_bandwidth * Number of DRAM controllers
+// Number of DRAM controllers presently = Number of Cores
+// m_dram_bandwidth is expressed in GB/s
+// Assuming the frequency of a core is 1GHz, 
+// m_dram_bandwidth is also expressed in 'Bytes per clock cycle'
+// This DRAM model is not entirely correct.
+// It sort of increases the queueing delay to a huge value if
+// the arrival times of adjacent packets are spread over a large
+// simulated time period
+DramPerfModelSimple::DramPerfModelSimple(float dram_access_cost, 
+      float dram_bandwidth,
+      bool queue_model_enabled,
+      std::string queue_model_type, 
+      UInt32 cache_block_size):
+   m_dram_access_cost(UInt64(dram_access_cost)),
+   m_dram_bandwidth(dram_bandwidth),
+   m_cache_block_size(cache_block_size),
+   m_queue_model_type(queue_model_type),
+   m_queue_model_enabled(queue_model_enabled)
+{
+   createQueueModels();
+}
+
+DramPerfModelSimple::~DramPerfModelSimple()
+{
+   destroyQueueModels();
+}
+
+void
+DramPerfModelSimple::createQueueModels()
+{
+   if (m_queue_model_enabled)
+   {
+      UInt64 min_processing_time = (UInt64) ((float) m_cache_block_size / m_dram_bandwidth) + 1;
+      m_queue_model = QueueModel::create(m_queue_model_type, min_processing_time);
+   }
+   else
+   {
+      m_queue_model = NULL;
+   }
+}
+
+void
+DramPerfModelSimple::destroyQueueModels()
+{
+   if (m_queue_model_enabled)
+   {
+      delete m_queue_model;
+   }
+}
+
+UInt64 
+DramPerfModelSimple::getAccessLatency(UInt64 pkt_time, UInt64 pkt_size, IntPtr address)
+{
+   // pkt_size is in 'Bytes'
+   // m_dram_bandwidth is in 'Bytes per clock cycle'
+   if (!m_enabled) 
+   {
+      LOG_PRINT("Not enabled. Return 0");
+      return 0;
+   }
+
+   UInt64 processing_time = (UInt64) ((float) pkt_size/m_dram_bandwidth) + 1;
+   LOG_PRINT("Processing Time(%llu)", processing_time);
+
+   // Compute Queue Delay
+   UInt64 queue_delay;
+   if (m_queue_model)
+   {
+      queue_delay = m_queue_model->computeQueueDelay(pkt_time, processing_time);
+   }
+   else
+   {
+      queue_delay = 0;
+   }
+   LOG_PRINT("Queue Delay(%llu)", queue_delay);
+   UInt64 access_latency = queue_delay + processing_time + m_dram_access_cost;
+   LOG_PRINT("Access Latency(%llu)", access_latency);
+
+
+   // Update Memory Counters
+   updateAccessCounters(access_latency, queue_delay);
+
+   return access_latency;
+}
+
+void
+DramPerfModelSimple::outputSummary(ostream& out)
+{
+   DramPerfModel::outputSummary(out);
+
+   std::string queue_model_type = Sim()->getCfg()->getString("dram/queue_model/type");
+   if (m_queue_model && ((queue_model_type == "history_list") || (queue_model_type == "history_tree")))
+   {
+      out << "    Queue Model:" << endl;
+       
+      if (queue_model_type == "history_list")
+      {  
+         float queue_utilization = ((QueueModelHistoryList*) m_queue_model)->getQueueUtilization();
+         float frac_requests_using_analytical_model = \
+            ((float) ((QueueModelHistoryList*) m_queue_model)->getTotalRequestsUsingAnalyticalModel()) / \
+            ((QueueModelHistoryList*) m_queue_model)->getTotalRequests();
+         out << "      Queue Utilization(\%): " << queue_utilization * 100 << endl;
+         out << "      Analytical Model Used(\%): " << frac_requests_using_analytical_model * 100 << endl;
+      }
+      else // (queue_model_type == "history_tree")
+      {
+         float queue_utilization = ((QueueModelHistoryTree*) m_queue_model)->getQueueUtilization();
+         float frac_requests_using_analytical_model = \
+            ((float) ((QueueModelHistoryTree*) m_queue_model)->getTotalRequestsUsingAnalyticalModel()) / \
+            ((QueueModelHistoryTree*) m_queue_model)->getTotalRequests();
+         out << "      Queue Utilization(\%): " << queue_utilization * 100 << endl;
+         out << "      Analytical Model Used(\%): " << frac_requests_using_analytical_model * 100 << endl;
+      }
+   }
+}
+
+void
+DramPerfModelSimple::dummyOutputSummary(ostream& out)
+{
+   bool queue_model_enabled = Sim()->getCfg()->getBool("dram/queue_model/enabled");
+   std::string queue_model_type = Sim()->getCfg()->getString("dram/queue_model/type");
+   if (queue_model_enabled && ((queue_model_type == "history_list") || (queue_model_type == "history_tree")))
+   {
+      out << "    Queue Model:" << endl;
+      out << "      Queue Utilization(\%): " << endl;
+      out << "      Analytical Model Used(\%): " << endl;
+   }
+}
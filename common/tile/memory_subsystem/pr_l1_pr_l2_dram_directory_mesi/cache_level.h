@@ -0,0 +1,12 @@
+#pragma once
+
+namespace PrL1PrL2DramDirectoryMESI
+{
+
+enum CacheLevel
+{
+   L1,
+   L2
+};
+
+}
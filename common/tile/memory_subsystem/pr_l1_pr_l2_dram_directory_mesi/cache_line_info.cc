@@ -0,0 +1,83 @@
+#include "cache_line_info.h"
+#include "cache_utils.h"
+#include "log.h"
+#include <new>
+
+namespace PrL1PrL2DramDirectoryMESI
+{
+
+UInt32
+getCacheLineInfoSize(SInt32 cache_level)
+{
+   switch (cache_level)
+   {
+   case L1:
+      return sizeof(PrL1CacheLineInfo);
+   case L2:
+      return sizeof(PrL2CacheLineInfo);
+   default:
+      LOG_PRINT_ERROR("Unrecognized Cache Level(%u)", cache_level);
+      return 0;
+   }
+}
+
+CacheLineInfo*
+initCacheLineInfo(SInt32 cache_level, Byte* storage)
+{
+   switch (cache_level)
+   {
+   case L1:
+      return new (storage) PrL1CacheLineInfo();
+   case L2:
+      return new (storage) PrL2CacheLineInfo();
+   default:
+      LOG_PRINT_ERROR("Unrecognized Cache Level(%u)", cache_level);
+      return (CacheLineInfo*) NULL;
+   }
+}
+
+//// PrL2 CacheLineInfo
+
+PrL2CacheLineInfo::PrL2CacheLineInfo(IntPtr tag, CacheState::Type cstate, MemComponent::Type cached_loc)
+   : CacheLineInfo(tag, cstate)
+   , _cached_loc(cached_loc)
+{}
+
+MemComponent::Type 
+PrL2CacheLineInfo::getCachedLoc() const
+{
+   return _cached_loc;
+}
+
+void 
+PrL2CacheLineInfo::setCachedLoc(MemComponent::Type cached_loc)
+{
+   assert(cached_loc != MemComponent::INVALID);
+   assert(_cached_loc == MemComponent::INVALID);
+   _cached_loc = cached_loc;
+}
+
+void
+PrL2CacheLineInfo::clearCachedLoc(MemComponent::Type cached_loc)
+{
+   assert(cached_loc != MemComponent::INVALID);
+   assert(_cached_loc == cached_loc);
+   _cached_loc = MemComponent::INVALID;
+}
+
+void 
+PrL2CacheLineInfo::invalidate()
+{
+   CacheLineInfo::invalidate();
+   _cached_loc = MemComponent::INVALID;
+}
+
+void 
+PrL2CacheLineInfo::assign(const CacheLineInfo* cache_line_info)
+{
+   CacheLineInfo::assign(cache_line_info);
+   const PrL2CacheLineInfo* L2_cache_line_info = static_cast<const PrL2CacheLineInfo*>(cache_line_info);
+   _cached_loc = L2_cache_line_info->getCachedLoc();
+}
+
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "../cache/cache_line_info.h"
+#include "cache_state.h"
+#include "cache_level.h"
+#include "mem_component.h"
+
+namespace PrL1PrL2DramDirectoryMESI
+{
+
+UInt32 getCacheLineInfoSize(SInt32 cache_level);
+CacheLineInfo* initCacheLineInfo(SInt32 cache_level, Byte* storage);
+
+typedef CacheLineInfo PrL1CacheLineInfo;
+
+class PrL2CacheLineInfo : public CacheLineInfo
+{
+public:
+   PrL2CacheLineInfo(IntPtr tag = ~0, CacheState::Type cstate = CacheState::INVALID,
+                     MemComponent::Type cached_loc = MemComponent::INVALID);
+
+   MemComponent::Type getCachedLoc() const;
+   void setCachedLoc(MemComponent::Type cached_loc);
+   void clearCachedLoc(MemComponent::Type cached_loc);
+
+   void invalidate();
+   void assign(const CacheLineInfo* cache_line_info);
+
+private:
+   MemComponent::Type _cached_loc;
+};
+
+}
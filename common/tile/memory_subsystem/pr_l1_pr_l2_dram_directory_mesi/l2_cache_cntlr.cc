@@ -0,0 +1,652 @@
+#include "l1_cache_cntlr.h"
+#include "l2_cache_cntlr.h"
+#include "memory_manager.h"
+#include "log.h"
+
+using std::endl;
+
+namespace PrL1PrL2DramDirectoryMESI
+{
+
+L2CacheCntlr::L2CacheCntlr(MemoryManager* memory_manager,
+                           L1CacheCntlr* l1_cache_cntlr,
+                           AddressHomeLookup* dram_directory_home_lookup,
+                           UInt32 cache_line_size,
+                           UInt32 l2_cache_size,
+                           UInt32 l2_cache_associativity,
+                           string l2_cache_replacement_policy,
+                           UInt32 l2_cache_access_delay,
+                           bool l2_cache_track_miss_types,
+                           string l2_cache_prefetcher_type,
+                           UInt32 l2_cache_prefetcher_degree,
+                           UInt32 l2_cache_prefetcher_table_size,
+                           float frequency)
+   : _memory_manager(memory_manager)
+   , _l1_cache_cntlr(l1_cache_cntlr)
+   , _dram_directory_home_lookup(dram_directory_home_lookup)
+   , _total_exclusive_grants(0)
+   , _total_silent_upgrades(0)
+{
+   _l2_cache_replacement_policy_obj = 
+      CacheReplacementPolicy::create(l2_cache_replacement_policy, l2_cache_size, l2_cache_associativity, cache_line_size);
+   _l2_cache_hash_fn_obj = new CacheHashFn(l2_cache_size, l2_cache_associativity, cache_line_size);
+   
+   _l2_cache = new Cache("L2",
+         PR_L1_PR_L2_DRAM_DIRECTORY_MESI,
+         Cache::UNIFIED_CACHE,
+         L2,
+         Cache::WRITE_BACK,
+         l2_cache_size, 
+         l2_cache_associativity, 
+         cache_line_size, 
+         _l2_cache_replacement_policy_obj,
+         _l2_cache_hash_fn_obj,
+         l2_cache_access_delay,
+         frequency,
+         l2_cache_track_miss_types);
+
+   _l2_cache_prefetcher = Prefetcher::create(l2_cache_prefetcher_type, cache_line_size,
+         l2_cache_prefetcher_degree, l2_cache_prefetcher_table_size);
+}
+
+L2CacheCntlr::~L2CacheCntlr()
+{
+   delete _l2_cache;
+   delete _l2_cache_replacement_policy_obj;
+   delete _l2_cache_hash_fn_obj;
+   delete _l2_cache_prefetcher;
+}
+
+void
+L2CacheCntlr::invalidateCacheLine(IntPtr address, PrL2CacheLineInfo& l2_cache_line_info)
+{
+   l2_cache_line_info.invalidate();
+   _l2_cache->setCacheLineInfo(address, &l2_cache_line_info);
+
+   if (_l2_cache_prefetcher)
+      _l2_cache_prefetcher->recordEviction(address);
+}
+
+void
+L2CacheCntlr::readCacheLine(IntPtr address, Byte* data_buf)
+{
+   _l2_cache->accessCacheLine(address, Cache::LOAD, data_buf, getCacheLineSize());
+}
+
+void
+L2CacheCntlr::writeCacheLine(IntPtr address, UInt32 offset, Byte* data_buf, UInt32 data_length)
+{
+   _l2_cache->accessCacheLine(address + offset, Cache::STORE, data_buf, data_length);
+
+   PrL2CacheLineInfo l2_cache_line_info;
+   _l2_cache->getCacheLineInfo(address, &l2_cache_line_info);
+   if (l2_cache_line_info.getCState() == CacheState::EXCLUSIVE)
+   {
+      // Silent upgrade - the directory already tracks this tile as the owner
+      l2_cache_line_info.setCState(CacheState::MODIFIED);
+      _l2_cache->setCacheLineInfo(address, &l2_cache_line_info);
+      setCacheLineStateInL1(l2_cache_line_info.getCachedLoc(), address, CacheState::MODIFIED);
+      _total_silent_upgrades ++;
+   }
+}
+
+void
+L2CacheCntlr::insertCacheLine(IntPtr address, CacheState::Type cstate, Byte* fill_buf, MemComponent::Type mem_component)
+{
+   // Construct meta-data info about l2 cache line
+   PrL2CacheLineInfo l2_cache_line_info;
+   l2_cache_line_info.setTag(_l2_cache->getTag(address));
+   l2_cache_line_info.setCState(cstate);
+   l2_cache_line_info.setCachedLoc(mem_component);
+
+   // Evicted line information
+   bool eviction;
+   IntPtr evicted_address;
+   PrL2CacheLineInfo evicted_cache_line_info;
+   Byte writeback_buf[getCacheLineSize()];
+
+   _l2_cache->insertCacheLine(address, &l2_cache_line_info, fill_buf,
+                              &eviction, &evicted_address, &evicted_cache_line_info, writeback_buf);
+
+   if (eviction)
+   {
+      LOG_PRINT("Eviction: address(%#lx)", evicted_address);
+      if (_l2_cache_prefetcher)
+         _l2_cache_prefetcher->recordEviction(evicted_address);
+      invalidateCacheLineInL1(evicted_cache_line_info.getCachedLoc(), evicted_address);
+
+      UInt32 home_node_id = getHome(evicted_address);
+      bool eviction_msg_modeled = Config::getSingleton()->isApplicationTile(getTileId());
+
+      if (evicted_cache_line_info.getCState() == CacheState::MODIFIED)
+      {
+         // Send back the data also
+         ShmemMsg msg(ShmemMsg::FLUSH_REP, MemComponent::L2_CACHE, MemComponent::DRAM_DIRECTORY, getTileId(), evicted_address,
+                      writeback_buf, getCacheLineSize(), eviction_msg_modeled);
+         getMemoryManager()->sendMsg(home_node_id, msg);
+      }
+      else
+      {
+         // A clean EXCLUSIVE line is dropped like a SHARED one
+         LOG_ASSERT_ERROR((evicted_cache_line_info.getCState() == CacheState::SHARED) ||
+                          (evicted_cache_line_info.getCState() == CacheState::EXCLUSIVE),
+               "evicted_address(%#lx), cache state(%u), cached loc(%u)",
+               evicted_address, evicted_cache_line_info.getCState(), evicted_cache_line_info.getCachedLoc());
+         ShmemMsg msg(ShmemMsg::INV_REP, MemComponent::L2_CACHE, MemComponent::DRAM_DIRECTORY, getTileId(), evicted_address, eviction_msg_modeled);
+         getMemoryManager()->sendMsg(home_node_id, msg);
+      }
+   }
+}
+
+void
+L2CacheCntlr::setCacheLineStateInL1(MemComponent::Type mem_component, IntPtr address, CacheState::Type cstate)
+{
+   if (mem_component != MemComponent::INVALID)
+      _l1_cache_cntlr->setCacheLineState(mem_component, address, cstate);
+}
+
+void
+L2CacheCntlr::invalidateCacheLineInL1(MemComponent::Type mem_component, IntPtr address)
+{
+   if (mem_component != MemComponent::INVALID)
+      _l1_cache_cntlr->invalidateCacheLine(mem_component, address);
+}
+
+void
+L2CacheCntlr::insertCacheLineInL1(MemComponent::Type mem_component, IntPtr address,
+                                  CacheState::Type cstate, Byte* fill_buf)
+{
+   assert(mem_component != MemComponent::INVALID);
+
+   bool eviction;
+   IntPtr evicted_address;
+
+   // Insert the Cache Line in L1 Cache
+   _l1_cache_cntlr->insertCacheLine(mem_component, address, cstate, fill_buf, &eviction, &evicted_address);
+
+   if (eviction)
+   {
+      // Clear the Present bit in L2 Cache corresponding to the evicted line
+      // Get the cache line info first
+      PrL2CacheLineInfo evicted_cache_line_info;
+      _l2_cache->getCacheLineInfo(evicted_address, &evicted_cache_line_info);
+      // Clear the present bit and store the info back
+      evicted_cache_line_info.clearCachedLoc(mem_component);
+      _l2_cache->setCacheLineInfo(evicted_address, &evicted_cache_line_info);
+   }
+}
+
+void
+L2CacheCntlr::insertCacheLineInHierarchy(IntPtr address, CacheState::Type cstate, Byte* fill_buf)
+{
+   assert(address == _outstanding_shmem_msg.getAddress());
+   MemComponent::Type mem_component = _outstanding_shmem_msg.getSenderMemComponent();
+  
+   // Insert Line in the L2 cache
+   insertCacheLine(address, cstate, fill_buf, mem_component);
+   
+   // Insert Line in the L1 cache
+   insertCacheLineInL1(mem_component, address, cstate, fill_buf);
+}
+
+pair<bool,Cache::MissType>
+L2CacheCntlr::processShmemRequestFromL1Cache(MemComponent::Type mem_component, Core::mem_op_t mem_op_type, IntPtr address)
+{
+   LOG_PRINT("processShmemRequestFromL1Cache[Mem Component(%u), Mem Op Type(%u), Address(%#llx)]",
+             mem_component, mem_op_type, address);
+
+   PrL2CacheLineInfo l2_cache_line_info;
+   _l2_cache->getCacheLineInfo(address, &l2_cache_line_info);
+
+   // Get the state associated with the address in the L2 cache
+   CacheState::Type cstate = l2_cache_line_info.getCState();
+
+   // Return arguments is a pair
+   // (1) Is cache miss? (2) Cache miss type (COLD, CAPACITY, UPGRADE, SHARING)
+   pair<bool,Cache::MissType> shmem_request_status_in_l2_cache = operationPermissibleinL2Cache(mem_op_type, address, cstate);
+   if (!shmem_request_status_in_l2_cache.first)
+   {
+      Byte data_buf[getCacheLineSize()];
+      
+      // Read the cache line from L2 cache
+      readCacheLine(address, data_buf);
+
+      // Insert the cache line in the L1 cache
+      insertCacheLineInL1(mem_component, address, cstate, data_buf);
+      
+      // Set that the cache line in present in the L1 cache in the L2 tags
+      l2_cache_line_info.setCachedLoc(mem_component);
+      _l2_cache->setCacheLineInfo(address, &l2_cache_line_info);
+   }
+
+   if ( _l2_cache_prefetcher && (cstate != CacheState::INVALID) )
+   {
+      // A prefetched line that is still being filled delays the access
+      UInt64 curr_time = getShmemPerfModel()->getCycleCount();
+      if (_l2_cache_prefetcher->recordDemandAccess(address, curr_time))
+      {
+         getShmemPerfModel()->setCycleCount(curr_time);
+         // Keep prefetching ahead of the accesses that hit in prefetched lines
+         issuePrefetches(address, Config::getSingleton()->isApplicationTile(getTileId()));
+      }
+   }
+   
+   return shmem_request_status_in_l2_cache;
+}
+
+void
+L2CacheCntlr::handleMsgFromL1Cache(ShmemMsg* shmem_msg)
+{
+   IntPtr address = shmem_msg->getAddress();
+   ShmemMsg::Type shmem_msg_type = shmem_msg->getType();
+
+   assert(shmem_msg->getDataBuf() == NULL);
+   assert(shmem_msg->getDataLength() == 0);
+
+   assert(_outstanding_shmem_msg.getAddress() == INVALID_ADDRESS);
+
+   // Set outstanding shmem msg parameters
+   _outstanding_shmem_msg = *shmem_msg;
+   _outstanding_shmem_msg_time = getShmemPerfModel()->getCycleCount();
+
+   if (_l2_cache_prefetcher && _l2_cache_prefetcher->isOutstanding(address))
+   {
+      // The line is already being prefetched. Wait for the prefetch instead of requesting it again
+      _l2_cache_prefetcher->recordLateDemandMiss(address);
+   }
+   else
+   {
+      switch (shmem_msg_type)
+      {
+         case ShmemMsg::EX_REQ:
+            processExReqFromL1Cache(shmem_msg);
+            break;
+
+         case ShmemMsg::SH_REQ:
+            processShReqFromL1Cache(shmem_msg);
+            break;
+
+         default:
+            LOG_PRINT_ERROR("Unrecognized shmem msg type (%u)", shmem_msg_type);
+            break;
+      }
+
+      if (_l2_cache_prefetcher)
+         _l2_cache_prefetcher->recordDemandMiss();
+   }
+
+   if (_l2_cache_prefetcher)
+      issuePrefetches(address, shmem_msg->isModeled());
+}
+
+void
+L2CacheCntlr::processExReqFromL1Cache(ShmemMsg* shmem_msg)
+{
+   // We need to send a request to the Dram Directory Cache
+   IntPtr address = shmem_msg->getAddress();
+
+   PrL2CacheLineInfo l2_cache_line_info;
+   _l2_cache->getCacheLineInfo(address, &l2_cache_line_info);
+   CacheState::Type cstate = l2_cache_line_info.getCState();
+
+   assert((cstate == CacheState::INVALID) || (cstate == CacheState::SHARED));
+   if (cstate == CacheState::SHARED)
+   {
+      // This will clear the 'Present' bit also
+      invalidateCacheLine(address, l2_cache_line_info);
+      ShmemMsg msg(ShmemMsg::INV_REP, MemComponent::L2_CACHE, MemComponent::DRAM_DIRECTORY, getTileId(), address, shmem_msg->isModeled());
+      getMemoryManager()->sendMsg(getHome(address), msg);
+   }
+
+   // Send out EX_REQ to DRAM_DIRECTORY
+   ShmemMsg msg(ShmemMsg::EX_REQ, MemComponent::L2_CACHE, MemComponent::DRAM_DIRECTORY, getTileId(), address, shmem_msg->isModeled());
+   getMemoryManager()->sendMsg(getHome(address), msg);
+}
+
+void
+L2CacheCntlr::processShReqFromL1Cache(ShmemMsg* shmem_msg)
+{
+   IntPtr address = shmem_msg->getAddress();
+
+   // Send out SH_REQ ro DRAM_DIRECTORY
+   ShmemMsg msg(ShmemMsg::SH_REQ, MemComponent::L2_CACHE, MemComponent::DRAM_DIRECTORY, getTileId(), address, shmem_msg->isModeled());
+   getMemoryManager()->sendMsg(getHome(address), msg);
+}
+
+void
+L2CacheCntlr::issuePrefetches(IntPtr address, bool modeled)
+{
+   vector<IntPtr> prefetch_list;
+   _l2_cache_prefetcher->train(address, prefetch_list);
+
+   for (vector<IntPtr>::iterator it = prefetch_list.begin(); it != prefetch_list.end(); it++)
+   {
+      IntPtr prefetch_address = *it;
+      if (prefetch_address == _outstanding_shmem_msg.getAddress())
+         continue;
+
+      PrL2CacheLineInfo l2_cache_line_info;
+      _l2_cache->getCacheLineInfo(prefetch_address, &l2_cache_line_info);
+      if (l2_cache_line_info.getCState() != CacheState::INVALID)
+         continue;
+
+      // Prefetches are SH_REQs that are not tied to the outstanding miss
+      _l2_cache_prefetcher->recordIssue(prefetch_address);
+      ShmemMsg msg(ShmemMsg::SH_REQ, MemComponent::L2_CACHE, MemComponent::DRAM_DIRECTORY, getTileId(), prefetch_address, modeled);
+      getMemoryManager()->sendMsg(getHome(prefetch_address), msg);
+   }
+}
+
+void
+L2CacheCntlr::handleMsgFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg)
+{
+   ShmemMsg::Type shmem_msg_type = shmem_msg->getType();
+
+   // Prefetches are SH_REQs and may be granted the line in the EXCLUSIVE state
+   if ( ((shmem_msg_type == ShmemMsg::SH_REP) || (shmem_msg_type == ShmemMsg::EX_REP)) &&
+        _l2_cache_prefetcher && _l2_cache_prefetcher->isOutstanding(shmem_msg->getAddress()) )
+   {
+      processPrefetchRepFromDramDirectory(sender, shmem_msg);
+      return;
+   }
+
+   switch (shmem_msg_type)
+   {
+      case ShmemMsg::EX_REP:
+         processExRepFromDramDirectory(sender, shmem_msg);
+         break;
+      case ShmemMsg::SH_REP:
+         processShRepFromDramDirectory(sender, shmem_msg);
+         break;
+      case ShmemMsg::INV_REQ:
+         processInvReqFromDramDirectory(sender, shmem_msg);
+         break;
+      case ShmemMsg::FLUSH_REQ:
+         processFlushReqFromDramDirectory(sender, shmem_msg);
+         break;
+      case ShmemMsg::WB_REQ:
+         processWbReqFromDramDirectory(sender, shmem_msg);
+         break;
+      default:
+         LOG_PRINT_ERROR("Unrecognized msg type: %u", shmem_msg_type);
+         break;
+   }
+
+   if ((shmem_msg_type == ShmemMsg::EX_REP) || (shmem_msg_type == ShmemMsg::SH_REP))
+      completeOutstandingShmemMsg();
+}
+
+void
+L2CacheCntlr::completeOutstandingShmemMsg()
+{
+   LOG_ASSERT_ERROR(_outstanding_shmem_msg_time <= getShmemPerfModel()->getCycleCount(),
+                    "Outstanding msg time(%llu), Curr cycle count(%llu)",
+                    _outstanding_shmem_msg_time, getShmemPerfModel()->getCycleCount());
+   
+   // Reset the clock to the time the request left the tile is miss type is not modeled
+   if (!_outstanding_shmem_msg.isModeled())
+      getShmemPerfModel()->setCycleCount(_outstanding_shmem_msg_time);
+
+   // Increment the clock by the time taken to update the L2 cache
+   getMemoryManager()->incrCycleCount(MemComponent::L2_CACHE, CachePerfModel::ACCESS_CACHE_DATA_AND_TAGS);
+
+   // There are no more outstanding memory requests
+   _outstanding_shmem_msg.setAddress(INVALID_ADDRESS);
+   
+   _memory_manager->wakeUpAppThread();
+   _memory_manager->waitForAppThread();
+}
+
+void
+L2CacheCntlr::processPrefetchRepFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg)
+{
+   IntPtr address = shmem_msg->getAddress();
+   Byte* data_buf = shmem_msg->getDataBuf();
+   CacheState::Type cstate = (shmem_msg->getType() == ShmemMsg::EX_REP) ? CacheState::EXCLUSIVE : CacheState::SHARED;
+   if (cstate == CacheState::EXCLUSIVE)
+      _total_exclusive_grants ++;
+
+   if (address != _outstanding_shmem_msg.getAddress())
+   {
+      // Increment the clock by the time taken to update the L2 cache
+      getMemoryManager()->incrCycleCount(MemComponent::L2_CACHE, CachePerfModel::ACCESS_CACHE_DATA_AND_TAGS);
+      _l2_cache_prefetcher->recordFill(address, getShmemPerfModel()->getCycleCount());
+
+      // Insert Cache Line in the L2 Cache only
+      insertCacheLine(address, cstate, data_buf, MemComponent::INVALID);
+      return;
+   }
+
+   // The outstanding miss has been waiting on this prefetch
+   _l2_cache_prefetcher->recordFill(address, getShmemPerfModel()->getCycleCount());
+
+   if ( (_outstanding_shmem_msg.getType() == ShmemMsg::SH_REQ) || (cstate == CacheState::EXCLUSIVE) )
+   {
+      // Insert Cache Line in L1 and L2 Caches
+      insertCacheLineInHierarchy(address, cstate, data_buf);
+      completeOutstandingShmemMsg();
+   }
+   else
+   {
+      // The line still has to be obtained in the MODIFIED state
+      insertCacheLine(address, CacheState::SHARED, data_buf, MemComponent::INVALID);
+      processExReqFromL1Cache(&_outstanding_shmem_msg);
+   }
+}
+
+void
+L2CacheCntlr::processExRepFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg)
+{
+   IntPtr address = shmem_msg->getAddress();
+   Byte* data_buf = shmem_msg->getDataBuf();
+
+   // An EX_REP to a SH_REQ grants the line in the EXCLUSIVE state (no other sharers)
+   CacheState::Type cstate = CacheState::MODIFIED;
+   if (_outstanding_shmem_msg.getType() == ShmemMsg::SH_REQ)
+   {
+      cstate = CacheState::EXCLUSIVE;
+      _total_exclusive_grants ++;
+   }
+   
+   // Insert Cache Line in L1 and L2 Caches
+   insertCacheLineInHierarchy(address, cstate, data_buf);
+}
+
+void
+L2CacheCntlr::processShRepFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg)
+{
+   IntPtr address = shmem_msg->getAddress();
+   Byte* data_buf = shmem_msg->getDataBuf();
+
+   // Insert Cache Line in L1 and L2 Caches
+   insertCacheLineInHierarchy(address, CacheState::SHARED, data_buf);
+}
+
+void
+L2CacheCntlr::processInvReqFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg)
+{
+   IntPtr address = shmem_msg->getAddress();
+
+   PrL2CacheLineInfo l2_cache_line_info;
+   _l2_cache->getCacheLineInfo(address, &l2_cache_line_info);
+   
+   CacheState::Type cstate = l2_cache_line_info.getCState();
+
+   if (cstate != CacheState::INVALID)
+   {
+      assert(cstate == CacheState::SHARED);
+  
+      // Update Shared memory performance counters for access to L2 Cache
+      getMemoryManager()->incrCycleCount(MemComponent::L2_CACHE, CachePerfModel::ACCESS_CACHE_TAGS);
+      // Update Shared Mem perf counters for access to L1 Cache
+      getMemoryManager()->incrCycleCount(l2_cache_line_info.getCachedLoc(), CachePerfModel::ACCESS_CACHE_TAGS);
+
+      // Invalidate the line in L1 Cache
+      invalidateCacheLineInL1(l2_cache_line_info.getCachedLoc(), address);
+      // Invalidate the line in the L2 cache also
+      invalidateCacheLine(address, l2_cache_line_info);
+
+      // Send out INV_REP to DRAM_DIRECTORY
+      ShmemMsg msg(ShmemMsg::INV_REP, MemComponent::L2_CACHE, MemComponent::DRAM_DIRECTORY, shmem_msg->getRequester(), address, shmem_msg->isModeled());
+      getMemoryManager()->sendMsg(sender, msg);
+   }
+   else
+   {
+      // Update Shared Mem perf counters for access to L2 Cache
+      getMemoryManager()->incrCycleCount(MemComponent::L2_CACHE, CachePerfModel::ACCESS_CACHE_TAGS);
+   }
+}
+
+void
+L2CacheCntlr::processFlushReqFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg)
+{
+   IntPtr address = shmem_msg->getAddress();
+
+   PrL2CacheLineInfo l2_cache_line_info;
+   _l2_cache->getCacheLineInfo(address, &l2_cache_line_info);
+   CacheState::Type cstate = l2_cache_line_info.getCState();
+   if (cstate == CacheState::EXCLUSIVE)
+   {
+      // Update Shared Mem perf counters for access to L2 Cache
+      getMemoryManager()->incrCycleCount(MemComponent::L2_CACHE, CachePerfModel::ACCESS_CACHE_TAGS);
+      // Update Shared Mem perf counters for access to L1 Cache
+      getMemoryManager()->incrCycleCount(l2_cache_line_info.getCachedLoc(), CachePerfModel::ACCESS_CACHE_TAGS);
+
+      // Invalidate the line in L1 Cache
+      invalidateCacheLineInL1(l2_cache_line_info.getCachedLoc(), address);
+      // Invalidate the line in the L2 cache also
+      invalidateCacheLine(address, l2_cache_line_info);
+
+      // The line is clean. Send out INV_REP (without data) to DRAM_DIRECTORY
+      ShmemMsg msg(ShmemMsg::INV_REP, MemComponent::L2_CACHE, MemComponent::DRAM_DIRECTORY, shmem_msg->getRequester(), address, shmem_msg->isModeled());
+      getMemoryManager()->sendMsg(sender, msg);
+   }
+   else if (cstate != CacheState::INVALID)
+   {
+      assert(cstate == CacheState::MODIFIED);
+      
+      // Update Shared Mem perf counters for access to L2 Cache
+      getMemoryManager()->incrCycleCount(MemComponent::L2_CACHE, CachePerfModel::ACCESS_CACHE_DATA_AND_TAGS);
+      // Update Shared Mem perf counters for access to L1 Cache
+      getMemoryManager()->incrCycleCount(l2_cache_line_info.getCachedLoc(), CachePerfModel::ACCESS_CACHE_TAGS);
+
+      // Invalidate the line in L1 Cache
+      invalidateCacheLineInL1(l2_cache_line_info.getCachedLoc(), address);
+
+      // Write-back the line
+      Byte data_buf[getCacheLineSize()];
+      readCacheLine(address, data_buf);
+
+      // Invalidate the line
+      invalidateCacheLine(address, l2_cache_line_info);
+
+      // Send FLUSH_REP to DRAM_DIRECTORY
+      ShmemMsg msg(ShmemMsg::FLUSH_REP, MemComponent::L2_CACHE, MemComponent::DRAM_DIRECTORY, shmem_msg->getRequester(), address,
+                   data_buf, getCacheLineSize(), shmem_msg->isModeled());
+      getMemoryManager()->sendMsg(sender, msg);
+   }
+   else
+   {
+      // Update Shared Mem perf counters for access to L2 Cache
+      getMemoryManager()->incrCycleCount(MemComponent::L2_CACHE, CachePerfModel::ACCESS_CACHE_TAGS);
+   }
+}
+
+void
+L2CacheCntlr::processWbReqFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg)
+{
+   IntPtr address = shmem_msg->getAddress();
+
+   PrL2CacheLineInfo l2_cache_line_info;
+   _l2_cache->getCacheLineInfo(address, &l2_cache_line_info);
+   CacheState::Type cstate = l2_cache_line_info.getCState();
+
+   if (cstate != CacheState::INVALID)
+   {
+      assert((cstate == CacheState::MODIFIED) || (cstate == CacheState::EXCLUSIVE));
+ 
+      // Update Shared Mem perf counters for access to L2 Cache
+      getMemoryManager()->incrCycleCount(MemComponent::L2_CACHE, CachePerfModel::ACCESS_CACHE_DATA_AND_TAGS);
+      // Update Shared Mem perf counters for access to L1 Cache
+      getMemoryManager()->incrCycleCount(l2_cache_line_info.getCachedLoc(), CachePerfModel::ACCESS_CACHE_TAGS);
+
+      // Set the Appropriate Cache State in L1 also
+      setCacheLineStateInL1(l2_cache_line_info.getCachedLoc(), address, CacheState::SHARED);
+
+      // Write-Back the line
+      Byte data_buf[getCacheLineSize()];
+      readCacheLine(address, data_buf);
+      
+      // Set the cache line state to SHARED
+      l2_cache_line_info.setCState(CacheState::SHARED);
+      _l2_cache->setCacheLineInfo(address, &l2_cache_line_info);
+
+      // Send WB_REP to DRAM_DIRECTORY
+      ShmemMsg msg(ShmemMsg::WB_REP, MemComponent::L2_CACHE, MemComponent::DRAM_DIRECTORY, shmem_msg->getRequester(), address,
+                   data_buf, getCacheLineSize(), shmem_msg->isModeled());
+      getMemoryManager()->sendMsg(sender, msg);
+   }
+   else
+   {
+      // Update Shared Mem perf counters for access to L2 Cache
+      getMemoryManager()->incrCycleCount(MemComponent::L2_CACHE, CachePerfModel::ACCESS_CACHE_TAGS);
+   }
+}
+
+void
+L2CacheCntlr::outputSummary(ostream& out)
+{
+   out << "    L2 Cache Cntlr: " << endl;
+   out << "      Exclusive Grants: " << _total_exclusive_grants << endl;
+   out << "      Silent Upgrades: " << _total_silent_upgrades << endl;
+   // Under MSI, each of these would have cost an INV_REP, an EX_REQ and an EX_REP
+   out << "      Upgrade Messages Saved: " << 3 * _total_silent_upgrades << endl;
+
+   if (_l2_cache_prefetcher)
+      _l2_cache_prefetcher->outputSummary(out);
+}
+
+pair<bool,Cache::MissType>
+L2CacheCntlr::operationPermissibleinL2Cache(Core::mem_op_t mem_op_type, IntPtr address, CacheState::Type cstate)
+{
+   bool cache_hit = false;
+
+   switch (mem_op_type)
+   {
+   case Core::READ:
+      cache_hit = CacheState(cstate).readable();
+      break;
+
+   case Core::READ_EX:
+   case Core::WRITE:
+      cache_hit = CacheState(cstate).writable();
+      break;
+
+   default:
+      LOG_PRINT_ERROR("Unsupported Mem Op Type(%u)", mem_op_type);
+      break;
+   }
+
+   Cache::MissType cache_miss_type = _l2_cache->updateMissCounters(address, mem_op_type, !cache_hit);
+   return make_pair(!cache_hit, cache_miss_type);
+}
+
+tile_id_t
+L2CacheCntlr::getTileId()
+{
+   return _memory_manager->getTile()->getId();
+}
+
+UInt32
+L2CacheCntlr::getCacheLineSize()
+{ 
+   return _memory_manager->getCacheLineSize();
+}
+ 
+ShmemPerfModel*
+L2CacheCntlr::getShmemPerfModel()
+{ 
+   return _memory_manager->getShmemPerfModel();
+}
+
+}
@@ -0,0 +1,725 @@
+#include <cstring>
+#include <cmath>
+
+#include "memory_manager.h"
+#include "cache.h"
+#include "simulator.h"
+#include "tile_manager.h"
+#include "clock_converter.h"
+#include "utils.h"
+#include "log.h"
+
+namespace PrL1PrL2DramDirectoryMESI
+{
+
+// Static variables
+ofstream MemoryManager::_cache_line_replication_file;
+
+MemoryManager::MemoryManager(Tile* tile, Network* network, ShmemPerfModel* shmem_perf_model)
+   : ::MemoryManager(tile, network, shmem_perf_model)
+   , _dram_directory_cntlr(NULL)
+   , _dram_cntlr(NULL)
+   , _dram_cntlr_present(false)
+   , _sim_thread_holds_lock(false)
+   , _enabled(false)
+{
+   // Read Parameters from the Config file
+   std::string l1_icache_type;
+   UInt32 l1_icache_line_size = 0;
+   UInt32 l1_icache_size = 0;
+   UInt32 l1_icache_associativity = 0;
+   std::string l1_icache_replacement_policy;
+   UInt32 l1_icache_data_access_time = 0;
+   UInt32 l1_icache_tags_access_time = 0;
+   std::string l1_icache_perf_model_type;
+   bool l1_icache_track_miss_types = false;
+
+   std::string l1_dcache_type;
+   UInt32 l1_dcache_line_size = 0;
+   UInt32 l1_dcache_size = 0;
+   UInt32 l1_dcache_associativity = 0;
+   std::string l1_dcache_replacement_policy;
+   UInt32 l1_dcache_data_access_time = 0;
+   UInt32 l1_dcache_tags_access_time = 0;
+   std::string l1_dcache_perf_model_type;
+   bool l1_dcache_track_miss_types = false;
+   UInt32 l1_dcache_num_mshrs = 0;
+
+   std::string l2_cache_type;
+   UInt32 l2_cache_line_size = 0;
+   UInt32 l2_cache_size = 0;
+   UInt32 l2_cache_associativity = 0;
+   std::string l2_cache_replacement_policy;
+   UInt32 l2_cache_data_access_time = 0;
+   UInt32 l2_cache_tags_access_time = 0;
+   std::string l2_cache_perf_model_type;
+   bool l2_cache_track_miss_types = false;
+   std::string l2_cache_prefetcher_type;
+   UInt32 l2_cache_prefetcher_degree = 0;
+   UInt32 l2_cache_prefetcher_table_size = 0;
+
+   std::string dram_directory_total_entries_str;
+   UInt32 dram_directory_associativity = 0;
+   UInt32 dram_directory_max_num_sharers = 0;
+   UInt32 dram_directory_max_hw_sharers = 0;
+   std::string dram_directory_type_str;
+   UInt32 dram_directory_home_lookup_param = 0;
+   std::string dram_directory_access_time_str;
+   std::string dram_directory_home_interleaving_str;
+
+   volatile float dram_latency = 0.0;
+   volatile float per_dram_controller_bandwidth = 0.0;
+   bool dram_queue_model_enabled = false;
+   std::string dram_queue_model_type;
+
+   std::string directory_type;
+
+   try
+   {
+      // L1 ICache
+      l1_icache_type = "l1_icache/" + Config::getSingleton()->getL1ICacheType(getTile()->getId());
+      l1_icache_line_size = Sim()->getCfg()->getInt(l1_icache_type + "/cache_line_size");
+      l1_icache_size = Sim()->getCfg()->getInt(l1_icache_type + "/cache_size");
+      l1_icache_associativity = Sim()->getCfg()->getInt(l1_icache_type + "/associativity");
+      l1_icache_replacement_policy = Sim()->getCfg()->getString(l1_icache_type + "/replacement_policy");
+      l1_icache_data_access_time = Sim()->getCfg()->getInt(l1_icache_type + "/data_access_time");
+      l1_icache_tags_access_time = Sim()->getCfg()->getInt(l1_icache_type + "/tags_access_time");
+      l1_icache_perf_model_type = Sim()->getCfg()->getString(l1_icache_type + "/perf_model_type");
+      l1_icache_track_miss_types = Sim()->getCfg()->getBool(l1_icache_type + "/track_miss_types");
+
+      // L1 DCache
+      l1_dcache_type = "l1_dcache/" + Config::getSingleton()->getL1DCacheType(getTile()->getId());
+      l1_dcache_line_size = Sim()->getCfg()->getInt(l1_dcache_type + "/cache_line_size");
+      l1_dcache_size = Sim()->getCfg()->getInt(l1_dcache_type + "/cache_size");
+      l1_dcache_associativity = Sim()->getCfg()->getInt(l1_dcache_type + "/associativity");
+      l1_dcache_replacement_policy = Sim()->getCfg()->getString(l1_dcache_type + "/replacement_policy");
+      l1_dcache_data_access_time = Sim()->getCfg()->getInt(l1_dcache_type + "/data_access_time");
+      l1_dcache_tags_access_time = Sim()->getCfg()->getInt(l1_dcache_type + "/tags_access_time");
+      l1_dcache_perf_model_type = Sim()->getCfg()->getString(l1_dcache_type + "/perf_model_type");
+      l1_dcache_track_miss_types = Sim()->getCfg()->getBool(l1_dcache_type + "/track_miss_types");
+      l1_dcache_num_mshrs = Sim()->getCfg()->getInt(l1_dcache_type + "/num_mshrs");
+
+      // L2 Cache
+      l2_cache_type = "l2_cache/" + Config::getSingleton()->getL2CacheType(getTile()->getId());
+      l2_cache_line_size = Sim()->getCfg()->getInt(l2_cache_type + "/cache_line_size");
+      l2_cache_size = Sim()->getCfg()->getInt(l2_cache_type + "/cache_size");
+      l2_cache_associativity = Sim()->getCfg()->getInt(l2_cache_type + "/associativity");
+      l2_cache_replacement_policy = Sim()->getCfg()->getString(l2_cache_type + "/replacement_policy");
+      l2_cache_data_access_time = Sim()->getCfg()->getInt(l2_cache_type + "/data_access_time");
+      l2_cache_tags_access_time = Sim()->getCfg()->getInt(l2_cache_type + "/tags_access_time");
+      l2_cache_perf_model_type = Sim()->getCfg()->getString(l2_cache_type + "/perf_model_type");
+      l2_cache_track_miss_types = Sim()->getCfg()->getBool(l2_cache_type + "/track_miss_types");
+      l2_cache_prefetcher_type = Sim()->getCfg()->getString(l2_cache_type + "/prefetcher", "none");
+      l2_cache_prefetcher_degree = Sim()->getCfg()->getInt(l2_cache_type + "/prefetcher_degree", 2);
+      l2_cache_prefetcher_table_size = Sim()->getCfg()->getInt(l2_cache_type + "/prefetcher_table_size", 16);
+
+      // Dram Directory Cache
+      dram_directory_total_entries_str = Sim()->getCfg()->getString("dram_directory/total_entries");
+      dram_directory_associativity = Sim()->getCfg()->getInt("dram_directory/associativity");
+      dram_directory_max_num_sharers = Sim()->getConfig()->getTotalTiles();
+      dram_directory_max_hw_sharers = Sim()->getCfg()->getInt("dram_directory/max_hw_sharers");
+      dram_directory_type_str = Sim()->getCfg()->getString("dram_directory/directory_type");
+      dram_directory_access_time_str = Sim()->getCfg()->getString("dram_directory/access_time");
+      dram_directory_home_interleaving_str = Sim()->getCfg()->getString("dram_directory/home_interleaving", "line");
+
+      // Dram Cntlr
+      dram_latency = Sim()->getCfg()->getFloat("dram/latency");
+      per_dram_controller_bandwidth = Sim()->getCfg()->getFloat("dram/per_controller_bandwidth");
+      dram_queue_model_enabled = Sim()->getCfg()->getBool("dram/queue_model/enabled");
+      dram_queue_model_type = Sim()->getCfg()->getString("dram/queue_model/type");
+
+      // Directory Type
+      directory_type = Sim()->getCfg()->getString("dram_directory/directory_type");
+   }
+   catch(...)
+   {
+      LOG_PRINT_ERROR("Error reading memory system parameters from the config file");
+   }
+
+   if (getTile()->getId() == 0)
+   {
+      LOG_ASSERT_ERROR(directory_type != "limited_broadcast",
+            "Limited Broadcast directory scheme CANNOT be used with the MESI protocol.");
+   }
+
+   // Check if all cache line sizes are the same
+   LOG_ASSERT_ERROR((l1_icache_line_size == l1_dcache_line_size) && (l1_dcache_line_size == l2_cache_line_size),
+      "Cache Line Sizes of L1-I, L1-D and L2 Caches must be the same. "
+      "Currently, L1-I Cache Line Size(%u), L1-D Cache Line Size(%u), L2 Cache Line Size(%u)",
+      l1_icache_line_size, l1_dcache_line_size, l2_cache_line_size);
+   
+   _cache_line_size = l1_icache_line_size;
+
+   // Msgs are encoded as the ShmemMsg followed by at most one cache line
+   _msg_buf_size = sizeof(ShmemMsg) + _cache_line_size;
+   _send_msg_buf = new Byte[_msg_buf_size];
+
+   dram_directory_home_lookup_param = AddressHomeLookup::parseInterleavingGranularity(dram_directory_home_interleaving_str, _cache_line_size);
+
+   float core_frequency = Config::getSingleton()->getCoreFrequency(Tile::getMainCoreId(getTile()->getId()));
+  
+   std::vector<tile_id_t> tile_list_with_memory_controllers = getTileListWithMemoryControllers();
+   UInt32 num_memory_controllers = tile_list_with_memory_controllers.size();
+   _dram_directory_home_lookup = new AddressHomeLookup(dram_directory_home_lookup_param, tile_list_with_memory_controllers, getCacheLineSize());
+   LOG_PRINT("Instantiated Dram Directory Home Lookup");
+
+   if (find(tile_list_with_memory_controllers.begin(), tile_list_with_memory_controllers.end(), getTile()->getId())
+         != tile_list_with_memory_controllers.end())
+   {
+      _dram_cntlr_present = true;
+
+      _dram_cntlr = new DramCntlr(getTile(),
+            _dram_directory_home_lookup,
+            dram_latency,
+            per_dram_controller_bandwidth,
+            dram_queue_model_enabled,
+            dram_queue_model_type,
+            getCacheLineSize());
+
+      LOG_PRINT("Instantiated Dram Cntlr");
+
+      _dram_directory_cntlr = new DramDirectoryCntlr(this,
+            _dram_cntlr,
+            dram_directory_total_entries_str,
+            dram_directory_associativity,
+            getCacheLineSize(),
+            dram_directory_max_num_sharers,
+            dram_directory_max_hw_sharers,
+            dram_directory_type_str,
+            dram_directory_access_time_str,
+            num_memory_controllers);
+      
+      LOG_PRINT("Instantiated Dram Directory Cntlr");
+   }
+
+   _l1_cache_cntlr = new L1CacheCntlr(this,
+         getCacheLineSize(),
+         l1_icache_size,
+         l1_icache_associativity,
+         l1_icache_replacement_policy,
+         l1_icache_data_access_time,
+         l1_icache_track_miss_types,
+         l1_dcache_size,
+         l1_dcache_associativity,
+         l1_dcache_replacement_policy,
+         l1_dcache_data_access_time,
+         l1_dcache_track_miss_types,
+         l1_dcache_num_mshrs,
+         core_frequency);
+   
+   LOG_PRINT("Instantiated L1 Cache Cntlr");
+
+   _l2_cache_cntlr = new L2CacheCntlr(this,
+         _l1_cache_cntlr,
+         _dram_directory_home_lookup,
+         getCacheLineSize(),
+         l2_cache_size,
+         l2_cache_associativity,
+         l2_cache_replacement_policy,
+         l2_cache_data_access_time,
+         l2_cache_track_miss_types,
+         l2_cache_prefetcher_type,
+         l2_cache_prefetcher_degree,
+         l2_cache_prefetcher_table_size,
+         core_frequency);
+
+   LOG_PRINT("Instantiated L2 Cache Cntlr");
+
+   _l1_cache_cntlr->setL2CacheCntlr(_l2_cache_cntlr);
+
+   // Create Cache Performance Models
+   _l1_icache_perf_model = CachePerfModel::create(l1_icache_perf_model_type,
+         l1_icache_data_access_time, l1_icache_tags_access_time, core_frequency);
+   _l1_dcache_perf_model = CachePerfModel::create(l1_dcache_perf_model_type,
+         l1_dcache_data_access_time, l1_dcache_tags_access_time, core_frequency);
+   _l2_cache_perf_model = CachePerfModel::create(l2_cache_perf_model_type,
+         l2_cache_data_access_time, l2_cache_tags_access_time, core_frequency);
+
+   LOG_PRINT("Instantiated Cache Performance Models");
+
+   // Register Call-backs
+   getNetwork()->registerCallback(SHARED_MEM_1, MemoryManagerNetworkCallback, this);
+   getNetwork()->registerCallback(SHARED_MEM_2, MemoryManagerNetworkCallback, this);
+}
+
+MemoryManager::~MemoryManager()
+{
+   getNetwork()->unregisterCallback(SHARED_MEM_1);
+   getNetwork()->unregisterCallback(SHARED_MEM_2);
+
+   // Delete the Models
+   delete _l1_icache_perf_model;
+   delete _l1_dcache_perf_model;
+   delete _l2_cache_perf_model;
+
+   delete _dram_directory_home_lookup;
+   delete _l1_cache_cntlr;
+   delete _l2_cache_cntlr;
+   if (_dram_cntlr_present)
+   {
+      delete _dram_cntlr;
+      delete _dram_directory_cntlr;
+   }
+
+   delete [] _send_msg_buf;
+   for (std::vector<Byte*>::iterator it = _free_msg_buf_list.begin(); it != _free_msg_buf_list.end(); it++)
+      delete [] (*it);
+}
+
+bool
+MemoryManager::coreInitiateMemoryAccess(MemComponent::Type mem_component,
+                                        Core::lock_signal_t lock_signal,
+                                        Core::mem_op_t mem_op_type,
+                                        IntPtr address, UInt32 offset,
+                                        Byte* data_buf, UInt32 data_length,
+                                        UInt64& curr_time, bool modeled)
+{
+   if (lock_signal != Core::UNLOCK)
+      _lock.acquire();
+  
+   getShmemPerfModel()->setCycleCount(curr_time);
+
+   bool ret = _l1_cache_cntlr->processMemOpFromTile(mem_component, lock_signal, mem_op_type, 
+                                                    address, offset, data_buf, data_length, modeled);
+
+   curr_time = getShmemPerfModel()->getCycleCount();
+
+   if (lock_signal != Core::LOCK)
+      _lock.release();
+
+   return ret;
+}
+
+void
+MemoryManager::handleMsgFromNetwork(NetPacket& packet)
+{
+   ShmemMsg* shmem_msg = ShmemMsg::getShmemMsg((Byte*) packet.data);
+
+   _lock.acquire();
+   _sim_thread_holds_lock = true;
+
+   handleMsg(packet.sender, packet.receiver, shmem_msg, packet.time);
+
+   // Msgs this tile sent to itself while handling the above
+   while (!_local_msg_queue.empty())
+   {
+      LocalMsg local_msg = _local_msg_queue.front();
+      _local_msg_queue.pop();
+      core_id_t tile_core_id = Tile::getMainCoreId(getTile()->getId());
+      handleMsg(tile_core_id, tile_core_id, ShmemMsg::getShmemMsg(local_msg.second), local_msg.first);
+      releaseMsgBuf(local_msg.second);
+   }
+
+   _sim_thread_holds_lock = false;
+   _lock.release();
+}
+
+void
+MemoryManager::handleMsg(core_id_t sender, core_id_t receiver, ShmemMsg* shmem_msg, UInt64 msg_time)
+{
+   MemComponent::Type receiver_mem_component = shmem_msg->getReceiverMemComponent();
+   MemComponent::Type sender_mem_component = shmem_msg->getSenderMemComponent();
+
+   getShmemPerfModel()->setCycleCount(msg_time);
+
+   if (_enabled)
+   {
+      LOG_PRINT("Got Shmem Msg: type(%i), address(0x%x), sender_mem_component(%u), receiver_mem_component(%u), sender(%i,%i), receiver(%i,%i)", 
+            shmem_msg->getType(), shmem_msg->getAddress(), sender_mem_component, receiver_mem_component, sender.tile_id, sender.core_type, receiver.tile_id, receiver.core_type);    
+   }
+
+   switch (receiver_mem_component)
+   {
+   case MemComponent::L2_CACHE:
+      switch(sender_mem_component)
+      {
+         case MemComponent::L1_ICACHE:
+         case MemComponent::L1_DCACHE:
+            assert(sender.tile_id == getTile()->getId());
+            _l2_cache_cntlr->handleMsgFromL1Cache(shmem_msg);
+            break;
+
+         case MemComponent::DRAM_DIRECTORY:
+            _l2_cache_cntlr->handleMsgFromDramDirectory(sender.tile_id, shmem_msg);
+            break;
+
+         default:
+            LOG_PRINT_ERROR("Unrecognized sender component(%u)",
+                  sender_mem_component);
+            break;
+      }
+      break;
+
+   case MemComponent::DRAM_DIRECTORY:
+      switch(sender_mem_component)
+      {
+         LOG_ASSERT_ERROR(_dram_cntlr_present, "Dram Cntlr NOT present");
+
+         case MemComponent::L2_CACHE:
+            _dram_directory_cntlr->handleMsgFromL2Cache(sender.tile_id, shmem_msg);
+            break;
+
+         default:
+            LOG_PRINT_ERROR("Unrecognized sender component(%u)",
+                  sender_mem_component);
+            break;
+      }
+      break;
+
+   default:
+      LOG_PRINT_ERROR("Unrecognized receiver component(%u)",
+            receiver_mem_component);
+      break;
+   }
+}
+
+void
+MemoryManager::sendMsg(tile_id_t receiver, ShmemMsg& shmem_msg)
+{
+   assert((shmem_msg.getDataBuf() == NULL) == (shmem_msg.getDataLength() == 0));
+
+   UInt64 msg_time = getShmemPerfModel()->getCycleCount();
+
+   if (_enabled)
+   {
+      LOG_PRINT("Sending Msg: type(%u), address(%#llx), sender_mem_component(%u), receiver_mem_component(%u), requester(%i), sender(%i), receiver(%i)",
+                shmem_msg.getType(), shmem_msg.getAddress(), shmem_msg.getSenderMemComponent(), shmem_msg.getReceiverMemComponent(),
+                shmem_msg.getRequester(), getTile()->getId(), receiver);
+   }
+
+   if ( (receiver == getTile()->getId()) && _sim_thread_holds_lock )
+   {
+      sendLocalMsg(SHARED_MEM_1, shmem_msg, msg_time);
+      return;
+   }
+
+   shmem_msg.makeMsgBuf(_send_msg_buf);
+   NetPacket packet(msg_time, SHARED_MEM_1,
+         getTile()->getId(), receiver,
+         shmem_msg.getMsgLen(), (const void*) _send_msg_buf);
+   getNetwork()->netSend(packet);
+}
+
+void
+MemoryManager::sendLocalMsg(PacketType packet_type, ShmemMsg& shmem_msg, UInt64 msg_time)
+{
+   // The receiver is this tile's sim thread, i.e., the caller. Queue the
+   // encoded msg for handleMsgFromNetwork() instead of going through the transport layer
+   Byte* msg_buf = allocateMsgBuf();
+   shmem_msg.makeMsgBuf(msg_buf);
+
+   // Charge the latency the network model assigns to a packet sent to self
+   NetPacket packet(msg_time, packet_type,
+         getTile()->getId(), getTile()->getId(),
+         shmem_msg.getMsgLen(), (const void*) msg_buf);
+   getNetwork()->modelLocalDelivery(packet);
+
+   _local_msg_queue.push(LocalMsg(packet.time, msg_buf));
+}
+
+Byte*
+MemoryManager::allocateMsgBuf()
+{
+   if (_free_msg_buf_list.empty())
+      return new Byte[_msg_buf_size];
+
+   Byte* msg_buf = _free_msg_buf_list.back();
+   _free_msg_buf_list.pop_back();
+   return msg_buf;
+}
+
+void
+MemoryManager::releaseMsgBuf(Byte* msg_buf)
+{
+   _free_msg_buf_list.push_back(msg_buf);
+}
+
+void
+MemoryManager::broadcastMsg(ShmemMsg& shmem_msg)
+{
+   assert((shmem_msg.getDataBuf() == NULL) == (shmem_msg.getDataLength() == 0));
+
+   shmem_msg.makeMsgBuf(_send_msg_buf);
+   UInt64 msg_time = getShmemPerfModel()->getCycleCount();
+
+   if (_enabled)
+   {
+      LOG_PRINT("Broadcasting Msg: type(%u), address(%#llx), sender_mem_component(%u), receiver_mem_component(%u), requester(%i), sender(%i)",
+                shmem_msg.getType(), shmem_msg.getAddress(), shmem_msg.getSenderMemComponent(), shmem_msg.getReceiverMemComponent(),
+                shmem_msg.getRequester(), getTile()->getId());
+   }
+
+   NetPacket packet(msg_time, SHARED_MEM_1,
+         getTile()->getId(), NetPacket::BROADCAST,
+         shmem_msg.getMsgLen(), (const void*) _send_msg_buf);
+   getNetwork()->netSend(packet);
+}
+
+void
+MemoryManager::incrCycleCount(MemComponent::Type mem_component, CachePerfModel::CacheAccess_t access_type)
+{
+   switch (mem_component)
+   {
+      case MemComponent::L1_ICACHE:
+         getShmemPerfModel()->incrCycleCount(_l1_icache_perf_model->getLatency(access_type));
+         break;
+
+      case MemComponent::L1_DCACHE:
+         getShmemPerfModel()->incrCycleCount(_l1_dcache_perf_model->getLatency(access_type));
+         break;
+
+      case MemComponent::L2_CACHE:
+         getShmemPerfModel()->incrCycleCount(_l2_cache_perf_model->getLatency(access_type));
+         break;
+
+      case MemComponent::INVALID:
+         break;
+
+      default:
+         LOG_PRINT_ERROR("Unrecognized mem component type(%u)", mem_component);
+         break;
+   }
+}
+
+void
+MemoryManager::enableModels()
+{
+   LOG_PRINT("enableModels() start");
+   _enabled = true;
+
+   _l1_cache_cntlr->getL1ICache()->enable();
+   _l1_icache_perf_model->enable();
+   
+   _l1_cache_cntlr->getL1DCache()->enable();
+   _l1_dcache_perf_model->enable();
+   
+   _l2_cache_cntlr->getL2Cache()->enable();
+   _l2_cache_perf_model->enable();
+
+   if (_dram_cntlr_present)
+   {
+      _dram_directory_cntlr->getDramDirectoryCache()->enable();
+      _dram_cntlr->getDramPerfModel()->enable();
+   }
+   LOG_PRINT("enableModels() end");
+}
+
+void
+MemoryManager::disableModels()
+{
+   LOG_PRINT("disableModels() start");
+   _enabled = false;
+
+   _l1_cache_cntlr->getL1ICache()->disable();
+   _l1_icache_perf_model->disable();
+
+   _l1_cache_cntlr->getL1DCache()->disable();
+   _l1_dcache_perf_model->disable();
+
+   _l2_cache_cntlr->getL2Cache()->disable();
+   _l2_cache_perf_model->disable();
+
+   if (_dram_cntlr_present)
+   {
+      _dram_directory_cntlr->getDramDirectoryCache()->disable();
+      _dram_cntlr->getDramPerfModel()->disable();
+   }
+   LOG_PRINT("disableModels() end");
+}
+
+void
+MemoryManager::outputSummary(std::ostream &os)
+{
+   os << "Cache Summary:\n";
+   _l1_cache_cntlr->getL1ICache()->outputSummary(os);
+   _l1_cache_cntlr->getL1DCache()->outputSummary(os);
+   _l1_cache_cntlr->getL1DCacheMSHR()->outputSummary(os);
+   _l2_cache_cntlr->getL2Cache()->outputSummary(os);
+   _l2_cache_cntlr->outputSummary(os);
+
+   if (_dram_cntlr_present)
+   {      
+      _dram_cntlr->outputSummary(os);
+      os << "Dram Directory Cache Summary:\n";
+      _dram_directory_cntlr->getDramDirectoryCache()->outputSummary(os);
+   }
+   else
+   {
+      DramCntlr::dummyOutputSummary(os);
+      os << "Dram Directory Cache Summary:\n";
+      DirectoryCache::dummyOutputSummary(os, getTile()->getId());
+   }
+
+   os << "Thread Handoff Summary:\n";
+   _app_thread_sem.outputSummary(os, "App Thread");
+   _sim_thread_sem.outputSummary(os, "Sim Thread");
+}
+
+void
+MemoryManager::waitForAppThread()
+{
+   _sim_thread_sem.wait();
+   _lock.acquire();
+   _sim_thread_holds_lock = true;
+}
+
+void
+MemoryManager::wakeUpAppThread()
+{
+   _sim_thread_holds_lock = false;
+   _lock.release();
+   _app_thread_sem.signal();
+}
+
+void
+MemoryManager::waitForSimThread()
+{
+   _lock.release();
+   _app_thread_sem.wait();
+}
+
+void
+MemoryManager::wakeUpSimThread()
+{
+   _lock.acquire();
+   _sim_thread_sem.signal();
+}
+
+void
+MemoryManager::openCacheLineReplicationTraceFiles()
+{
+   string output_dir;
+   try
+   {
+      output_dir = Sim()->getCfg()->getString("general/output_dir");
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read general/output_dir from the cfg file");
+   }
+
+   string filename = output_dir + "/cache_line_replication.dat";
+   _cache_line_replication_file.open(filename.c_str());
+}
+
+void
+MemoryManager::closeCacheLineReplicationTraceFiles()
+{
+   _cache_line_replication_file.close();
+}
+
+void
+MemoryManager::outputCacheLineReplicationSummary()
+{
+   // Static Function to Compute the Time Varying Replication Index of a Cache Line
+   // Go through the set of all caches and directories and get the
+   // number of times each cache line is replicated
+
+   SInt32 total_tiles = (SInt32) Config::getSingleton()->getTotalTiles();
+   
+   UInt64 total_exclusive_lines_l1_cache = 0;
+   UInt64 total_shared_lines_l1_cache = 0;
+   UInt64 total_exclusive_lines_l2_cache = 0;
+   UInt64 total_shared_lines_l2_cache = 0;
+   UInt64 total_cache_lines_l2_cache = 0;
+   vector<UInt64> total_cache_line_sharer_count(total_tiles+1, 0);
+   
+   for (SInt32 tile_id = 0; tile_id < total_tiles; tile_id ++)
+   {
+      // Tile Ptr
+      Tile* tile = Sim()->getTileManager()->getTileFromID(tile_id);
+      assert(tile);
+      MemoryManager* memory_manager = (MemoryManager*) tile->getMemoryManager();
+      Cache* l1_icache = memory_manager->getL1ICache();
+      Cache* l1_dcache = memory_manager->getL1DCache();
+      Cache* l2_cache = memory_manager->getL2Cache();
+      Directory* directory = (Directory*) NULL;
+      if (memory_manager->isDramCntlrPresent())
+         directory = memory_manager->getDramDirectoryCache()->getDirectory();
+   
+      // Get total lines in L1 caches & L2 cache
+      vector<UInt64> _l1_icache_line_state_counters;
+      vector<UInt64> _l1_dcache_line_state_counters;
+      vector<UInt64> _l2_cache_line_state_counters;
+      l1_icache->getCacheLineStateCounters(_l1_icache_line_state_counters);
+      l1_dcache->getCacheLineStateCounters(_l1_dcache_line_state_counters);
+      l2_cache->getCacheLineStateCounters(_l2_cache_line_state_counters);
+
+      UInt64 num_exclusive_lines_l1_icache = _l1_icache_line_state_counters[CacheState::MODIFIED] +
+                                        _l1_icache_line_state_counters[CacheState::EXCLUSIVE];
+      UInt64 num_shared_lines_l1_icache = _l1_icache_line_state_counters[CacheState::SHARED];
+      UInt64 num_exclusive_lines_l1_dcache = _l1_dcache_line_state_counters[CacheState::MODIFIED] +
+                                        _l1_dcache_line_state_counters[CacheState::EXCLUSIVE];
+      UInt64 num_shared_lines_l1_dcache = _l1_dcache_line_state_counters[CacheState::SHARED];
+      UInt64 num_exclusive_lines_l2_cache = _l2_cache_line_state_counters[CacheState::MODIFIED] +
+                                        _l2_cache_line_state_counters[CacheState::EXCLUSIVE];
+      UInt64 num_shared_lines_l2_cache = _l2_cache_line_state_counters[CacheState::SHARED];
+
+      // Get total
+      total_exclusive_lines_l1_cache += (num_exclusive_lines_l1_icache + num_exclusive_lines_l1_dcache);
+      total_shared_lines_l1_cache += (num_shared_lines_l1_icache + num_shared_lines_l1_dcache);
+      total_exclusive_lines_l2_cache += num_exclusive_lines_l2_cache;
+      total_shared_lines_l2_cache += num_shared_lines_l2_cache;
+
+      if (directory)
+      {
+         vector<UInt64> cache_line_sharer_count;
+         directory->getSharerStats(cache_line_sharer_count);
+         for (SInt32 num_sharers = 1; num_sharers <= total_tiles; num_sharers ++)
+         {
+            total_cache_line_sharer_count[num_sharers] += cache_line_sharer_count[num_sharers];
+            total_cache_lines_l2_cache += cache_line_sharer_count[num_sharers];
+         }
+      }
+   }
+
+   // Write to file
+   // L1 cache, L2 cache
+   _cache_line_replication_file << total_exclusive_lines_l1_cache << ", " << total_shared_lines_l1_cache << ", " << endl;
+   _cache_line_replication_file << total_exclusive_lines_l2_cache << ", " << total_shared_lines_l2_cache << ", " << endl;
+   for (SInt32 i = 1; i <= total_tiles; i++)
+      _cache_line_replication_file << total_cache_line_sharer_count[i] << ", ";
+   _cache_line_replication_file << endl;
+   
+   // Replication count
+   // For Pr L1, Pr L2 configuration
+   vector<UInt64> total_cache_line_replication_count(2*total_tiles+1, 0);
+   
+   // Account for exclusive lines first
+   // For Pr L1, Pr L2 configuration
+   total_cache_line_replication_count[1] += (total_exclusive_lines_l2_cache - total_exclusive_lines_l1_cache);
+   total_cache_line_replication_count[2] += total_exclusive_lines_l1_cache;
+   
+   // Subtract out the exclusive lines 
+   total_cache_line_sharer_count[1] -= total_exclusive_lines_l2_cache;
+
+   double shared_lines_ratio = 1.0 * total_shared_lines_l1_cache / total_shared_lines_l2_cache;
+   
+   // Accout for shared lines next
+   for (SInt32 num_sharers = 1; num_sharers <= total_tiles; num_sharers ++)
+   {
+      UInt64 num_cache_lines = total_cache_line_sharer_count[num_sharers];
+      SInt32 degree_l2 = num_sharers;
+      double degree_l1 = shared_lines_ratio * degree_l2;
+      
+      // Some lines are replicated in floor(degree_l1) L1 cache slices
+      // while some lines are replicated in ceil(degree_l1) L1 cache caches
+      UInt64 num_low = (UInt64) (num_cache_lines * (ceil(degree_l1) - degree_l1));
+      SInt32 degree_low = (SInt32) floor(degree_l1);
+      UInt64 num_high = num_cache_lines - num_low;
+      SInt32 degree_high = (SInt32) ceil(degree_l1);
+
+      // Approximate For Pr L1, Pr L2 configuration
+      total_cache_line_replication_count[num_sharers + degree_low] += num_low;
+      total_cache_line_replication_count[num_sharers + degree_high] += num_high;
+   }
+
+   // For Pr L1, Pr L2 configuration
+   for (SInt32 i = 1; i <= (2*total_tiles); i++)
+      _cache_line_replication_file << total_cache_line_replication_count[i] << ", ";
+   _cache_line_replication_file << endl;
+
+   _cache_line_replication_file << endl;
+}
+
+}
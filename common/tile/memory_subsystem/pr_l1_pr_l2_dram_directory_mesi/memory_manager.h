@@ -0,0 +1,118 @@
+#pragma once
+
+#include <queue>
+#include <vector>
+
+#include "../memory_manager.h"
+#include "cache.h"
+#include "l1_cache_cntlr.h"
+#include "l2_cache_cntlr.h"
+#include "dram_directory_cntlr.h"
+#include "dram_cntlr.h"
+#include "address_home_lookup.h"
+#include "shmem_msg.h"
+#include "mem_component.h"
+#include "adaptive_semaphore.h"
+#include "fixed_types.h"
+#include "shmem_perf_model.h"
+
+namespace PrL1PrL2DramDirectoryMESI
+{
+   class MemoryManager : public ::MemoryManager
+   {
+   public:
+      MemoryManager(Tile* tile, Network* network, ShmemPerfModel* shmem_perf_model);
+      ~MemoryManager();
+
+      UInt32 getCacheLineSize() { return _cache_line_size; }
+
+      Cache* getL1ICache() { return _l1_cache_cntlr->getL1ICache(); }
+      UInt64 getL1ICacheHitLatency() { return _l1_icache_perf_model->getLatency(CachePerfModel::ACCESS_CACHE_DATA_AND_TAGS); }
+      Cache* getL1DCache() { return _l1_cache_cntlr->getL1DCache(); }
+      Cache* getL2Cache() { return _l2_cache_cntlr->getL2Cache(); }
+      DirectoryCache* getDramDirectoryCache() { return _dram_directory_cntlr->getDramDirectoryCache(); }
+      DramCntlr* getDramCntlr() { return _dram_cntlr; }
+      bool isDramCntlrPresent() { return _dram_cntlr_present; }
+      AddressHomeLookup* getDramDirectoryHomeLookup() { return _dram_directory_home_lookup; }
+
+      bool coreInitiateMemoryAccess(MemComponent::Type mem_component,
+                                    Core::lock_signal_t lock_signal, Core::mem_op_t mem_op_type,
+                                    IntPtr address, UInt32 offset, Byte* data_buf, UInt32 data_length,
+                                    UInt64& curr_time, bool modeled);
+
+      void handleMsgFromNetwork(NetPacket& packet);
+
+      // Send/Broadcast msg
+      void sendMsg(tile_id_t receiver, ShmemMsg& msg);
+      void broadcastMsg(ShmemMsg& msg);
+     
+      void enableModels();
+      void disableModels();
+
+      tile_id_t getShmemRequester(const void* pkt_data)
+      { return ((ShmemMsg*) pkt_data)->getRequester(); }
+      UInt32 getModeledLength(const void* pkt_data)
+      { return ((ShmemMsg*) pkt_data)->getModeledLength(); }
+      bool isModeled(const void* pkt_data)
+      { return ((ShmemMsg*) pkt_data)->isModeled(); }
+
+      void outputSummary(std::ostream &os);
+
+      // App + Sim thread synchronization
+      void waitForAppThread();
+      void wakeUpAppThread();
+      void waitForSimThread();
+      void wakeUpSimThread();
+
+      // Cache line replication trace
+      static void openCacheLineReplicationTraceFiles();
+      static void closeCacheLineReplicationTraceFiles();
+      static void outputCacheLineReplicationSummary();
+      
+      void incrCycleCount(MemComponent::Type mem_component, CachePerfModel::CacheAccess_t access_type);
+   
+   private:
+      L1CacheCntlr* _l1_cache_cntlr;
+      L2CacheCntlr* _l2_cache_cntlr;
+      DramDirectoryCntlr* _dram_directory_cntlr;
+      DramCntlr* _dram_cntlr;
+
+      // Home lookups
+      AddressHomeLookup* _dram_directory_home_lookup;
+
+      bool _dram_cntlr_present;
+
+      // App + Sim thread synchronization
+      Lock _lock;
+      AdaptiveSemaphore _app_thread_sem;
+      AdaptiveSemaphore _sim_thread_sem;
+      // Is the sim thread the current holder of _lock ?
+      bool _sim_thread_holds_lock;
+
+      // Msgs the sim thread sent to its own tile (local-home fast path),
+      // tagged with their receive time
+      typedef std::pair<UInt64,Byte*> LocalMsg;
+      std::queue<LocalMsg> _local_msg_queue;
+
+      // Encoded msg buffers (see ShmemMsg::makeMsgBuf())
+      UInt32 _msg_buf_size;
+      Byte* _send_msg_buf;
+      std::vector<Byte*> _free_msg_buf_list;
+
+      UInt32 _cache_line_size;
+      bool _enabled;
+
+      // Performance Models
+      CachePerfModel* _l1_icache_perf_model;
+      CachePerfModel* _l1_dcache_perf_model;
+      CachePerfModel* _l2_cache_perf_model;
+      
+      // Cache Line Replication
+      static ofstream _cache_line_replication_file;
+
+      void handleMsg(core_id_t sender, core_id_t receiver, ShmemMsg* shmem_msg, UInt64 msg_time);
+      void sendLocalMsg(PacketType packet_type, ShmemMsg& shmem_msg, UInt64 msg_time);
+      Byte* allocateMsgBuf();
+      void releaseMsgBuf(Byte* msg_buf);
+   };
+}
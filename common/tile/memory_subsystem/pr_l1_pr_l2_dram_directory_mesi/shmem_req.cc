@@ -0,0 +1,17 @@
+#include "shmem_req.h"
+#include "log.h"
+
+namespace PrL1PrL2DramDirectoryMESI
+{
+   ShmemReq::ShmemReq(ShmemMsg* shmem_msg, UInt64 time):
+      m_shmem_msg(shmem_msg),
+      m_time(time)
+   {
+      // The req keeps its own copy of the shmem_msg (it outlives the msg buffer)
+      LOG_ASSERT_ERROR(shmem_msg->getDataBuf() == NULL, 
+            "Shmem Reqs should not have data payloads");
+   }
+
+   ShmemReq::~ShmemReq()
+   {}
+}
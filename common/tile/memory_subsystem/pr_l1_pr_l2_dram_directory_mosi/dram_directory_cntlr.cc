@@ -29,6 +29,7 @@ DramDirectoryCntlr::DramDirectoryCntlr(MemoryManager* memory_manager,
                                               dram_directory_max_hw_sharers,
                                               dram_directory_max_num_sharers,
                                               num_dram_cntlrs,
+                                              _memory_manager->getDramDirectoryHomeLookup(),
                                               dram_directory_access_time_str);
 
    _dram_directory_req_queue_list = new HashMapQueue<IntPtr,ShmemReq*>();
@@ -19,6 +19,7 @@ namespace PrL1PrL2DramDirectoryMOSI
 #include "shmem_perf_model.h"
 #include "cache_replacement_policy.h"
 #include "cache_hash_fn.h"
+#include "mshr.h"
 
 namespace PrL1PrL2DramDirectoryMOSI
 {
@@ -37,11 +38,13 @@ namespace PrL1PrL2DramDirectoryMOSI
                    string L1_dcache_replacement_policy,
                    UInt32 L1_dcache_access_delay,
                    bool L1_dcache_track_miss_types,
+                   UInt32 L1_dcache_num_mshrs,
                    float frequency);
       ~L1CacheCntlr();
 
       Cache* getL1ICache() { return _L1_icache; }
       Cache* getL1DCache() { return _L1_dcache; }
+      MSHR* getL1DCacheMSHR() { return _L1_dcache_mshr; }
 
       void setL2CacheCntlr(L2CacheCntlr* L2_cache_cntlr);
 
@@ -64,6 +67,7 @@ namespace PrL1PrL2DramDirectoryMOSI
       MemoryManager* _memory_manager;
       Cache* _L1_icache;
       Cache* _L1_dcache;
+      MSHR* _L1_dcache_mshr;
       CacheReplacementPolicy* _L1_icache_replacement_policy_obj;
       CacheReplacementPolicy* _L1_dcache_replacement_policy_obj;
       CacheHashFn* _L1_icache_hash_fn_obj;
@@ -86,5 +90,10 @@ namespace PrL1PrL2DramDirectoryMOSI
       UInt32 getCacheLineSize();
       MemoryManager* getMemoryManager()   { return _memory_manager; }
       ShmemPerfModel* getShmemPerfModel();
+
+      // L1-D MSHRs (in simulated time)
+      UInt64 issueL1DCacheMiss();
+      void completeL1DCacheMiss(IntPtr address, UInt64 issue_time);
+      void waitForL1DCacheFill(IntPtr address);
    };
 }
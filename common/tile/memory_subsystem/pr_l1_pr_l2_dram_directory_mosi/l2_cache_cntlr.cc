@@ -15,6 +15,9 @@ L2CacheCntlr::L2CacheCntlr(MemoryManager* memory_manager,
                            string L2_cache_replacement_policy,
                            UInt32 L2_cache_access_delay,
                            bool L2_cache_track_miss_types,
+                           string L2_cache_prefetcher_type,
+                           UInt32 L2_cache_prefetcher_degree,
+                           UInt32 L2_cache_prefetcher_table_size,
                            float frequency)
    : _memory_manager(memory_manager)
    , _L1_cache_cntlr(L1_cache_cntlr)
@@ -39,6 +42,9 @@ L2CacheCntlr::L2CacheCntlr(MemoryManager* memory_manager,
          frequency,
          L2_cache_track_miss_types);
 
+   _L2_cache_prefetcher = Prefetcher::create(L2_cache_prefetcher_type, cache_line_size,
+         L2_cache_prefetcher_degree, L2_cache_prefetcher_table_size);
+
    initializeEvictionCounters();
    initializeInvalidationCounters();
 }
@@ -48,6 +54,7 @@ L2CacheCntlr::~L2CacheCntlr()
    delete _L2_cache;
    delete _L2_cache_replacement_policy_obj;
    delete _L2_cache_hash_fn_obj;
+   delete _L2_cache_prefetcher;
 }
 
 void
@@ -72,6 +79,9 @@ L2CacheCntlr::invalidateCacheLine(IntPtr address, PrL2CacheLineInfo& L2_cache_li
 {
    L2_cache_line_info.invalidate();
    _L2_cache->setCacheLineInfo(address, &L2_cache_line_info);
+
+   if (_L2_cache_prefetcher)
+      _L2_cache_prefetcher->recordEviction(address);
 }
 
 void
@@ -110,6 +120,8 @@ L2CacheCntlr::insertCacheLine(IntPtr address, CacheState::Type cstate, Byte* fil
       CacheState::Type evicted_cstate = evicted_cache_line_info.getCState();
       // Update eviction counters so as to track clean and dirty evictions
       updateEvictionCounters(cstate, evicted_cstate);
+      if (_L2_cache_prefetcher)
+         _L2_cache_prefetcher->recordEviction(evicted_address);
 
       // Invalidate the cache line in L1-I/L1-D + get utilization
       invalidateCacheLineInL1(evicted_cache_line_info.getCachedLoc(), evicted_address);
@@ -230,6 +242,18 @@ L2CacheCntlr::processShmemRequestFromL1Cache(MemComponent::Type mem_component, C
       L2_cache_line_info.setCachedLoc(mem_component);
       _L2_cache->setCacheLineInfo(address, &L2_cache_line_info);
    }
+
+   if ( _L2_cache_prefetcher && (L2_cstate != CacheState::INVALID) )
+   {
+      // A prefetched line that is still being filled delays the access
+      UInt64 curr_time = getShmemPerfModel()->getCycleCount();
+      if (_L2_cache_prefetcher->recordDemandAccess(address, curr_time))
+      {
+         getShmemPerfModel()->setCycleCount(curr_time);
+         // Keep prefetching ahead of the accesses that hit in prefetched lines
+         issuePrefetches(address, Config::getSingleton()->isApplicationTile(getTileId()));
+      }
+   }
    
    return shmem_request_status_in_L2_cache;
 }
@@ -250,15 +274,62 @@ L2CacheCntlr::handleMsgFromL1Cache(ShmemMsg* shmem_msg)
    _outstanding_shmem_msg = *shmem_msg;
    _outstanding_shmem_msg_time = getShmemPerfModel()->getCycleCount();
 
-   ShmemMsg send_shmem_msg(shmem_msg_type, MemComponent::L2_CACHE, MemComponent::DRAM_DIRECTORY,
-                           getTileId(), INVALID_TILE_ID, false, address, shmem_msg->isModeled()); 
-   getMemoryManager()->sendMsg(getHome(address), send_shmem_msg);
+   if (_L2_cache_prefetcher && _L2_cache_prefetcher->isOutstanding(address))
+   {
+      // The line is already being prefetched. Wait for the prefetch instead of requesting it again
+      _L2_cache_prefetcher->recordLateDemandMiss(address);
+   }
+   else
+   {
+      ShmemMsg send_shmem_msg(shmem_msg_type, MemComponent::L2_CACHE, MemComponent::DRAM_DIRECTORY,
+                              getTileId(), INVALID_TILE_ID, false, address, shmem_msg->isModeled()); 
+      getMemoryManager()->sendMsg(getHome(address), send_shmem_msg);
+
+      if (_L2_cache_prefetcher)
+         _L2_cache_prefetcher->recordDemandMiss();
+   }
+
+   if (_L2_cache_prefetcher)
+      issuePrefetches(address, shmem_msg->isModeled());
+}
+
+void
+L2CacheCntlr::issuePrefetches(IntPtr address, bool modeled)
+{
+   vector<IntPtr> prefetch_list;
+   _L2_cache_prefetcher->train(address, prefetch_list);
+
+   for (vector<IntPtr>::iterator it = prefetch_list.begin(); it != prefetch_list.end(); it++)
+   {
+      IntPtr prefetch_address = *it;
+      if (prefetch_address == _outstanding_shmem_msg.getAddress())
+         continue;
+
+      PrL2CacheLineInfo L2_cache_line_info;
+      _L2_cache->getCacheLineInfo(prefetch_address, &L2_cache_line_info);
+      if (L2_cache_line_info.getCState() != CacheState::INVALID)
+         continue;
+
+      // Prefetches are SH_REQs that are not tied to the outstanding miss
+      _L2_cache_prefetcher->recordIssue(prefetch_address);
+      ShmemMsg send_shmem_msg(ShmemMsg::SH_REQ, MemComponent::L2_CACHE, MemComponent::DRAM_DIRECTORY,
+                              getTileId(), INVALID_TILE_ID, false, prefetch_address, modeled);
+      getMemoryManager()->sendMsg(getHome(prefetch_address), send_shmem_msg);
+   }
 }
 
 void
 L2CacheCntlr::handleMsgFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg)
 {
    ShmemMsg::Type shmem_msg_type = shmem_msg->getType();
+
+   if ( (shmem_msg_type == ShmemMsg::SH_REP) && _L2_cache_prefetcher &&
+        _L2_cache_prefetcher->isOutstanding(shmem_msg->getAddress()) )
+   {
+      processPrefetchRepFromDramDirectory(sender, shmem_msg);
+      return;
+   }
+
    switch (shmem_msg_type)
    {
    case ShmemMsg::EX_REP:
@@ -289,24 +360,67 @@ L2CacheCntlr::handleMsgFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg)
    
    if ((shmem_msg_type == ShmemMsg::EX_REP) || (shmem_msg_type == ShmemMsg::SH_REP) || (shmem_msg_type == ShmemMsg::UPGRADE_REP))
    {
-      assert(_outstanding_shmem_msg_time <= getShmemPerfModel()->getCycleCount());
-      
-      // Reset the clock to the time the request left the tile is miss type is not modeled
       LOG_ASSERT_ERROR(_outstanding_shmem_msg.isModeled() == shmem_msg->isModeled(), "Request(%s), Response(%s)",
                        _outstanding_shmem_msg.isModeled() ? "MODELED" : "UNMODELED",
                        shmem_msg->isModeled() ? "MODELED" : "UNMODELED");
 
-      if (!_outstanding_shmem_msg.isModeled())
-         getShmemPerfModel()->setCycleCount(_outstanding_shmem_msg_time);
+      completeOutstandingShmemMsg();
+   }
+}
+
+void
+L2CacheCntlr::completeOutstandingShmemMsg()
+{
+   assert(_outstanding_shmem_msg_time <= getShmemPerfModel()->getCycleCount());
+   
+   // Reset the clock to the time the request left the tile is miss type is not modeled
+   if (!_outstanding_shmem_msg.isModeled())
+      getShmemPerfModel()->setCycleCount(_outstanding_shmem_msg_time);
+
+   // Increment the clock by the time taken to update the L2 cache
+   getMemoryManager()->incrCycleCount(MemComponent::L2_CACHE, CachePerfModel::ACCESS_CACHE_DATA_AND_TAGS);
+
+   // There are no more outstanding memory requests
+   _outstanding_shmem_msg = ShmemMsg();
+   
+   _memory_manager->wakeUpAppThread();
+   _memory_manager->waitForAppThread();
+}
+
+void
+L2CacheCntlr::processPrefetchRepFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg)
+{
+   IntPtr address = shmem_msg->getAddress();
+   Byte* data_buf = shmem_msg->getDataBuf();
 
+   if (address != _outstanding_shmem_msg.getAddress())
+   {
       // Increment the clock by the time taken to update the L2 cache
       getMemoryManager()->incrCycleCount(MemComponent::L2_CACHE, CachePerfModel::ACCESS_CACHE_DATA_AND_TAGS);
+      _L2_cache_prefetcher->recordFill(address, getShmemPerfModel()->getCycleCount());
 
-      // There are no more outstanding memory requests
-      _outstanding_shmem_msg = ShmemMsg();
-      
-      _memory_manager->wakeUpAppThread();
-      _memory_manager->waitForAppThread();
+      // Insert Cache Line in the L2 Cache only
+      insertCacheLine(address, CacheState::SHARED, data_buf, MemComponent::INVALID);
+      return;
+   }
+
+   // The outstanding miss has been waiting on this prefetch
+   _L2_cache_prefetcher->recordFill(address, getShmemPerfModel()->getCycleCount());
+
+   if (_outstanding_shmem_msg.getType() == ShmemMsg::SH_REQ)
+   {
+      // Insert Cache Line in L1 and L2 Caches
+      insertCacheLineInHierarchy(address, CacheState::SHARED, data_buf);
+      completeOutstandingShmemMsg();
+   }
+   else
+   {
+      // The line still has to be upgraded to the MODIFIED state
+      insertCacheLine(address, CacheState::SHARED, data_buf, MemComponent::INVALID);
+
+      ShmemMsg send_shmem_msg(ShmemMsg::EX_REQ, MemComponent::L2_CACHE, MemComponent::DRAM_DIRECTORY,
+                              getTileId(), INVALID_TILE_ID, false, address, _outstanding_shmem_msg.isModeled());
+      getMemoryManager()->sendMsg(getHome(address), send_shmem_msg);
    }
 }
 
@@ -591,6 +705,9 @@ L2CacheCntlr::outputSummary(ostream& out)
    out << "        Exclusive Request - Clean Evictions: " << _total_clean_evictions_exreq << endl;
    out << "        Shared Request - Dirty Evictions: " << _total_dirty_evictions_shreq << endl;
    out << "        Shared Request - Clean Evictions: " << _total_clean_evictions_shreq << endl;
+
+   if (_L2_cache_prefetcher)
+      _L2_cache_prefetcher->outputSummary(out);
 }
    
 pair<bool,Cache::MissType>
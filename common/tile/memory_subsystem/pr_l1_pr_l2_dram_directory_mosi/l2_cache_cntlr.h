@@ -20,6 +20,7 @@ using std::map;
 #include "shmem_perf_model.h"
 #include "cache_replacement_policy.h"
 #include "cache_hash_fn.h"
+#include "prefetcher.h"
 
 namespace PrL1PrL2DramDirectoryMOSI
 {
@@ -35,6 +36,9 @@ namespace PrL1PrL2DramDirectoryMOSI
                    string L2_cache_replacement_policy,
                    UInt32 L2_cache_access_delay,
                    bool L2_cache_track_miss_types,
+                   string L2_cache_prefetcher_type,
+                   UInt32 L2_cache_prefetcher_degree,
+                   UInt32 L2_cache_prefetcher_table_size,
                    float frequency);
       ~L2CacheCntlr();
 
@@ -61,6 +65,7 @@ namespace PrL1PrL2DramDirectoryMOSI
       Cache* _L2_cache;
       CacheReplacementPolicy* _L2_cache_replacement_policy_obj;
       CacheHashFn* _L2_cache_hash_fn_obj;
+      Prefetcher* _L2_cache_prefetcher;
       L1CacheCntlr* _L1_cache_cntlr;
       AddressHomeLookup* _dram_directory_home_lookup;
 
@@ -80,6 +85,13 @@ namespace PrL1PrL2DramDirectoryMOSI
       UInt64 _total_dirty_evictions_shreq;
       UInt64 _total_clean_evictions_shreq;
 
+      // Wake up the app thread once the outstanding miss is serviced
+      void completeOutstandingShmemMsg();
+
+      // Prefetching
+      void issuePrefetches(IntPtr address, bool modeled);
+      void processPrefetchRepFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg);
+
       // L2 cache operations
       void invalidateCacheLine(IntPtr address, PrL2CacheLineInfo& L2_cache_line_info);
       void readCacheLine(IntPtr address, Byte* data_buf);
@@ -1,3 +1,6 @@
+#include <cstring>
+#include <cmath>
+
 #include "memory_manager.h"
 #include "cache.h"
 #include "simulator.h"
@@ -18,6 +21,7 @@ MemoryManager::MemoryManager(Tile* tile, Network* network, ShmemPerfModel* shmem
    , _dram_directory_cntlr(NULL)
    , _dram_cntlr(NULL)
    , _dram_cntlr_present(false)
+   , _sim_thread_holds_lock(false)
    , _enabled(false)
 {
    // Read Parameters from the Config file
@@ -40,6 +44,7 @@ MemoryManager::MemoryManager(Tile* tile, Network* network, ShmemPerfModel* shmem
    UInt32 L1_dcache_tags_access_time = 0;
    std::string L1_dcache_perf_model_type;
    bool L1_dcache_track_miss_types = false;
+   UInt32 L1_dcache_num_mshrs = 0;
 
    std::string L2_cache_type;
    UInt32 L2_cache_line_size = 0;
@@ -50,6 +55,9 @@ MemoryManager::MemoryManager(Tile* tile, Network* network, ShmemPerfModel* shmem
    UInt32 L2_cache_tags_access_time = 0;
    std::string L2_cache_perf_model_type;
    bool L2_cache_track_miss_types = false;
+   std::string L2_cache_prefetcher_type;
+   UInt32 L2_cache_prefetcher_degree = 0;
+   UInt32 L2_cache_prefetcher_table_size = 0;
 
    std::string dram_directory_total_entries_str;
    UInt32 dram_directory_associativity = 0;
@@ -58,6 +66,7 @@ MemoryManager::MemoryManager(Tile* tile, Network* network, ShmemPerfModel* shmem
    std::string dram_directory_type_str;
    UInt32 dram_directory_home_lookup_param = 0;
    std::string dram_directory_access_time_str;
+   std::string dram_directory_home_interleaving_str;
 
    volatile float dram_latency = 0.0;
    volatile float per_dram_controller_bandwidth = 0.0;
@@ -87,6 +96,7 @@ MemoryManager::MemoryManager(Tile* tile, Network* network, ShmemPerfModel* shmem
       L1_dcache_tags_access_time = Sim()->getCfg()->getInt(L1_dcache_type + "/tags_access_time");
       L1_dcache_perf_model_type = Sim()->getCfg()->getString(L1_dcache_type + "/perf_model_type");
       L1_dcache_track_miss_types = Sim()->getCfg()->getBool(L1_dcache_type + "/track_miss_types");
+      L1_dcache_num_mshrs = Sim()->getCfg()->getInt(L1_dcache_type + "/num_mshrs");
 
       // L2 Cache
       L2_cache_type = "l2_cache/" + Config::getSingleton()->getL2CacheType(getTile()->getId());
@@ -98,6 +108,9 @@ MemoryManager::MemoryManager(Tile* tile, Network* network, ShmemPerfModel* shmem
       L2_cache_tags_access_time = Sim()->getCfg()->getInt(L2_cache_type + "/tags_access_time");
       L2_cache_perf_model_type = Sim()->getCfg()->getString(L2_cache_type + "/perf_model_type");
       L2_cache_track_miss_types = Sim()->getCfg()->getBool(L2_cache_type + "/track_miss_types");
+      L2_cache_prefetcher_type = Sim()->getCfg()->getString(L2_cache_type + "/prefetcher", "none");
+      L2_cache_prefetcher_degree = Sim()->getCfg()->getInt(L2_cache_type + "/prefetcher_degree", 2);
+      L2_cache_prefetcher_table_size = Sim()->getCfg()->getInt(L2_cache_type + "/prefetcher_table_size", 16);
 
       // Dram Directory Cache
       dram_directory_total_entries_str = Sim()->getCfg()->getString("dram_directory/total_entries");
@@ -106,6 +119,7 @@ MemoryManager::MemoryManager(Tile* tile, Network* network, ShmemPerfModel* shmem
       dram_directory_max_hw_sharers = Sim()->getCfg()->getInt("dram_directory/max_hw_sharers");
       dram_directory_type_str = Sim()->getCfg()->getString("dram_directory/directory_type");
       dram_directory_access_time_str = Sim()->getCfg()->getString("dram_directory/access_time");
+      dram_directory_home_interleaving_str = Sim()->getCfg()->getString("dram_directory/home_interleaving", "line");
 
       // Dram Cntlr
       dram_latency = Sim()->getCfg()->getFloat("dram/latency");
@@ -131,12 +145,18 @@ MemoryManager::MemoryManager(Tile* tile, Network* network, ShmemPerfModel* shmem
                     L1_icache_line_size, L1_dcache_line_size, L2_cache_line_size);
    
    _cache_line_size = L1_icache_line_size;
-   dram_directory_home_lookup_param = ceilLog2(_cache_line_size);
+
+   // Msgs are encoded as the ShmemMsg followed by at most one cache line
+   _msg_buf_size = sizeof(ShmemMsg) + _cache_line_size;
+   _send_msg_buf = new Byte[_msg_buf_size];
+
+   dram_directory_home_lookup_param = AddressHomeLookup::parseInterleavingGranularity(dram_directory_home_interleaving_str, _cache_line_size);
 
    float core_frequency = Config::getSingleton()->getCoreFrequency(Tile::getMainCoreId(getTile()->getId()));
    
    std::vector<tile_id_t> tile_list_with_memory_controllers = getTileListWithMemoryControllers();
    UInt32 num_memory_controllers = tile_list_with_memory_controllers.size();
+   _dram_directory_home_lookup = new AddressHomeLookup(dram_directory_home_lookup_param, tile_list_with_memory_controllers, getCacheLineSize());
    
    if (find(tile_list_with_memory_controllers.begin(), tile_list_with_memory_controllers.end(), getTile()->getId())
          != tile_list_with_memory_controllers.end())
@@ -144,6 +164,7 @@ MemoryManager::MemoryManager(Tile* tile, Network* network, ShmemPerfModel* shmem
       _dram_cntlr_present = true;
 
       _dram_cntlr = new DramCntlr(getTile(),
+            _dram_directory_home_lookup,
             dram_latency,
             per_dram_controller_bandwidth,
             dram_queue_model_enabled,
@@ -162,8 +183,6 @@ MemoryManager::MemoryManager(Tile* tile, Network* network, ShmemPerfModel* shmem
             dram_directory_access_time_str);
    }
 
-   _dram_directory_home_lookup = new AddressHomeLookup(dram_directory_home_lookup_param, tile_list_with_memory_controllers, getCacheLineSize());
-
    _L1_cache_cntlr = new L1CacheCntlr(this,
          getCacheLineSize(),
          L1_icache_size,
@@ -176,6 +195,7 @@ MemoryManager::MemoryManager(Tile* tile, Network* network, ShmemPerfModel* shmem
          L1_dcache_replacement_policy,
          L1_dcache_data_access_time,
          L1_dcache_track_miss_types,
+         L1_dcache_num_mshrs,
          core_frequency);
    
    _L2_cache_cntlr = new L2CacheCntlr(this,
@@ -187,6 +207,9 @@ MemoryManager::MemoryManager(Tile* tile, Network* network, ShmemPerfModel* shmem
          L2_cache_replacement_policy,
          L2_cache_data_access_time,
          L2_cache_track_miss_types,
+         L2_cache_prefetcher_type,
+         L2_cache_prefetcher_degree,
+         L2_cache_prefetcher_table_size,
          core_frequency);
 
    _L1_cache_cntlr->setL2CacheCntlr(_L2_cache_cntlr);
@@ -222,6 +245,10 @@ MemoryManager::~MemoryManager()
       delete _dram_cntlr;
       delete _dram_directory_cntlr;
    }
+
+   delete [] _send_msg_buf;
+   for (std::vector<Byte*>::iterator it = _free_msg_buf_list.begin(); it != _free_msg_buf_list.end(); it++)
+      delete [] (*it);
 }
 
 bool
@@ -251,23 +278,40 @@ MemoryManager::coreInitiateMemoryAccess(MemComponent::Type mem_component,
 void
 MemoryManager::handleMsgFromNetwork(NetPacket& packet)
 {
-   core_id_t sender = packet.sender;
    ShmemMsg* shmem_msg = ShmemMsg::getShmemMsg((Byte*) packet.data);
-   UInt64 msg_time = packet.time;
 
+   _lock.acquire();
+   _sim_thread_holds_lock = true;
+
+   handleMsg(packet.sender, packet.receiver, shmem_msg, packet.time);
+
+   // Msgs this tile sent to itself while handling the above
+   while (!_local_msg_queue.empty())
+   {
+      LocalMsg local_msg = _local_msg_queue.front();
+      _local_msg_queue.pop();
+      core_id_t tile_core_id = Tile::getMainCoreId(getTile()->getId());
+      handleMsg(tile_core_id, tile_core_id, ShmemMsg::getShmemMsg(local_msg.second), local_msg.first);
+      releaseMsgBuf(local_msg.second);
+   }
+
+   _sim_thread_holds_lock = false;
+   _lock.release();
+}
+
+void
+MemoryManager::handleMsg(core_id_t sender, core_id_t receiver, ShmemMsg* shmem_msg, UInt64 msg_time)
+{
    MemComponent::Type receiver_mem_component = shmem_msg->getReceiverMemComponent();
    MemComponent::Type sender_mem_component = shmem_msg->getSenderMemComponent();
 
-   // Acquire lock
-   _lock.acquire();
-
    getShmemPerfModel()->setCycleCount(msg_time);
 
    LOG_PRINT("Time(%llu), Got Shmem Msg: type(%s), address(%#lx), "
              "sender_mem_component(%s), receiver_mem_component(%s), sender(%i,%i), receiver(%i,%i)", 
              msg_time, SPELL_SHMSG(shmem_msg->getType()), shmem_msg->getAddress(),
              SPELL_MEMCOMP(sender_mem_component), SPELL_MEMCOMP(receiver_mem_component),
-             sender.tile_id, sender.core_type, packet.receiver.tile_id, packet.receiver.core_type);    
+             sender.tile_id, sender.core_type, receiver.tile_id, receiver.core_type);    
 
    switch (receiver_mem_component)
    {
@@ -312,20 +356,6 @@ MemoryManager::handleMsgFromNetwork(NetPacket& packet)
             receiver_mem_component);
       break;
    }
-
-   // Delete the allocated Shared Memory Message
-   // First delete 'data_buf' if it is present
-   // LOG_PRINT("Finished handling Shmem Msg");
-
-   if (shmem_msg->getDataLength() > 0)
-   {
-      assert(shmem_msg->getDataBuf());
-      delete [] shmem_msg->getDataBuf();
-   }
-   delete shmem_msg;
-
-   // Release lock
-   _lock.release();
 }
 
 void
@@ -333,7 +363,6 @@ MemoryManager::sendMsg(tile_id_t receiver, ShmemMsg& shmem_msg)
 {
    assert((shmem_msg.getDataBuf() == NULL) == (shmem_msg.getDataLength() == 0));
 
-   Byte* msg_buf = shmem_msg.makeMsgBuf();
    UInt64 msg_time = getShmemPerfModel()->getCycleCount();
 
    LOG_PRINT("Time(%llu), Sending Msg: type(%s), address(%#llx), "
@@ -344,13 +373,52 @@ MemoryManager::sendMsg(tile_id_t receiver, ShmemMsg& shmem_msg)
 
    PacketType packet_type = getPacketType(shmem_msg.getSenderMemComponent(), shmem_msg.getReceiverMemComponent());
 
+   if ( (receiver == getTile()->getId()) && _sim_thread_holds_lock )
+   {
+      sendLocalMsg(packet_type, shmem_msg, msg_time);
+      return;
+   }
+
+   shmem_msg.makeMsgBuf(_send_msg_buf);
+
    NetPacket packet(msg_time, packet_type,
          getTile()->getId(), receiver,
-         shmem_msg.getMsgLen(), (const void*) msg_buf);
+         shmem_msg.getMsgLen(), (const void*) _send_msg_buf);
    getNetwork()->netSend(packet);
+}
+
+void
+MemoryManager::sendLocalMsg(PacketType packet_type, ShmemMsg& shmem_msg, UInt64 msg_time)
+{
+   // The receiver is this tile's sim thread, i.e., the caller. Queue the
+   // encoded msg for handleMsgFromNetwork() instead of going through the transport layer
+   Byte* msg_buf = allocateMsgBuf();
+   shmem_msg.makeMsgBuf(msg_buf);
+
+   // Charge the latency the network model assigns to a packet sent to self
+   NetPacket packet(msg_time, packet_type,
+         getTile()->getId(), getTile()->getId(),
+         shmem_msg.getMsgLen(), (const void*) msg_buf);
+   getNetwork()->modelLocalDelivery(packet);
+
+   _local_msg_queue.push(LocalMsg(packet.time, msg_buf));
+}
+
+Byte*
+MemoryManager::allocateMsgBuf()
+{
+   if (_free_msg_buf_list.empty())
+      return new Byte[_msg_buf_size];
+
+   Byte* msg_buf = _free_msg_buf_list.back();
+   _free_msg_buf_list.pop_back();
+   return msg_buf;
+}
 
-   // Delete the Msg Buf
-   delete [] msg_buf;
+void
+MemoryManager::releaseMsgBuf(Byte* msg_buf)
+{
+   _free_msg_buf_list.push_back(msg_buf);
 }
 
 void
@@ -358,7 +426,7 @@ MemoryManager::broadcastMsg(ShmemMsg& shmem_msg)
 {
    assert((shmem_msg.getDataBuf() == NULL) == (shmem_msg.getDataLength() == 0));
 
-   Byte* msg_buf = shmem_msg.makeMsgBuf();
+   shmem_msg.makeMsgBuf(_send_msg_buf);
    UInt64 msg_time = getShmemPerfModel()->getCycleCount();
 
    LOG_PRINT("Time(%llu), Broadcasting Msg: type(%s), address(%#llx), "
@@ -371,11 +439,8 @@ MemoryManager::broadcastMsg(ShmemMsg& shmem_msg)
 
    NetPacket packet(msg_time, packet_type,
          getTile()->getId(), NetPacket::BROADCAST,
-         shmem_msg.getMsgLen(), (const void*) msg_buf);
+         shmem_msg.getMsgLen(), (const void*) _send_msg_buf);
    getNetwork()->netSend(packet);
-
-   // Delete the Msg Buf
-   delete [] msg_buf;
 }
 
 PacketType
@@ -490,6 +555,7 @@ MemoryManager::outputSummary(std::ostream &os)
    os << "Cache Summary:\n";
    _L1_cache_cntlr->getL1ICache()->outputSummary(os);
    _L1_cache_cntlr->getL1DCache()->outputSummary(os);
+   _L1_cache_cntlr->getL1DCacheMSHR()->outputSummary(os);
    _L2_cache_cntlr->getL2Cache()->outputSummary(os);
    _L2_cache_cntlr->outputSummary(os);
 
@@ -498,15 +564,19 @@ MemoryManager::outputSummary(std::ostream &os)
       _dram_directory_cntlr->outputSummary(os);
       os << "Dram Directory Cache Summary:\n";
       _dram_directory_cntlr->getDramDirectoryCache()->outputSummary(os);
-      _dram_cntlr->getDramPerfModel()->outputSummary(os);
+      _dram_cntlr->outputSummary(os);
    }
    else
    {
       DramDirectoryCntlr::dummyOutputSummary(os);
       os << "Dram Directory Cache Summary:\n";
       DirectoryCache::dummyOutputSummary(os, getTile()->getId());
-      DramPerfModel::dummyOutputSummary(os);
+      DramCntlr::dummyOutputSummary(os);
    }
+
+   os << "Thread Handoff Summary:\n";
+   _app_thread_sem.outputSummary(os, "App Thread");
+   _sim_thread_sem.outputSummary(os, "Sim Thread");
 }
 
 void
@@ -514,11 +584,13 @@ MemoryManager::waitForAppThread()
 {
    _sim_thread_sem.wait();
    _lock.acquire();
+   _sim_thread_holds_lock = true;
 }
 
 void
 MemoryManager::wakeUpAppThread()
 {
+   _sim_thread_holds_lock = false;
    _lock.release();
    _app_thread_sem.signal();
 }
@@ -52,8 +52,10 @@ namespace PrL1PrL2DramDirectoryMOSI
       ~ShmemMsg();
 
       void clone(const ShmemMsg* shmem_msg);
+      // Wire format: the msg followed by its line data (getMsgLen() bytes)
+      // getShmemMsg() decodes a buffer in place (the msg aliases msg_buf)
       static ShmemMsg* getShmemMsg(Byte* msg_buf);
-      Byte* makeMsgBuf();
+      void makeMsgBuf(Byte* msg_buf);
       UInt32 getMsgLen();
 
       // Get the msg type as a string
@@ -6,7 +6,8 @@ namespace PrL1PrL2DramDirectoryMOSI
 {
 
 ShmemReq::ShmemReq(ShmemMsg* shmem_msg, UInt64 time)
-   : _arrival_time(time)
+   : _shmem_msg(shmem_msg)
+   , _arrival_time(time)
    , _processing_start_time(time)
    , _processing_finish_time(time)
    , _initial_dstate(DirectoryState::UNCACHED)
@@ -14,16 +15,13 @@ ShmemReq::ShmemReq(ShmemMsg* shmem_msg, UInt64 time)
    , _sharer_tile_id(INVALID_TILE_ID)
    , _upgrade_reply(false)
 {
-   // Make a local copy of the shmem_msg
-   _shmem_msg = new ShmemMsg(shmem_msg);
+   // The req keeps its own copy of the shmem_msg (it outlives the msg buffer)
    LOG_ASSERT_ERROR(shmem_msg->getDataBuf() == NULL, 
          "Shmem Reqs should not have data payloads");
 }
 
 ShmemReq::~ShmemReq()
-{
-   delete _shmem_msg;
-}
+{}
 
 void
 ShmemReq::updateProcessingStartTime(UInt64 time)
@@ -11,7 +11,7 @@ namespace PrL1PrL2DramDirectoryMOSI
    class ShmemReq
    {
    private:
-      ShmemMsg* _shmem_msg;
+      ShmemMsg _shmem_msg;
       
       UInt64 _arrival_time;
       UInt64 _processing_start_time;
@@ -26,8 +26,10 @@ namespace PrL1PrL2DramDirectoryMOSI
       ShmemReq(ShmemMsg* shmem_msg, UInt64 time);
       ~ShmemReq();
 
-      ShmemMsg* getShmemMsg() const
-      { return _shmem_msg; }
+      ShmemMsg* getShmemMsg()
+      { return &_shmem_msg; }
+      const ShmemMsg* getShmemMsg() const
+      { return &_shmem_msg; }
       UInt64 getSerializationTime() const
       { return _processing_start_time - _arrival_time; }
       UInt64 getProcessingTime() const
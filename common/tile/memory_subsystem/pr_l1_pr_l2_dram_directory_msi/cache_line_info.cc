@@ -1,19 +1,35 @@
 #include "cache_line_info.h"
 #include "cache_utils.h"
 #include "log.h"
+#include <new>
 
 namespace PrL1PrL2DramDirectoryMSI
 {
 
+UInt32
+getCacheLineInfoSize(SInt32 cache_level)
+{
+   switch (cache_level)
+   {
+   case L1:
+      return sizeof(PrL1CacheLineInfo);
+   case L2:
+      return sizeof(PrL2CacheLineInfo);
+   default:
+      LOG_PRINT_ERROR("Unrecognized Cache Level(%u)", cache_level);
+      return 0;
+   }
+}
+
 CacheLineInfo*
-createCacheLineInfo(SInt32 cache_level)
+initCacheLineInfo(SInt32 cache_level, Byte* storage)
 {
    switch (cache_level)
    {
    case L1:
-      return new PrL1CacheLineInfo();
+      return new (storage) PrL1CacheLineInfo();
    case L2:
-      return new PrL2CacheLineInfo();
+      return new (storage) PrL2CacheLineInfo();
    default:
       LOG_PRINT_ERROR("Unrecognized Cache Level(%u)", cache_level);
       return (CacheLineInfo*) NULL;
@@ -27,11 +43,8 @@ PrL2CacheLineInfo::PrL2CacheLineInfo(IntPtr tag, CacheState::Type cstate, MemCom
    , _cached_loc(cached_loc)
 {}
 
-PrL2CacheLineInfo::~PrL2CacheLineInfo()
-{}
-
 MemComponent::Type 
-PrL2CacheLineInfo::getCachedLoc()
+PrL2CacheLineInfo::getCachedLoc() const
 {
    return _cached_loc;
 }
@@ -60,10 +73,10 @@ PrL2CacheLineInfo::invalidate()
 }
 
 void 
-PrL2CacheLineInfo::assign(CacheLineInfo* cache_line_info)
+PrL2CacheLineInfo::assign(const CacheLineInfo* cache_line_info)
 {
    CacheLineInfo::assign(cache_line_info);
-   PrL2CacheLineInfo* L2_cache_line_info = dynamic_cast<PrL2CacheLineInfo*>(cache_line_info);
+   const PrL2CacheLineInfo* L2_cache_line_info = static_cast<const PrL2CacheLineInfo*>(cache_line_info);
    _cached_loc = L2_cache_line_info->getCachedLoc();
 }
 
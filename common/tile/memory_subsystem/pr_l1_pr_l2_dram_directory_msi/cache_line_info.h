@@ -8,7 +8,8 @@
 namespace PrL1PrL2DramDirectoryMSI
 {
 
-CacheLineInfo* createCacheLineInfo(SInt32 cache_level);
+UInt32 getCacheLineInfoSize(SInt32 cache_level);
+CacheLineInfo* initCacheLineInfo(SInt32 cache_level, Byte* storage);
 
 typedef CacheLineInfo PrL1CacheLineInfo;
 
@@ -17,14 +18,13 @@ class PrL2CacheLineInfo : public CacheLineInfo
 public:
    PrL2CacheLineInfo(IntPtr tag = ~0, CacheState::Type cstate = CacheState::INVALID,
                      MemComponent::Type cached_loc = MemComponent::INVALID);
-   ~PrL2CacheLineInfo();
 
-   MemComponent::Type getCachedLoc();
+   MemComponent::Type getCachedLoc() const;
    void setCachedLoc(MemComponent::Type cached_loc);
    void clearCachedLoc(MemComponent::Type cached_loc);
 
    void invalidate();
-   void assign(CacheLineInfo* cache_line_info);
+   void assign(const CacheLineInfo* cache_line_info);
 
 private:
    MemComponent::Type _cached_loc;
@@ -18,6 +18,7 @@ L1CacheCntlr::L1CacheCntlr(MemoryManager* memory_manager,
                            string l1_dcache_replacement_policy,
                            UInt32 l1_dcache_access_delay,
                            bool l1_dcache_track_miss_types,
+                           UInt32 l1_dcache_num_mshrs,
                            float frequency)
    : _memory_manager(memory_manager)
    , _l2_cache_cntlr(NULL)
@@ -55,12 +56,15 @@ L1CacheCntlr::L1CacheCntlr(MemoryManager* memory_manager,
          l1_dcache_access_delay,
          frequency,
          l1_icache_track_miss_types);
+
+   _l1_dcache_mshr = new MSHR(l1_dcache_num_mshrs);
 }
 
 L1CacheCntlr::~L1CacheCntlr()
 {
    delete _l1_icache;
    delete _l1_dcache;
+   delete _l1_dcache_mshr;
    delete _l1_icache_replacement_policy_obj;
    delete _l1_dcache_replacement_policy_obj;
    delete _l1_icache_hash_fn_obj;
@@ -86,6 +90,9 @@ L1CacheCntlr::processMemOpFromTile(MemComponent::Type mem_component,
 
    bool l1_cache_hit = true;
    UInt32 access_num = 0;
+   // Only L1-D misses from modeled accesses use the MSHRs
+   bool use_mshr = modeled && (mem_component == MemComponent::L1_DCACHE);
+   UInt64 miss_issue_time = 0;
 
    while(1)
    {
@@ -106,6 +113,14 @@ L1CacheCntlr::processMemOpFromTile(MemComponent::Type mem_component,
          getMemoryManager()->incrCycleCount(mem_component, CachePerfModel::ACCESS_CACHE_DATA_AND_TAGS);
 
          accessCache(mem_component, mem_op_type, ca_address, offset, data_buf, data_length);
+
+         if (use_mshr)
+         {
+            if (l1_cache_hit)
+               waitForL1DCacheFill(ca_address);
+            else
+               completeL1DCacheMiss(ca_address, miss_issue_time);
+         }
                  
          return l1_cache_hit;
       }
@@ -114,6 +129,9 @@ L1CacheCntlr::processMemOpFromTile(MemComponent::Type mem_component,
      
       // Miss in the L1 cache 
       l1_cache_hit = false;
+
+      if (use_mshr)
+         miss_issue_time = issueL1DCacheMiss();
       
       LOG_ASSERT_ERROR(lock_signal != Core::UNLOCK, "Expected to find address(%#lx) in L1 Cache", ca_address);
 
@@ -135,6 +153,9 @@ L1CacheCntlr::processMemOpFromTile(MemComponent::Type mem_component,
 
          accessCache(mem_component, mem_op_type, ca_address, offset, data_buf, data_length);
 
+         if (use_mshr)
+            completeL1DCacheMiss(ca_address, miss_issue_time);
+
          return false;
       }
 
@@ -334,4 +355,27 @@ L1CacheCntlr::getShmemPerfModel()
    return _memory_manager->getShmemPerfModel();
 }
 
+UInt64
+L1CacheCntlr::issueL1DCacheMiss()
+{
+   // Stall till an MSHR is free
+   UInt64 issue_time = _l1_dcache_mshr->getIssueTime(getShmemPerfModel()->getCycleCount());
+   getShmemPerfModel()->setCycleCount(issue_time);
+   return issue_time;
+}
+
+void
+L1CacheCntlr::completeL1DCacheMiss(IntPtr address, UInt64 issue_time)
+{
+   _l1_dcache_mshr->insert(address, issue_time, getShmemPerfModel()->getCycleCount());
+}
+
+void
+L1CacheCntlr::waitForL1DCacheFill(IntPtr address)
+{
+   // The line is present functionally but may still be in flight in simulated time
+   UInt64 fill_time = _l1_dcache_mshr->getFillTime(address, getShmemPerfModel()->getCycleCount());
+   getShmemPerfModel()->setCycleCount(fill_time);
+}
+
 }
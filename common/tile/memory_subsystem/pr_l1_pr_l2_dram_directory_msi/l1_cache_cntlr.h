@@ -18,6 +18,7 @@ namespace PrL1PrL2DramDirectoryMSI
 #include "shmem_perf_model.h"
 #include "cache_replacement_policy.h"
 #include "cache_hash_fn.h"
+#include "mshr.h"
 
 namespace PrL1PrL2DramDirectoryMSI
 {
@@ -36,11 +37,13 @@ namespace PrL1PrL2DramDirectoryMSI
                    string l1_dcache_replacement_policy,
                    UInt32 l1_dcache_access_delay,
                    bool l1_dcache_track_miss_types,
+                   UInt32 l1_dcache_num_mshrs,
                    float frequency);
       ~L1CacheCntlr();
 
       Cache* getL1ICache() { return _l1_icache; }
       Cache* getL1DCache() { return _l1_dcache; }
+      MSHR* getL1DCacheMSHR() { return _l1_dcache_mshr; }
 
       void setL2CacheCntlr(L2CacheCntlr* l2_cache_cntlr);
 
@@ -63,6 +66,7 @@ namespace PrL1PrL2DramDirectoryMSI
       MemoryManager* _memory_manager;
       Cache* _l1_icache;
       Cache* _l1_dcache;
+      MSHR* _l1_dcache_mshr;
       CacheReplacementPolicy* _l1_icache_replacement_policy_obj;
       CacheReplacementPolicy* _l1_dcache_replacement_policy_obj;
       CacheHashFn* _l1_icache_hash_fn_obj;
@@ -85,5 +89,10 @@ namespace PrL1PrL2DramDirectoryMSI
       UInt32 getCacheLineSize();
       MemoryManager* getMemoryManager()   { return _memory_manager; }
       ShmemPerfModel* getShmemPerfModel();
+
+      // L1-D MSHRs (in simulated time)
+      UInt64 issueL1DCacheMiss();
+      void completeL1DCacheMiss(IntPtr address, UInt64 issue_time);
+      void waitForL1DCacheFill(IntPtr address);
    };
 }
@@ -15,6 +15,9 @@ L2CacheCntlr::L2CacheCntlr(MemoryManager* memory_manager,
                            string l2_cache_replacement_policy,
                            UInt32 l2_cache_access_delay,
                            bool l2_cache_track_miss_types,
+                           string l2_cache_prefetcher_type,
+                           UInt32 l2_cache_prefetcher_degree,
+                           UInt32 l2_cache_prefetcher_table_size,
                            float frequency)
    : _memory_manager(memory_manager)
    , _l1_cache_cntlr(l1_cache_cntlr)
@@ -37,6 +40,9 @@ L2CacheCntlr::L2CacheCntlr(MemoryManager* memory_manager,
          l2_cache_access_delay,
          frequency,
          l2_cache_track_miss_types);
+
+   _l2_cache_prefetcher = Prefetcher::create(l2_cache_prefetcher_type, cache_line_size,
+         l2_cache_prefetcher_degree, l2_cache_prefetcher_table_size);
 }
 
 L2CacheCntlr::~L2CacheCntlr()
@@ -44,6 +50,7 @@ L2CacheCntlr::~L2CacheCntlr()
    delete _l2_cache;
    delete _l2_cache_replacement_policy_obj;
    delete _l2_cache_hash_fn_obj;
+   delete _l2_cache_prefetcher;
 }
 
 void
@@ -51,6 +58,9 @@ L2CacheCntlr::invalidateCacheLine(IntPtr address, PrL2CacheLineInfo& l2_cache_li
 {
    l2_cache_line_info.invalidate();
    _l2_cache->setCacheLineInfo(address, &l2_cache_line_info);
+
+   if (_l2_cache_prefetcher)
+      _l2_cache_prefetcher->recordEviction(address);
 }
 
 void
@@ -86,6 +96,8 @@ L2CacheCntlr::insertCacheLine(IntPtr address, CacheState::Type cstate, Byte* fil
    if (eviction)
    {
       LOG_PRINT("Eviction: address(%#lx)", evicted_address);
+      if (_l2_cache_prefetcher)
+         _l2_cache_prefetcher->recordEviction(evicted_address);
       invalidateCacheLineInL1(evicted_cache_line_info.getCachedLoc(), evicted_address);
 
       UInt32 home_node_id = getHome(evicted_address);
@@ -189,6 +201,18 @@ L2CacheCntlr::processShmemRequestFromL1Cache(MemComponent::Type mem_component, C
       l2_cache_line_info.setCachedLoc(mem_component);
       _l2_cache->setCacheLineInfo(address, &l2_cache_line_info);
    }
+
+   if ( _l2_cache_prefetcher && (cstate != CacheState::INVALID) )
+   {
+      // A prefetched line that is still being filled delays the access
+      UInt64 curr_time = getShmemPerfModel()->getCycleCount();
+      if (_l2_cache_prefetcher->recordDemandAccess(address, curr_time))
+      {
+         getShmemPerfModel()->setCycleCount(curr_time);
+         // Keep prefetching ahead of the accesses that hit in prefetched lines
+         issuePrefetches(address, Config::getSingleton()->isApplicationTile(getTileId()));
+      }
+   }
    
    return shmem_request_status_in_l2_cache;
 }
@@ -198,7 +222,6 @@ L2CacheCntlr::handleMsgFromL1Cache(ShmemMsg* shmem_msg)
 {
    IntPtr address = shmem_msg->getAddress();
    ShmemMsg::Type shmem_msg_type = shmem_msg->getType();
-   MemComponent::Type sender_mem_component = shmem_msg->getSenderMemComponent();
 
    assert(shmem_msg->getDataBuf() == NULL);
    assert(shmem_msg->getDataLength() == 0);
@@ -206,24 +229,37 @@ L2CacheCntlr::handleMsgFromL1Cache(ShmemMsg* shmem_msg)
    assert(_outstanding_shmem_msg.getAddress() == INVALID_ADDRESS);
 
    // Set outstanding shmem msg parameters
-   _outstanding_shmem_msg.setAddress(address);
-   _outstanding_shmem_msg.setSenderMemComponent(sender_mem_component);
+   _outstanding_shmem_msg = *shmem_msg;
    _outstanding_shmem_msg_time = getShmemPerfModel()->getCycleCount();
-   
-   switch (shmem_msg_type)
+
+   if (_l2_cache_prefetcher && _l2_cache_prefetcher->isOutstanding(address))
    {
-      case ShmemMsg::EX_REQ:
-         processExReqFromL1Cache(shmem_msg);
-         break;
+      // The line is already being prefetched. Wait for the prefetch instead of requesting it again
+      _l2_cache_prefetcher->recordLateDemandMiss(address);
+   }
+   else
+   {
+      switch (shmem_msg_type)
+      {
+         case ShmemMsg::EX_REQ:
+            processExReqFromL1Cache(shmem_msg);
+            break;
 
-      case ShmemMsg::SH_REQ:
-         processShReqFromL1Cache(shmem_msg);
-         break;
+         case ShmemMsg::SH_REQ:
+            processShReqFromL1Cache(shmem_msg);
+            break;
 
-      default:
-         LOG_PRINT_ERROR("Unrecognized shmem msg type (%u)", shmem_msg_type);
-         break;
+         default:
+            LOG_PRINT_ERROR("Unrecognized shmem msg type (%u)", shmem_msg_type);
+            break;
+      }
+
+      if (_l2_cache_prefetcher)
+         _l2_cache_prefetcher->recordDemandMiss();
    }
+
+   if (_l2_cache_prefetcher)
+      issuePrefetches(address, shmem_msg->isModeled());
 }
 
 void
@@ -260,10 +296,42 @@ L2CacheCntlr::processShReqFromL1Cache(ShmemMsg* shmem_msg)
    getMemoryManager()->sendMsg(getHome(address), msg);
 }
 
+void
+L2CacheCntlr::issuePrefetches(IntPtr address, bool modeled)
+{
+   vector<IntPtr> prefetch_list;
+   _l2_cache_prefetcher->train(address, prefetch_list);
+
+   for (vector<IntPtr>::iterator it = prefetch_list.begin(); it != prefetch_list.end(); it++)
+   {
+      IntPtr prefetch_address = *it;
+      if (prefetch_address == _outstanding_shmem_msg.getAddress())
+         continue;
+
+      PrL2CacheLineInfo l2_cache_line_info;
+      _l2_cache->getCacheLineInfo(prefetch_address, &l2_cache_line_info);
+      if (l2_cache_line_info.getCState() != CacheState::INVALID)
+         continue;
+
+      // Prefetches are SH_REQs that are not tied to the outstanding miss
+      _l2_cache_prefetcher->recordIssue(prefetch_address);
+      ShmemMsg msg(ShmemMsg::SH_REQ, MemComponent::L2_CACHE, MemComponent::DRAM_DIRECTORY, getTileId(), prefetch_address, modeled);
+      getMemoryManager()->sendMsg(getHome(prefetch_address), msg);
+   }
+}
+
 void
 L2CacheCntlr::handleMsgFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg)
 {
    ShmemMsg::Type shmem_msg_type = shmem_msg->getType();
+
+   if ( (shmem_msg_type == ShmemMsg::SH_REP) && _l2_cache_prefetcher &&
+        _l2_cache_prefetcher->isOutstanding(shmem_msg->getAddress()) )
+   {
+      processPrefetchRepFromDramDirectory(sender, shmem_msg);
+      return;
+   }
+
    switch (shmem_msg_type)
    {
       case ShmemMsg::EX_REP:
@@ -287,23 +355,61 @@ L2CacheCntlr::handleMsgFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg)
    }
 
    if ((shmem_msg_type == ShmemMsg::EX_REP) || (shmem_msg_type == ShmemMsg::SH_REP))
-   {
-      LOG_ASSERT_ERROR(_outstanding_shmem_msg_time <= getShmemPerfModel()->getCycleCount(),
-                       "Outstanding msg time(%llu), Curr cycle count(%llu)",
-                       _outstanding_shmem_msg_time, getShmemPerfModel()->getCycleCount());
-      
-      // Reset the clock to the time the request left the tile is miss type is not modeled
-      if (!shmem_msg->isModeled())
-         getShmemPerfModel()->setCycleCount(_outstanding_shmem_msg_time);
+      completeOutstandingShmemMsg();
+}
+
+void
+L2CacheCntlr::completeOutstandingShmemMsg()
+{
+   LOG_ASSERT_ERROR(_outstanding_shmem_msg_time <= getShmemPerfModel()->getCycleCount(),
+                    "Outstanding msg time(%llu), Curr cycle count(%llu)",
+                    _outstanding_shmem_msg_time, getShmemPerfModel()->getCycleCount());
+   
+   // Reset the clock to the time the request left the tile is miss type is not modeled
+   if (!_outstanding_shmem_msg.isModeled())
+      getShmemPerfModel()->setCycleCount(_outstanding_shmem_msg_time);
+
+   // Increment the clock by the time taken to update the L2 cache
+   getMemoryManager()->incrCycleCount(MemComponent::L2_CACHE, CachePerfModel::ACCESS_CACHE_DATA_AND_TAGS);
+
+   // There are no more outstanding memory requests
+   _outstanding_shmem_msg.setAddress(INVALID_ADDRESS);
+   
+   _memory_manager->wakeUpAppThread();
+   _memory_manager->waitForAppThread();
+}
 
+void
+L2CacheCntlr::processPrefetchRepFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg)
+{
+   IntPtr address = shmem_msg->getAddress();
+   Byte* data_buf = shmem_msg->getDataBuf();
+
+   if (address != _outstanding_shmem_msg.getAddress())
+   {
       // Increment the clock by the time taken to update the L2 cache
       getMemoryManager()->incrCycleCount(MemComponent::L2_CACHE, CachePerfModel::ACCESS_CACHE_DATA_AND_TAGS);
+      _l2_cache_prefetcher->recordFill(address, getShmemPerfModel()->getCycleCount());
 
-      // There are no more outstanding memory requests
-      _outstanding_shmem_msg.setAddress(INVALID_ADDRESS);
-      
-      _memory_manager->wakeUpAppThread();
-      _memory_manager->waitForAppThread();
+      // Insert Cache Line in the L2 Cache only
+      insertCacheLine(address, CacheState::SHARED, data_buf, MemComponent::INVALID);
+      return;
+   }
+
+   // The outstanding miss has been waiting on this prefetch
+   _l2_cache_prefetcher->recordFill(address, getShmemPerfModel()->getCycleCount());
+
+   if (_outstanding_shmem_msg.getType() == ShmemMsg::SH_REQ)
+   {
+      // Insert Cache Line in L1 and L2 Caches
+      insertCacheLineInHierarchy(address, CacheState::SHARED, data_buf);
+      completeOutstandingShmemMsg();
+   }
+   else
+   {
+      // The line still has to be obtained in the MODIFIED state
+      insertCacheLine(address, CacheState::SHARED, data_buf, MemComponent::INVALID);
+      processExReqFromL1Cache(&_outstanding_shmem_msg);
    }
 }
 
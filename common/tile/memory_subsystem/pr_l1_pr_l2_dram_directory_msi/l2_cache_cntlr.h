@@ -21,6 +21,7 @@ namespace PrL1PrL2DramDirectoryMSI
 #include "shmem_perf_model.h"
 #include "cache_replacement_policy.h"
 #include "cache_hash_fn.h"
+#include "prefetcher.h"
 
 namespace PrL1PrL2DramDirectoryMSI
 {
@@ -36,10 +37,15 @@ namespace PrL1PrL2DramDirectoryMSI
                    string l2_cache_replacement_policy,
                    UInt32 l2_cache_access_delay,
                    bool l2_cache_track_miss_types,
+                   string l2_cache_prefetcher_type,
+                   UInt32 l2_cache_prefetcher_degree,
+                   UInt32 l2_cache_prefetcher_table_size,
                    float frequency);
       ~L2CacheCntlr();
 
       Cache* getL2Cache() { return _l2_cache; }
+      // NULL if the L2 cache has no prefetcher
+      Prefetcher* getPrefetcher() { return _l2_cache_prefetcher; }
 
       // Handle Request from L1 Cache - This is done for better simulator performance
       pair<bool,Cache::MissType> processShmemRequestFromL1Cache(MemComponent::Type mem_component, Core::mem_op_t mem_op_type, IntPtr address);
@@ -57,6 +63,7 @@ namespace PrL1PrL2DramDirectoryMSI
       Cache* _l2_cache;
       CacheReplacementPolicy* _l2_cache_replacement_policy_obj;
       CacheHashFn* _l2_cache_hash_fn_obj;
+      Prefetcher* _l2_cache_prefetcher;
       L1CacheCntlr* _l1_cache_cntlr;
       AddressHomeLookup* _dram_directory_home_lookup;
       
@@ -64,6 +71,13 @@ namespace PrL1PrL2DramDirectoryMSI
       ShmemMsg _outstanding_shmem_msg;
       UInt64 _outstanding_shmem_msg_time;
       
+      // Wake up the app thread once the outstanding miss is serviced
+      void completeOutstandingShmemMsg();
+
+      // Prefetching
+      void issuePrefetches(IntPtr address, bool modeled);
+      void processPrefetchRepFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg);
+
       // L2 cache operations
       void readCacheLine(IntPtr address, Byte* data_buf);
       void insertCacheLine(IntPtr address, CacheState::Type cstate, Byte* fill_buf, MemComponent::Type mem_component);
@@ -4,16 +4,14 @@
 namespace PrL1PrL2DramDirectoryMSI
 {
    ShmemReq::ShmemReq(ShmemMsg* shmem_msg, UInt64 time):
+      m_shmem_msg(shmem_msg),
       m_time(time)
    {
-      // Make a local copy of the shmem_msg
-      m_shmem_msg = new ShmemMsg(shmem_msg);
+      // The req keeps its own copy of the shmem_msg (it outlives the msg buffer)
       LOG_ASSERT_ERROR(shmem_msg->getDataBuf() == NULL, 
             "Shmem Reqs should not have data payloads");
    }
 
    ShmemReq::~ShmemReq()
-   {
-      delete m_shmem_msg;
-   }
+   {}
 }
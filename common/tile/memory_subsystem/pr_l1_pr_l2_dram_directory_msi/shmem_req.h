@@ -8,14 +8,14 @@ namespace PrL1PrL2DramDirectoryMSI
    class ShmemReq
    {
       private:
-         ShmemMsg* m_shmem_msg;
+         ShmemMsg m_shmem_msg;
          UInt64 m_time;
 
       public:
          ShmemReq(ShmemMsg* shmem_msg, UInt64 time);
          ~ShmemReq();
 
-         ShmemMsg* getShmemMsg() { return m_shmem_msg; }
+         ShmemMsg* getShmemMsg() { return &m_shmem_msg; }
          UInt64 getTime() { return m_time; }
          
          void setTime(UInt64 time) { m_time = time; }
@@ -7,7 +7,8 @@
 namespace PrL1ShL2MSI
 {
 
-CacheLineInfo* createCacheLineInfo(SInt32 cache_level);
+UInt32 getCacheLineInfoSize(SInt32 cache_level);
+CacheLineInfo* initCacheLineInfo(SInt32 cache_level, Byte* storage);
 
 typedef CacheLineInfo PrL1CacheLineInfo;
 
@@ -15,9 +16,8 @@ class ShL2CacheLineInfo : public CacheLineInfo
 {
 public:
    ShL2CacheLineInfo(IntPtr tag = ~0, DirectoryEntry* directory_entry = NULL);
-   ~ShL2CacheLineInfo();
 
-   void assign(CacheLineInfo* cache_line_info);
+   void assign(const CacheLineInfo* cache_line_info);
    
    DirectoryEntry* getDirectoryEntry() const
    { return _directory_entry; }
@@ -6,10 +6,11 @@ namespace PrL1ShL2MSI
 {
 
 DramCntlr::DramCntlr(MemoryManager* memory_manager,
+                     AddressHomeLookup* dram_home_lookup,
                      float dram_access_cost, float dram_bandwidth,
                      bool dram_queue_model_enabled, string dram_queue_model_type,
                      UInt32 cache_line_size)
-   : ::DramCntlr(memory_manager->getTile(), dram_access_cost, dram_bandwidth, dram_queue_model_enabled, dram_queue_model_type, cache_line_size)
+   : ::DramCntlr(memory_manager->getTile(), dram_home_lookup, dram_access_cost, dram_bandwidth, dram_queue_model_enabled, dram_queue_model_type, cache_line_size)
    , _memory_manager(memory_manager)
 {}
 
@@ -18,6 +18,7 @@ class DramCntlr : public ::DramCntlr
 {
 public:
    DramCntlr(MemoryManager* memory_manager,
+             AddressHomeLookup* dram_home_lookup,
              float dram_access_cost, float dram_bandwidth,
              bool dram_queue_model_enabled, string dram_queue_model_type,
              UInt32 cache_line_size);
@@ -21,6 +21,7 @@ namespace PrL1ShL2MSI
 #include "shmem_perf_model.h"
 #include "cache_replacement_policy.h"
 #include "cache_hash_fn.h"
+#include "mshr.h"
 
 namespace PrL1ShL2MSI
 {
@@ -40,11 +41,13 @@ namespace PrL1ShL2MSI
                    string L1_dcache_replacement_policy,
                    UInt32 L1_dcache_access_delay,
                    bool L1_dcache_track_miss_types,
+                   UInt32 L1_dcache_num_mshrs,
                    float frequency);
       ~L1CacheCntlr();
 
       Cache* getL1ICache() { return _L1_icache; }
       Cache* getL1DCache() { return _L1_dcache; }
+      MSHR* getL1DCacheMSHR() { return _L1_dcache_mshr; }
 
       bool processMemOpFromCore(MemComponent::Type mem_component,
             Core::lock_signal_t lock_signal,
@@ -59,6 +62,7 @@ namespace PrL1ShL2MSI
       MemoryManager* _memory_manager;
       Cache* _L1_icache;
       Cache* _L1_dcache;
+      MSHR* _L1_dcache_mshr;
       CacheReplacementPolicy* _L1_icache_replacement_policy_obj;
       CacheReplacementPolicy* _L1_dcache_replacement_policy_obj;
       CacheHashFn* _L1_icache_hash_fn_obj;
@@ -102,5 +106,10 @@ namespace PrL1ShL2MSI
       UInt32 getCacheLineSize();
       MemoryManager* getMemoryManager()   { return _memory_manager; }
       ShmemPerfModel* getShmemPerfModel();
+
+      // L1-D MSHRs (in simulated time)
+      UInt64 issueL1DCacheMiss();
+      void completeL1DCacheMiss(IntPtr address, UInt64 issue_time);
+      void waitForL1DCacheFill(IntPtr address);
    };
 }
@@ -13,6 +13,7 @@ namespace PrL1ShL2MSI
 {
 
 L2CacheCntlr::L2CacheCntlr(MemoryManager* memory_manager,
+                           AddressHomeLookup* L2_cache_home_lookup,
                            AddressHomeLookup* dram_home_lookup,
                            UInt32 cache_line_size,
                            UInt32 L2_cache_size,
@@ -20,8 +21,12 @@ L2CacheCntlr::L2CacheCntlr(MemoryManager* memory_manager,
                            string L2_cache_replacement_policy,
                            UInt32 L2_cache_access_delay,
                            bool L2_cache_track_miss_types,
+                           string L2_cache_prefetcher_type,
+                           UInt32 L2_cache_prefetcher_degree,
+                           UInt32 L2_cache_prefetcher_table_size,
                            float frequency)
    : _memory_manager(memory_manager)
+   , _L2_cache_home_lookup(L2_cache_home_lookup)
    , _dram_home_lookup(dram_home_lookup)
    , _enabled(false)
 {
@@ -43,17 +48,25 @@ L2CacheCntlr::L2CacheCntlr(MemoryManager* memory_manager,
          L2_cache_access_delay,
          frequency,
          L2_cache_track_miss_types);
+
+   // Lines are interleaved over the L2 slices, so the prefetcher works on the
+   // lines homed on this slice
+   _L2_cache_prefetcher = Prefetcher::create(L2_cache_prefetcher_type, cache_line_size,
+         L2_cache_prefetcher_degree, L2_cache_prefetcher_table_size, _L2_cache_home_lookup);
 }
 
 L2CacheCntlr::~L2CacheCntlr()
 {
-   // Some eviction requests
-   LOG_ASSERT_ERROR(_L2_cache_req_queue_list.size() == _evicted_cache_line_map.size(),
-                    "Req list size(%u), Evicted cache line map size(%u)", _L2_cache_req_queue_list.size(), _evicted_cache_line_map.size());
+   // Some eviction requests (and prefetches nobody waited for)
+   UInt32 num_outstanding_prefetches = _L2_cache_prefetcher ? _L2_cache_prefetcher->getNumOutstanding() : 0;
+   LOG_ASSERT_ERROR(_L2_cache_req_queue_list.size() == _evicted_cache_line_map.size() + num_outstanding_prefetches,
+                    "Req list size(%u), Evicted cache line map size(%u), Outstanding prefetches(%u)",
+                    _L2_cache_req_queue_list.size(), _evicted_cache_line_map.size(), num_outstanding_prefetches);
    // FIXME: Directory Entries are not deleted at the end of simulation
    delete _L2_cache;
    delete _L2_cache_replacement_policy_obj;
    delete _L2_cache_hash_fn_obj;
+   delete _L2_cache_prefetcher;
 }
 
 void
@@ -145,6 +158,9 @@ L2CacheCntlr::allocateCacheLine(IntPtr address, ShL2CacheLineInfo* L2_cache_line
       __attribute(__unused__) DirectoryEntry* evicted_directory_entry = evicted_cache_line_info.getDirectoryEntry();
       LOG_ASSERT_ERROR(evicted_directory_entry, "Cant find directory entry for address(%#lx)", evicted_address);
 
+      if (_L2_cache_prefetcher)
+         _L2_cache_prefetcher->recordEviction(evicted_address);
+
       bool msg_modeled = Config::getSingleton()->isApplicationTile(getTileId());
       UInt64 eviction_time = getShmemPerfModel()->getCycleCount();
       
@@ -195,6 +211,12 @@ L2CacheCntlr::handleMsgFromL1Cache(tile_id_t sender, ShmemMsg* shmem_msg)
          // Process the request
          processShmemReq(shmem_req);
       }
+      else if (_L2_cache_prefetcher && _L2_cache_prefetcher->isOutstanding(address))
+      {
+         // The request is processed once the prefetch of the line completes
+         _L2_cache_prefetcher->recordLateDemandMiss(address);
+         issuePrefetches(address, shmem_msg->isModeled());
+      }
    }
 
    else if ( (shmem_msg_type == ShmemMsg::INV_REP) || (shmem_msg_type == ShmemMsg::FLUSH_REP) || (shmem_msg_type == ShmemMsg::WB_REP) )
@@ -249,8 +271,21 @@ L2CacheCntlr::handleMsgFromDram(tile_id_t sender, ShmemMsg* shmem_msg)
    ShL2CacheLineInfo L2_cache_line_info;
    getCacheLineInfo(address, &L2_cache_line_info);
 
-   // Write the data into the L2 cache if it is a SH_REQ
    ShmemReq* shmem_req = _L2_cache_req_queue_list.front(address);
+   if (TYPE(shmem_req) == ShmemMsg::PREFETCH_REQ)
+   {
+      writeCacheLine(address, shmem_msg->getDataBuf());
+      L2_cache_line_info.setCState(CacheState::CLEAN);
+      setCacheLineInfo(address, &L2_cache_line_info);
+
+      _L2_cache_prefetcher->recordFill(address, getShmemPerfModel()->getCycleCount());
+
+      // Requests that arrived during the prefetch now find the line in the L2 cache
+      processNextReqFromL1Cache(address);
+      return;
+   }
+
+   // Write the data into the L2 cache if it is a SH_REQ
    if (TYPE(shmem_req) == ShmemMsg::SH_REQ)
       writeCacheLine(address, shmem_msg->getDataBuf());
    else
@@ -302,6 +337,11 @@ void
 L2CacheCntlr::processShmemReq(ShmemReq* shmem_req)
 {
    ShmemMsg::Type msg_type = TYPE(shmem_req);
+   IntPtr address = shmem_req->getShmemMsg()->getAddress();
+   bool msg_modeled = shmem_req->getShmemMsg()->isModeled();
+
+   // Train on the request before it allocates the cache line
+   bool issue_prefetches = _L2_cache_prefetcher && trainPrefetcher(shmem_req);
 
    // Process the request
    switch (msg_type)
@@ -316,6 +356,88 @@ L2CacheCntlr::processShmemReq(ShmemReq* shmem_req)
       LOG_PRINT_ERROR("Unrecognized Shmem Msg Type(%u)", TYPE(shmem_req));
       break;
    }
+
+   // The request may have completed (and been deleted) by now
+   if (issue_prefetches)
+      issuePrefetches(address, msg_modeled);
+}
+
+bool
+L2CacheCntlr::trainPrefetcher(ShmemReq* shmem_req)
+{
+   IntPtr address = shmem_req->getShmemMsg()->getAddress();
+
+   ShL2CacheLineInfo L2_cache_line_info;
+   _L2_cache->getCacheLineInfo(address, &L2_cache_line_info);
+
+   if (L2_cache_line_info.getCState() == CacheState::INVALID)
+   {
+      _L2_cache_prefetcher->recordDemandMiss();
+      return true;
+   }
+
+   // Only accesses to prefetched lines train the prefetcher further
+   UInt64 curr_time = getShmemPerfModel()->getCycleCount();
+   if (!_L2_cache_prefetcher->recordDemandAccess(address, curr_time))
+      return false;
+
+   shmem_req->updateTime(curr_time);
+   getShmemPerfModel()->updateCycleCount(shmem_req->getTime());
+   return true;
+}
+
+void
+L2CacheCntlr::issuePrefetches(IntPtr address, bool msg_modeled)
+{
+   vector<IntPtr> prefetch_list;
+   _L2_cache_prefetcher->train(address, prefetch_list);
+
+   for (vector<IntPtr>::iterator it = prefetch_list.begin(); it != prefetch_list.end(); it++)
+   {
+      IntPtr prefetch_address = *it;
+
+      // A slice can only fill the lines it is the home of (the candidates
+      // are spread over all the slices with a hashed interleaving)
+      if (getL2CacheHome(prefetch_address) != getTileId())
+         continue;
+      if (!_L2_cache_req_queue_list.empty(prefetch_address))
+         continue;
+      // Lines waiting on DRAM cannot be replaced, so bound the number of
+      // outstanding prefetches to keep a set from filling up with them
+      if (_L2_cache_prefetcher->getNumOutstanding() >= (_L2_cache->getAssociativity() / 2))
+         break;
+
+      ShL2CacheLineInfo L2_cache_line_info;
+      _L2_cache->getCacheLineInfo(prefetch_address, &L2_cache_line_info);
+      if (L2_cache_line_info.getCState() != CacheState::INVALID)
+         continue;
+
+      // Create a prefetch req and add it onto the queue so that requests
+      // from the L1 caches wait for the line
+      ShmemMsg prefetch_msg(ShmemMsg::PREFETCH_REQ, MemComponent::L2_CACHE, MemComponent::L2_CACHE,
+                            getTileId(), false, prefetch_address,
+                            msg_modeled);
+      ShmemReq* prefetch_req = new ShmemReq(&prefetch_msg, getShmemPerfModel()->getCycleCount());
+      _L2_cache_req_queue_list.enqueue(prefetch_address, prefetch_req);
+      _L2_cache_prefetcher->recordIssue(prefetch_address);
+
+      processPrefetchReq(prefetch_req);
+   }
+}
+
+void
+L2CacheCntlr::processPrefetchReq(ShmemReq* prefetch_req)
+{
+   IntPtr address = prefetch_req->getShmemMsg()->getAddress();
+   tile_id_t requester = prefetch_req->getShmemMsg()->getRequester();
+   bool msg_modeled = prefetch_req->getShmemMsg()->isModeled();
+
+   // Allocate the cache line and fetch it from DRAM
+   ShL2CacheLineInfo L2_cache_line_info;
+   getCacheLineInfo(address, &L2_cache_line_info);
+   assert(L2_cache_line_info.getCState() == CacheState::DATA_INVALID);
+
+   fetchDataFromDram(address, requester, msg_modeled);
 }
 
 void
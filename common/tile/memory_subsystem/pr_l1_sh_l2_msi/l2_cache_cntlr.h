@@ -21,6 +21,7 @@ using std::map;
 #include "shmem_perf_model.h"
 #include "cache_replacement_policy.h"
 #include "cache_hash_fn.h"
+#include "prefetcher.h"
 
 namespace PrL1ShL2MSI
 {
@@ -28,6 +29,7 @@ namespace PrL1ShL2MSI
    {
    public:
       L2CacheCntlr(MemoryManager* memory_manager,
+                   AddressHomeLookup* L2_cache_home_lookup,
                    AddressHomeLookup* dram_home_lookup,
                    UInt32 cache_line_size,
                    UInt32 L2_cache_size,
@@ -35,10 +37,15 @@ namespace PrL1ShL2MSI
                    string L2_cache_replacement_policy,
                    UInt32 L2_cache_access_delay,
                    bool L2_cache_track_miss_types,
+                   string L2_cache_prefetcher_type,
+                   UInt32 L2_cache_prefetcher_degree,
+                   UInt32 L2_cache_prefetcher_table_size,
                    float frequency);
       ~L2CacheCntlr();
 
       Cache* getL2Cache() { return _L2_cache; }
+      // NULL if the L2 cache has no prefetcher
+      Prefetcher* getPrefetcher() { return _L2_cache_prefetcher; }
 
       // Handle message from L1 Cache
       void handleMsgFromL1Cache(tile_id_t sender, ShmemMsg* shmem_msg);
@@ -56,6 +63,8 @@ namespace PrL1ShL2MSI
       Cache* _L2_cache;
       CacheReplacementPolicy* _L2_cache_replacement_policy_obj;
       CacheHashFn* _L2_cache_hash_fn_obj;
+      Prefetcher* _L2_cache_prefetcher;
+      AddressHomeLookup* _L2_cache_home_lookup;
       AddressHomeLookup* _dram_home_lookup;
 
       // Is enabled?
@@ -76,6 +85,10 @@ namespace PrL1ShL2MSI
 
       // Process Request to invalidate the sharers of a cache line
       void processNullifyReq(ShmemReq* nullify_req, Byte* data_buf);
+      // Prefetching
+      bool trainPrefetcher(ShmemReq* shmem_req);
+      void issuePrefetches(IntPtr address, bool msg_modeled);
+      void processPrefetchReq(ShmemReq* prefetch_req);
       // Process Request from L1-I/L1-D caches
       void processExReqFromL1Cache(ShmemReq* shmem_req, Byte* data_buf, bool first_call = false);
       void processShReqFromL1Cache(ShmemReq* shmem_req, Byte* data_buf, bool first_call = false);
@@ -110,7 +123,8 @@ namespace PrL1ShL2MSI
       ShmemPerfModel* getShmemPerfModel();
       Core::mem_op_t getMemOpTypeFromShmemMsgType(ShmemMsg::Type shmem_msg_type);
 
-      // Dram Home Lookup
+      // L2 Cache and Dram Home Lookup
+      tile_id_t getL2CacheHome(IntPtr address) { return _L2_cache_home_lookup->getHome(address); }
       tile_id_t getDramHome(IntPtr address) { return _dram_home_lookup->getHome(address); }
    };
 
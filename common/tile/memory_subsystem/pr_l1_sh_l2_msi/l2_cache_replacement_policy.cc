@@ -27,7 +27,7 @@ L2CacheReplacementPolicy::getReplacementWay(CacheLineInfo** cache_line_info_arra
 
    for (UInt32 i = 0; i < _associativity; i++)
    {
-      ShL2CacheLineInfo* L2_cache_line_info = dynamic_cast<ShL2CacheLineInfo*>(cache_line_info_array[i]);
+      ShL2CacheLineInfo* L2_cache_line_info = static_cast<ShL2CacheLineInfo*>(cache_line_info_array[i]);
 
       if (L2_cache_line_info->getCState() == CacheState::INVALID)
       {
@@ -51,7 +51,7 @@ L2CacheReplacementPolicy::getReplacementWay(CacheLineInfo** cache_line_info_arra
    {
       for (UInt32 i = 0; i < _associativity; i++)
       {
-         ShL2CacheLineInfo* L2_cache_line_info = dynamic_cast<ShL2CacheLineInfo*>(cache_line_info_array[i]);
+         ShL2CacheLineInfo* L2_cache_line_info = static_cast<ShL2CacheLineInfo*>(cache_line_info_array[i]);
          assert(L2_cache_line_info->getCState() != CacheState::INVALID);
          IntPtr address = getAddressFromTag(L2_cache_line_info->getTag());
          DirectoryEntry* directory_entry = L2_cache_line_info->getDirectoryEntry();
@@ -1,3 +1,5 @@
+#include <cstring>
+
 #include "memory_manager.h"
 #include "cache.h"
 #include "simulator.h"
@@ -14,6 +16,7 @@ MemoryManager::MemoryManager(Tile* tile, Network* network, ShmemPerfModel* shmem
    : ::MemoryManager(tile, network, shmem_perf_model)
    , _dram_cntlr(NULL)
    , _dram_cntlr_present(false)
+   , _sim_thread_holds_lock(false)
    , _enabled(false)
 {
    // Read Parameters from the Config file
@@ -36,6 +39,7 @@ MemoryManager::MemoryManager(Tile* tile, Network* network, ShmemPerfModel* shmem
    UInt32 L1_dcache_tags_access_time = 0;
    std::string L1_dcache_perf_model_type;
    bool L1_dcache_track_miss_types = false;
+   UInt32 L1_dcache_num_mshrs = 0;
 
    std::string L2_cache_type;
    UInt32 L2_cache_line_size = 0;
@@ -46,6 +50,9 @@ MemoryManager::MemoryManager(Tile* tile, Network* network, ShmemPerfModel* shmem
    UInt32 L2_cache_tags_access_time = 0;
    std::string L2_cache_perf_model_type;
    bool L2_cache_track_miss_types = false;
+   std::string L2_cache_prefetcher_type;
+   UInt32 L2_cache_prefetcher_degree = 0;
+   UInt32 L2_cache_prefetcher_table_size = 0;
 
    // L2 Directory
    SInt32 L2_directory_max_num_sharers = 0;
@@ -81,6 +88,7 @@ MemoryManager::MemoryManager(Tile* tile, Network* network, ShmemPerfModel* shmem
       L1_dcache_tags_access_time = Sim()->getCfg()->getInt(L1_dcache_type + "/tags_access_time");
       L1_dcache_perf_model_type = Sim()->getCfg()->getString(L1_dcache_type + "/perf_model_type");
       L1_dcache_track_miss_types = Sim()->getCfg()->getBool(L1_dcache_type + "/track_miss_types");
+      L1_dcache_num_mshrs = Sim()->getCfg()->getInt(L1_dcache_type + "/num_mshrs");
 
       // L2 Cache
       L2_cache_type = "l2_cache/" + Config::getSingleton()->getL2CacheType(getTile()->getId());
@@ -92,6 +100,9 @@ MemoryManager::MemoryManager(Tile* tile, Network* network, ShmemPerfModel* shmem
       L2_cache_tags_access_time = Sim()->getCfg()->getInt(L2_cache_type + "/tags_access_time");
       L2_cache_perf_model_type = Sim()->getCfg()->getString(L2_cache_type + "/perf_model_type");
       L2_cache_track_miss_types = Sim()->getCfg()->getBool(L2_cache_type + "/track_miss_types");
+      L2_cache_prefetcher_type = Sim()->getCfg()->getString(L2_cache_type + "/prefetcher", "none");
+      L2_cache_prefetcher_degree = Sim()->getCfg()->getInt(L2_cache_type + "/prefetcher_degree", 2);
+      L2_cache_prefetcher_table_size = Sim()->getCfg()->getInt(L2_cache_type + "/prefetcher_table_size", 16);
 
       // Directory
       L2_directory_max_num_sharers = Sim()->getConfig()->getTotalTiles();
@@ -123,6 +134,10 @@ MemoryManager::MemoryManager(Tile* tile, Network* network, ShmemPerfModel* shmem
    
    _cache_line_size = L1_icache_line_size;
 
+   // Msgs are encoded as the ShmemMsg followed by at most one cache line
+   _msg_buf_size = sizeof(ShmemMsg) + _cache_line_size;
+   _send_msg_buf = new Byte[_msg_buf_size];
+
    float core_frequency = Config::getSingleton()->getCoreFrequency(Tile::getMainCoreId(getTile()->getId()));
    
    UInt32 dram_home_lookup_param = ceilLog2(_cache_line_size);
@@ -141,6 +156,7 @@ MemoryManager::MemoryManager(Tile* tile, Network* network, ShmemPerfModel* shmem
       _dram_cntlr_present = true;
 
       _dram_cntlr = new DramCntlr(this,
+            _dram_home_lookup,
             dram_latency,
             per_dram_controller_bandwidth,
             dram_queue_model_enabled,
@@ -167,10 +183,12 @@ MemoryManager::MemoryManager(Tile* tile, Network* network, ShmemPerfModel* shmem
          L1_dcache_replacement_policy,
          L1_dcache_data_access_time,
          L1_dcache_track_miss_types,
+         L1_dcache_num_mshrs,
          core_frequency);
    
    // Instantiate L2 cache cntlr
    _L2_cache_cntlr = new L2CacheCntlr(this,
+         _L2_cache_home_lookup,
          _dram_home_lookup,
          getCacheLineSize(),
          L2_cache_size,
@@ -178,6 +196,9 @@ MemoryManager::MemoryManager(Tile* tile, Network* network, ShmemPerfModel* shmem
          L2_cache_replacement_policy,
          L2_cache_data_access_time,
          L2_cache_track_miss_types,
+         L2_cache_prefetcher_type,
+         L2_cache_prefetcher_degree,
+         L2_cache_prefetcher_table_size,
          core_frequency);
 
    // Create Cache Performance Models
@@ -214,6 +235,10 @@ MemoryManager::~MemoryManager()
    {
       delete _dram_cntlr;
    }
+
+   delete [] _send_msg_buf;
+   for (std::vector<Byte*>::iterator it = _free_msg_buf_list.begin(); it != _free_msg_buf_list.end(); it++)
+      delete [] (*it);
 }
 
 bool
@@ -243,22 +268,39 @@ MemoryManager::coreInitiateMemoryAccess(MemComponent::Type mem_component,
 void
 MemoryManager::handleMsgFromNetwork(NetPacket& packet)
 {
-   core_id_t sender = packet.sender;
    ShmemMsg* shmem_msg = ShmemMsg::getShmemMsg((Byte*) packet.data);
-   UInt64 msg_time = packet.time;
 
+   _lock.acquire();
+   _sim_thread_holds_lock = true;
+
+   handleMsg(packet.sender, packet.receiver, shmem_msg, packet.time);
+
+   // Msgs this tile sent to itself while handling the above
+   while (!_local_msg_queue.empty())
+   {
+      LocalMsg local_msg = _local_msg_queue.front();
+      _local_msg_queue.pop();
+      core_id_t tile_core_id = Tile::getMainCoreId(getTile()->getId());
+      handleMsg(tile_core_id, tile_core_id, ShmemMsg::getShmemMsg(local_msg.second), local_msg.first);
+      releaseMsgBuf(local_msg.second);
+   }
+
+   _sim_thread_holds_lock = false;
+   _lock.release();
+}
+
+void
+MemoryManager::handleMsg(core_id_t sender, core_id_t receiver, ShmemMsg* shmem_msg, UInt64 msg_time)
+{
    MemComponent::Type receiver_mem_component = shmem_msg->getReceiverMemComponent();
    MemComponent::Type sender_mem_component = shmem_msg->getSenderMemComponent();
 
-   // Acquire lock
-   _lock.acquire();
-
    getShmemPerfModel()->setCycleCount(msg_time);
 
    LOG_PRINT("Time(%llu), Got Shmem Msg: type(%i), address(%#lx), sender_mem_component(%u), receiver_mem_component(%u), sender(%i,%i), receiver(%i,%i), modeled(%s)", 
          msg_time, shmem_msg->getType(), shmem_msg->getAddress(),
          sender_mem_component, receiver_mem_component,
-         sender.tile_id, sender.core_type, packet.receiver.tile_id, packet.receiver.core_type,
+         sender.tile_id, sender.core_type, receiver.tile_id, receiver.core_type,
          shmem_msg->isModeled() ? "TRUE" : "FALSE");
 
    switch (receiver_mem_component)
@@ -313,19 +355,6 @@ MemoryManager::handleMsgFromNetwork(NetPacket& packet)
       LOG_PRINT_ERROR("Unrecognized receiver component(%u)", receiver_mem_component);
       break;
    }
-
-   // Delete the allocated Shared Memory Message
-   // First delete 'data_buf' if it is present
-
-   if (shmem_msg->getDataLength() > 0)
-   {
-      assert(shmem_msg->getDataBuf());
-      delete [] shmem_msg->getDataBuf();
-   }
-   delete shmem_msg;
-
-   // Release lock
-   _lock.release();
 }
 
 void
@@ -335,7 +364,6 @@ MemoryManager::sendMsg(tile_id_t receiver, ShmemMsg& shmem_msg)
                     "Address(%#lx), Type(%u), Sender Component(%u), Receiver Component(%u)",
                     shmem_msg.getAddress(), shmem_msg.getType(), shmem_msg.getSenderMemComponent(), shmem_msg.getReceiverMemComponent());
 
-   Byte* msg_buf = shmem_msg.makeMsgBuf();
    UInt64 msg_time = getShmemPerfModel()->getCycleCount();
 
    LOG_PRINT("Time(%llu), Sending Msg: type(%u), address(%#lx), sender_mem_component(%u), receiver_mem_component(%u), requester(%i), sender(%i), receiver(%i), modeled(%s)",
@@ -346,13 +374,52 @@ MemoryManager::sendMsg(tile_id_t receiver, ShmemMsg& shmem_msg)
 
    PacketType packet_type = getPacketType(shmem_msg.getSenderMemComponent(), shmem_msg.getReceiverMemComponent());
 
+   if ( (receiver == getTile()->getId()) && _sim_thread_holds_lock )
+   {
+      sendLocalMsg(packet_type, shmem_msg, msg_time);
+      return;
+   }
+
+   shmem_msg.makeMsgBuf(_send_msg_buf);
+
    NetPacket packet(msg_time, packet_type,
          getTile()->getId(), receiver,
-         shmem_msg.getMsgLen(), (const void*) msg_buf);
+         shmem_msg.getMsgLen(), (const void*) _send_msg_buf);
    getNetwork()->netSend(packet);
+}
+
+void
+MemoryManager::sendLocalMsg(PacketType packet_type, ShmemMsg& shmem_msg, UInt64 msg_time)
+{
+   // The receiver is this tile's sim thread, i.e., the caller. Queue the
+   // encoded msg for handleMsgFromNetwork() instead of going through the transport layer
+   Byte* msg_buf = allocateMsgBuf();
+   shmem_msg.makeMsgBuf(msg_buf);
+
+   // Charge the latency the network model assigns to a packet sent to self
+   NetPacket packet(msg_time, packet_type,
+         getTile()->getId(), getTile()->getId(),
+         shmem_msg.getMsgLen(), (const void*) msg_buf);
+   getNetwork()->modelLocalDelivery(packet);
 
-   // Delete the Msg Buf
-   delete [] msg_buf;
+   _local_msg_queue.push(LocalMsg(packet.time, msg_buf));
+}
+
+Byte*
+MemoryManager::allocateMsgBuf()
+{
+   if (_free_msg_buf_list.empty())
+      return new Byte[_msg_buf_size];
+
+   Byte* msg_buf = _free_msg_buf_list.back();
+   _free_msg_buf_list.pop_back();
+   return msg_buf;
+}
+
+void
+MemoryManager::releaseMsgBuf(Byte* msg_buf)
+{
+   _free_msg_buf_list.push_back(msg_buf);
 }
 
 void
@@ -360,7 +427,7 @@ MemoryManager::broadcastMsg(ShmemMsg& shmem_msg)
 {
    assert((shmem_msg.getDataBuf() == NULL) == (shmem_msg.getDataLength() == 0));
 
-   Byte* msg_buf = shmem_msg.makeMsgBuf();
+   shmem_msg.makeMsgBuf(_send_msg_buf);
    UInt64 msg_time = getShmemPerfModel()->getCycleCount();
 
    LOG_PRINT("Time(%llu), Broadcasting Msg: type(%u), address(%#llx), sender_mem_component(%u), receiver_mem_component(%u), requester(%i), sender(%i), modeled(%s)",
@@ -373,11 +440,8 @@ MemoryManager::broadcastMsg(ShmemMsg& shmem_msg)
 
    NetPacket packet(msg_time, packet_type,
          getTile()->getId(), NetPacket::BROADCAST,
-         shmem_msg.getMsgLen(), (const void*) msg_buf);
+         shmem_msg.getMsgLen(), (const void*) _send_msg_buf);
    getNetwork()->netSend(packet);
-
-   // Delete the Msg Buf
-   delete [] msg_buf;
 }
 
 PacketType
@@ -483,16 +547,23 @@ MemoryManager::outputSummary(std::ostream &os)
    os << "Cache Summary:\n";
    _L1_cache_cntlr->getL1ICache()->outputSummary(os);
    _L1_cache_cntlr->getL1DCache()->outputSummary(os);
+   _L1_cache_cntlr->getL1DCacheMSHR()->outputSummary(os);
    _L2_cache_cntlr->getL2Cache()->outputSummary(os);
+   if (_L2_cache_cntlr->getPrefetcher())
+      _L2_cache_cntlr->getPrefetcher()->outputSummary(os);
 
    if (_dram_cntlr_present)
    {
-      _dram_cntlr->getDramPerfModel()->outputSummary(os);
+      _dram_cntlr->outputSummary(os);
    }
    else
    {
-      DramPerfModel::dummyOutputSummary(os);
+      DramCntlr::dummyOutputSummary(os);
    }
+
+   os << "Thread Handoff Summary:\n";
+   _app_thread_sem.outputSummary(os, "App Thread");
+   _sim_thread_sem.outputSummary(os, "Sim Thread");
 }
 
 void
@@ -500,11 +571,13 @@ MemoryManager::waitForAppThread()
 {
    _sim_thread_sem.wait();
    _lock.acquire();
+   _sim_thread_holds_lock = true;
 }
 
 void
 MemoryManager::wakeUpAppThread()
 {
+   _sim_thread_holds_lock = false;
    _lock.release();
    _app_thread_sem.signal();
 }
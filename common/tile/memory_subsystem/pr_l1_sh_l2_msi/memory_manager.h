@@ -1,5 +1,8 @@
 #pragma once
 
+#include <queue>
+#include <vector>
+
 #include <iostream>
 #include <fstream>
 using std::ofstream;
@@ -12,7 +15,7 @@ using std::ofstream;
 #include "address_home_lookup.h"
 #include "shmem_msg.h"
 #include "mem_component.h"
-#include "semaphore.h"
+#include "adaptive_semaphore.h"
 #include "fixed_types.h"
 #include "shmem_perf_model.h"
 #include "network.h"
@@ -28,6 +31,7 @@ namespace PrL1ShL2MSI
       UInt32 getCacheLineSize() { return _cache_line_size; }
 
       Cache* getL1ICache() { return _L1_cache_cntlr->getL1ICache(); }
+      UInt64 getL1ICacheHitLatency() { return _L1_icache_perf_model->getLatency(CachePerfModel::ACCESS_CACHE_DATA_AND_TAGS); }
       Cache* getL1DCache() { return _L1_cache_cntlr->getL1DCache(); }
       Cache* getL2Cache() { return _L2_cache_cntlr->getL2Cache(); }
       DramCntlr* getDramCntlr() { return _dram_cntlr; }
@@ -76,8 +80,20 @@ namespace PrL1ShL2MSI
 
       // App + Sim thread Synchronization
       Lock _lock;
-      Semaphore _app_thread_sem;
-      Semaphore _sim_thread_sem;
+      AdaptiveSemaphore _app_thread_sem;
+      AdaptiveSemaphore _sim_thread_sem;
+      // Is the sim thread the current holder of _lock ?
+      bool _sim_thread_holds_lock;
+
+      // Msgs the sim thread sent to its own tile (local-home fast path),
+      // tagged with their receive time
+      typedef std::pair<UInt64,Byte*> LocalMsg;
+      std::queue<LocalMsg> _local_msg_queue;
+
+      // Encoded msg buffers (see ShmemMsg::makeMsgBuf())
+      UInt32 _msg_buf_size;
+      Byte* _send_msg_buf;
+      std::vector<Byte*> _free_msg_buf_list;
 
       // Performance Models
       CachePerfModel* _L1_icache_perf_model;
@@ -91,5 +107,10 @@ namespace PrL1ShL2MSI
 
       // Get Packet Type for a message
       PacketType getPacketType(MemComponent::Type sender_mem_component, MemComponent::Type receiver_mem_component);
+
+      void handleMsg(core_id_t sender, core_id_t receiver, ShmemMsg* shmem_msg, UInt64 msg_time);
+      void sendLocalMsg(PacketType packet_type, ShmemMsg& shmem_msg, UInt64 msg_time);
+      Byte* allocateMsgBuf();
+      void releaseMsgBuf(Byte* msg_buf);
    };
 }
@@ -84,28 +84,22 @@ ShmemMsg::clone(const ShmemMsg* shmem_msg)
 ShmemMsg*
 ShmemMsg::getShmemMsg(Byte* msg_buf)
 {
-   ShmemMsg* shmem_msg = new ShmemMsg();
-   memcpy((void*) shmem_msg, msg_buf, sizeof(*shmem_msg));
+   // Decoded in place: the line data (if any) follows the msg in the buffer
+   ShmemMsg* shmem_msg = (ShmemMsg*) msg_buf;
    if (shmem_msg->getDataLength() > 0)
-   {
-      shmem_msg->setDataBuf(new Byte[shmem_msg->getDataLength()]);
-      memcpy((void*) shmem_msg->getDataBuf(), msg_buf + sizeof(*shmem_msg), shmem_msg->getDataLength());
-   }
+      shmem_msg->setDataBuf(msg_buf + sizeof(*shmem_msg));
    return shmem_msg;
 }
 
-Byte*
-ShmemMsg::makeMsgBuf()
+void
+ShmemMsg::makeMsgBuf(Byte* msg_buf)
 {
-   Byte* msg_buf = new Byte[getMsgLen()];
    memcpy(msg_buf, (void*) this, sizeof(*this));
    if (_data_length > 0)
    {
       LOG_ASSERT_ERROR(_data_buf != NULL, "_data_buf(%p)", _data_buf);
       memcpy(msg_buf + sizeof(*this), (void*) _data_buf, _data_length); 
    }
-
-   return msg_buf; 
 }
 
 UInt32
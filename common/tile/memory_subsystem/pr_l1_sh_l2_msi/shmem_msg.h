@@ -31,7 +31,9 @@ public:
       DRAM_FETCH_REP,
       // Nullify req
       NULLIFY_REQ,
-      MAX_MSG_TYPE = NULLIFY_REQ,
+      // Prefetch req (internal to the L2 cache, like NULLIFY_REQ)
+      PREFETCH_REQ,
+      MAX_MSG_TYPE = PREFETCH_REQ,
       NUM_MSG_TYPES = MAX_MSG_TYPE - MIN_MSG_TYPE + 1
    }; 
 
@@ -58,8 +60,10 @@ public:
    ~ShmemMsg();
 
    void clone(const ShmemMsg* shmem_msg);
+   // Wire format: the msg followed by its line data (getMsgLen() bytes)
+   // getShmemMsg() decodes a buffer in place (the msg aliases msg_buf)
    static ShmemMsg* getShmemMsg(Byte* msg_buf);
-   Byte* makeMsgBuf();
+   void makeMsgBuf(Byte* msg_buf);
    UInt32 getMsgLen();
 
    // Modeled Parameters
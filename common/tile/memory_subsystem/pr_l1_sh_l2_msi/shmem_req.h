@@ -14,15 +14,17 @@ public:
    ShmemReq(ShmemMsg* shmem_msg, UInt64 time);
    ~ShmemReq();
 
-   ShmemMsg* getShmemMsg() const
-   { return _shmem_msg; }
+   ShmemMsg* getShmemMsg()
+   { return &_shmem_msg; }
+   const ShmemMsg* getShmemMsg() const
+   { return &_shmem_msg; }
    UInt64 getTime() const
    { return _time; }
    void updateTime(UInt64 time)
    { if (time > _time) _time = time; }
 
 private:
-   ShmemMsg* _shmem_msg;
+   ShmemMsg _shmem_msg;
    UInt64 _time;
 };
 
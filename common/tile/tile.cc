@@ -71,27 +71,37 @@ void Tile::outputSummary(std::ostream &os)
 void Tile::enablePerformanceModels()
 {
    LOG_PRINT("enablePerformanceModels(%i) start", m_tile_id);
+   enableMemoryAndNetworkModels();
+   getCore()->getPerformanceModel()->enable();
+   LOG_PRINT("enablePerformanceModels(%i) end", m_tile_id);
+}
+
+void Tile::disablePerformanceModels()
+{
+   LOG_PRINT("disablePerformanceModels(%i) start", m_tile_id);
+   disableMemoryAndNetworkModels();
+   getCore()->getPerformanceModel()->disable();
+   LOG_PRINT("disablePerformanceModels(%i) end", m_tile_id);
+}
+
+void Tile::enableMemoryAndNetworkModels()
+{
    if (getCore()->getClockSkewMinimizationClient())
       getCore()->getClockSkewMinimizationClient()->enable();
 
    getNetwork()->enableModels();
    getCore()->getShmemPerfModel()->enable();
    getCore()->getMemoryManager()->enableModels();
-   getCore()->getPerformanceModel()->enable();
-   LOG_PRINT("enablePerformanceModels(%i) end", m_tile_id);
 }
 
-void Tile::disablePerformanceModels()
+void Tile::disableMemoryAndNetworkModels()
 {
-   LOG_PRINT("disablePerformanceModels(%i) start", m_tile_id);
    if (getCore()->getClockSkewMinimizationClient())
       getCore()->getClockSkewMinimizationClient()->disable();
 
    getNetwork()->disableModels();
    getCore()->getShmemPerfModel()->disable();
    getCore()->getMemoryManager()->disableModels();
-   getCore()->getPerformanceModel()->disable();
-   LOG_PRINT("disablePerformanceModels(%i) end", m_tile_id);
 }
 
 void
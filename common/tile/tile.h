@@ -43,6 +43,9 @@ public:
 
    void enablePerformanceModels();
    void disablePerformanceModels();
+   // All the models but the core model. These also serve the other tiles.
+   void enableMemoryAndNetworkModels();
+   void disableMemoryAndNetworkModels();
 
 private:
    tile_id_t m_tile_id;
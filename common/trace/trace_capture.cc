@@ -0,0 +1,103 @@
+#include "trace_capture.h"
+#include "trace_writer.h"
+#include "simulator.h"
+#include "tile_manager.h"
+#include "tls.h"
+#include "log.h"
+
+TraceCapture::TraceCapture()
+   : m_writer_tls(TLS::create())
+{
+   try
+   {
+      m_directory = Sim()->getCfg()->getString("trace/directory");
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read trace/directory from the cfg file");
+   }
+}
+
+TraceCapture::~TraceCapture()
+{
+   for (std::set<TraceWriter*>::iterator it = m_writers.begin(); it != m_writers.end(); it++)
+      delete *it;
+   delete m_writer_tls;
+}
+
+TraceWriter* TraceCapture::getWriter()
+{
+   TraceWriter *writer = m_writer_tls->get<TraceWriter>();
+   if (writer)
+      return writer;
+
+   TileManager *tile_manager = Sim()->getTileManager();
+   if (!tile_manager->amiAppThread())
+      return NULL;
+
+   thread_id_t thread_id = tile_manager->getCurrentThreadId();
+   writer = new TraceWriter(getTraceFileName(m_directory, thread_id));
+   m_writer_tls->insert<TraceWriter>(writer);
+
+   ScopedLock sl(m_lock);
+   m_writers.insert(writer);
+   return writer;
+}
+
+void TraceCapture::closeTrace()
+{
+   TraceWriter *writer = m_writer_tls->get<TraceWriter>();
+   if (!writer)
+      return;
+
+   // Pin does not erase its TLS entries
+   m_writer_tls->set<TraceWriter>(NULL);
+   m_writer_tls->erase();
+   {
+      ScopedLock sl(m_lock);
+      m_writers.erase(writer);
+   }
+   delete writer;
+}
+
+void TraceCapture::recordBasicBlock(BasicBlock *basic_block)
+{
+   TraceWriter *writer = getWriter();
+   if (writer)
+      writer->writeBasicBlock(basic_block);
+}
+
+void TraceCapture::recordMemoryAccess(UInt8 mem_op_type, UInt8 lock_signal, IntPtr address, UInt32 size)
+{
+   TraceWriter *writer = getWriter();
+   if (writer)
+      writer->writeMemoryAccess(mem_op_type, lock_signal, address, size);
+}
+
+void TraceCapture::recordBranch(bool taken, IntPtr target)
+{
+   TraceWriter *writer = getWriter();
+   if (writer)
+      writer->writeBranch(taken, target);
+}
+
+void TraceCapture::recordSync(TraceSyncType sync_type, SInt32 object, SInt32 argument)
+{
+   TraceWriter *writer = getWriter();
+   if (writer)
+      writer->writeSync(sync_type, object, argument);
+}
+
+void TraceCapture::recordSpawn(thread_id_t thread_id)
+{
+   TraceWriter *writer = getWriter();
+   if (writer)
+      writer->writeSpawn(thread_id);
+}
+
+void TraceCapture::recordJoin(thread_id_t thread_id)
+{
+   TraceWriter *writer = getWriter();
+   if (writer)
+      writer->writeJoin(thread_id);
+}
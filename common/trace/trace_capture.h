@@ -0,0 +1,51 @@
+#ifndef TRACE_CAPTURE_H
+#define TRACE_CAPTURE_H
+
+#include <string>
+#include <set>
+
+#include "fixed_types.h"
+#include "trace_format.h"
+#include "lock.h"
+
+class TLS;
+class TraceWriter;
+class BasicBlock;
+
+// Records the modeled events of each application thread in a trace, so that
+// the timing models can later be run on it without Pin (see trace_format.h)
+//
+// Basic blocks, branches and memory accesses are recorded while the models
+// are enabled, as they are fed to the core models. Sync and thread events are
+// always recorded, since the replay needs all the sync objects and threads.
+class TraceCapture
+{
+public:
+   TraceCapture();
+   ~TraceCapture();
+
+   void recordBasicBlock(BasicBlock *basic_block);
+   void recordMemoryAccess(UInt8 mem_op_type, UInt8 lock_signal, IntPtr address, UInt32 size);
+   void recordBranch(bool taken, IntPtr target);
+   void recordSync(TraceSyncType sync_type, SInt32 object, SInt32 argument = 0);
+   void recordSpawn(thread_id_t thread_id);
+   void recordJoin(thread_id_t thread_id);
+
+   // Called when an application thread exits
+   void closeTrace();
+
+private:
+   // The trace of the current application thread, opened on first use
+   // (NULL for the other threads)
+   TraceWriter* getWriter();
+
+   std::string m_directory;
+
+   TLS *m_writer_tls;
+
+   // Traces still open, closed at the end of the simulation
+   Lock m_lock;
+   std::set<TraceWriter*> m_writers;
+};
+
+#endif
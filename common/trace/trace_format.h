@@ -0,0 +1,67 @@
+#ifndef TRACE_FORMAT_H
+#define TRACE_FORMAT_H
+
+#include <string>
+#include <sstream>
+
+#include "fixed_types.h"
+
+// Binary trace of the modeled events of one application thread
+//
+// The trace of thread <tid> is in "<directory>/thread_<tid>.trace". It starts
+// with TRACE_MAGIC and TRACE_VERSION (UInt32 each), followed by records. A
+// record is a TraceRecordType (UInt8) followed by its fields in host byte order:
+//
+//   TRACE_BASIC_BLOCK_DEFINITION  id (UInt32), num instructions (UInt32), then per instruction:
+//                                 type (UInt8), opcode (UInt32), address (UInt64), size (UInt8),
+//                                 num operands (UInt8), then per operand:
+//                                 type (UInt8), direction (UInt8), value (UInt64)
+//   TRACE_BASIC_BLOCK             id (UInt32)
+//   TRACE_MEMORY_ACCESS           mem op type (UInt8), lock signal (UInt8), size (UInt32), address (UInt64)
+//   TRACE_BRANCH                  taken (UInt8), target (UInt64)
+//   TRACE_SYNC                    sync type (UInt8), object (SInt32), argument (SInt32)
+//   TRACE_SPAWN                   thread id of the child (SInt32)
+//   TRACE_JOIN                    thread id (SInt32)
+//   TRACE_END
+//
+// A basic block is defined the first time it is executed by the thread.
+// Sync objects and threads are identified by the ids they had at capture.
+
+static const UInt32 TRACE_MAGIC = 0x47545243;
+static const UInt32 TRACE_VERSION = 1;
+
+enum TraceRecordType
+{
+   TRACE_BASIC_BLOCK_DEFINITION = 0,
+   TRACE_BASIC_BLOCK,
+   TRACE_MEMORY_ACCESS,
+   TRACE_BRANCH,
+   TRACE_SYNC,
+   TRACE_SPAWN,
+   TRACE_JOIN,
+   TRACE_END
+};
+
+// The argument of a sync record is the mutex of a cond wait and the count
+// of a barrier init
+enum TraceSyncType
+{
+   TRACE_MUTEX_INIT = 0,
+   TRACE_MUTEX_LOCK,
+   TRACE_MUTEX_UNLOCK,
+   TRACE_COND_INIT,
+   TRACE_COND_WAIT,
+   TRACE_COND_SIGNAL,
+   TRACE_COND_BROADCAST,
+   TRACE_BARRIER_INIT,
+   TRACE_BARRIER_WAIT
+};
+
+inline std::string getTraceFileName(const std::string &directory, thread_id_t thread_id)
+{
+   std::ostringstream file_name;
+   file_name << directory << "/thread_" << thread_id << ".trace";
+   return file_name.str();
+}
+
+#endif
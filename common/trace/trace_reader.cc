@@ -0,0 +1,144 @@
+#include "trace_reader.h"
+#include "instruction.h"
+#include "basic_block.h"
+#include "log.h"
+
+TraceReader::TraceReader(const std::string &file_name)
+   : m_file_name(file_name)
+   , m_buffer(new char[BUFFER_SIZE])
+{
+   m_file = fopen(file_name.c_str(), "rb");
+   LOG_ASSERT_ERROR(m_file, "Could not open trace file(%s)", file_name.c_str());
+   setvbuf(m_file, m_buffer, _IOFBF, BUFFER_SIZE);
+
+   UInt32 magic = read<UInt32>();
+   UInt32 version = read<UInt32>();
+   LOG_ASSERT_ERROR(magic == TRACE_MAGIC, "%s is not a trace file", file_name.c_str());
+   LOG_ASSERT_ERROR(version == TRACE_VERSION, "Trace file(%s) has version(%u), expected version(%u)",
+                    file_name.c_str(), version, TRACE_VERSION);
+}
+
+TraceReader::~TraceReader()
+{
+   fclose(m_file);
+   delete [] m_buffer;
+}
+
+void TraceReader::truncated()
+{
+   LOG_PRINT_ERROR("Trace file(%s) is truncated", m_file_name.c_str());
+}
+
+bool TraceReader::read(TraceRecord &record)
+{
+   while (true)
+   {
+      record.type = (TraceRecordType) read<UInt8>();
+
+      switch (record.type)
+      {
+      case TRACE_BASIC_BLOCK_DEFINITION:
+         defineBasicBlock();
+         break;
+
+      case TRACE_BASIC_BLOCK:
+         {
+            UInt32 id = read<UInt32>();
+            LOG_ASSERT_ERROR(id < m_basic_blocks.size() && m_basic_blocks[id],
+                             "Basic block(%u) used before its definition in trace file(%s)", id, m_file_name.c_str());
+            record.basic_block = m_basic_blocks[id];
+         }
+         return true;
+
+      case TRACE_MEMORY_ACCESS:
+         record.mem_op_type = read<UInt8>();
+         record.lock_signal = read<UInt8>();
+         record.size = read<UInt32>();
+         record.address = read<UInt64>();
+         return true;
+
+      case TRACE_BRANCH:
+         record.taken = read<UInt8>();
+         record.target = read<UInt64>();
+         return true;
+
+      case TRACE_SYNC:
+         record.sync_type = (TraceSyncType) read<UInt8>();
+         record.object = read<SInt32>();
+         record.argument = read<SInt32>();
+         return true;
+
+      case TRACE_SPAWN:
+      case TRACE_JOIN:
+         record.thread_id = read<SInt32>();
+         return true;
+
+      case TRACE_END:
+         return false;
+
+      default:
+         LOG_PRINT_ERROR("Unrecognized record type(%u) in trace file(%s)", record.type, m_file_name.c_str());
+         return false;
+      }
+   }
+}
+
+void TraceReader::defineBasicBlock()
+{
+   UInt32 id = read<UInt32>();
+   UInt32 num_instructions = read<UInt32>();
+
+   BasicBlock *basic_block = new BasicBlock();
+
+   for (UInt32 i = 0; i < num_instructions; i++)
+   {
+      InstructionType type = (InstructionType) read<UInt8>();
+      UInt64 opcode = read<UInt32>();
+      IntPtr address = read<UInt64>();
+      UInt32 size = read<UInt8>();
+      UInt32 num_operands = read<UInt8>();
+
+      OperandList list;
+      for (UInt32 j = 0; j < num_operands; j++)
+      {
+         Operand::Type operand_type = (Operand::Type) read<UInt8>();
+         Operand::Direction direction = (Operand::Direction) read<UInt8>();
+         Operand::Value value = read<UInt64>();
+         list.push_back(Operand(operand_type, value, direction));
+      }
+
+      // The instruction classes created by the instrumentation
+      Instruction *instruction = NULL;
+      switch (type)
+      {
+      case INST_GENERIC:
+         instruction = new GenericInstruction(opcode, list);
+         break;
+      case INST_MUL:
+      case INST_DIV:
+      case INST_FMUL:
+      case INST_FDIV:
+         instruction = new ArithInstruction(type, opcode, list);
+         break;
+      case INST_JMP:
+         instruction = new JmpInstruction(opcode, list);
+         break;
+      case INST_BRANCH:
+         instruction = new BranchInstruction(opcode, list);
+         break;
+      default:
+         LOG_PRINT_ERROR("Unexpected instruction type(%u) in trace file(%s)", type, m_file_name.c_str());
+         break;
+      }
+
+      instruction->setAddress(address);
+      instruction->setSize(size);
+      basic_block->push_back(instruction);
+   }
+
+   basic_block->summarize();
+
+   if (id >= m_basic_blocks.size())
+      m_basic_blocks.resize(id + 1, NULL);
+   m_basic_blocks[id] = basic_block;
+}
@@ -0,0 +1,70 @@
+#ifndef TRACE_READER_H
+#define TRACE_READER_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "fixed_types.h"
+#include "trace_format.h"
+
+class BasicBlock;
+
+// An event of the trace of a thread; only the fields of its type are valid
+struct TraceRecord
+{
+   TraceRecordType type;
+
+   // TRACE_BASIC_BLOCK
+   BasicBlock *basic_block;
+   // TRACE_MEMORY_ACCESS
+   UInt8 mem_op_type;
+   UInt8 lock_signal;
+   UInt32 size;
+   IntPtr address;
+   // TRACE_BRANCH
+   bool taken;
+   IntPtr target;
+   // TRACE_SYNC
+   TraceSyncType sync_type;
+   SInt32 object;
+   SInt32 argument;
+   // TRACE_SPAWN, TRACE_JOIN
+   thread_id_t thread_id;
+};
+
+// Reads the trace of one application thread (see trace_format.h)
+class TraceReader
+{
+public:
+   TraceReader(const std::string &file_name);
+   ~TraceReader();
+
+   // Returns false at the end of the trace. Basic block definitions are
+   // handled here and never returned.
+   bool read(TraceRecord &record);
+
+private:
+   static const UInt32 BUFFER_SIZE = 1 << 20;
+
+   template<class T> T read()
+   {
+      T value;
+      if (fread(&value, sizeof(T), 1, m_file) != 1)
+         truncated();
+      return value;
+   }
+   void truncated();
+
+   void defineBasicBlock();
+
+   std::string m_file_name;
+   FILE *m_file;
+   char *m_buffer;
+
+   // The basic blocks are never deleted, since the core model may still be
+   // modeling the last one when the replay of the thread ends
+   std::vector<BasicBlock*> m_basic_blocks;
+};
+
+#endif
@@ -0,0 +1,111 @@
+#include "trace_writer.h"
+#include "instruction.h"
+#include "basic_block.h"
+#include "log.h"
+
+TraceWriter::TraceWriter(const std::string &file_name)
+   : m_file_name(file_name)
+   , m_buffer(new char[BUFFER_SIZE])
+{
+   m_file = fopen(file_name.c_str(), "wb");
+   LOG_ASSERT_ERROR(m_file, "Could not open trace file(%s)", file_name.c_str());
+   setvbuf(m_file, m_buffer, _IOFBF, BUFFER_SIZE);
+
+   write<UInt32>(TRACE_MAGIC);
+   write<UInt32>(TRACE_VERSION);
+}
+
+TraceWriter::~TraceWriter()
+{
+   writeRecordType(TRACE_END);
+
+   if (ferror(m_file))
+      LOG_PRINT_WARNING("Error writing trace file(%s), the trace is incomplete", m_file_name.c_str());
+   fclose(m_file);
+   delete [] m_buffer;
+}
+
+void TraceWriter::writeBasicBlock(BasicBlock *basic_block)
+{
+   BasicBlockIdMap::iterator it = m_basic_block_ids.find(basic_block);
+   UInt32 id;
+   if (it == m_basic_block_ids.end())
+   {
+      id = m_basic_block_ids.size();
+      m_basic_block_ids[basic_block] = id;
+      defineBasicBlock(basic_block, id);
+   }
+   else
+   {
+      id = it->second;
+   }
+
+   writeRecordType(TRACE_BASIC_BLOCK);
+   write<UInt32>(id);
+}
+
+void TraceWriter::defineBasicBlock(BasicBlock *basic_block, UInt32 id)
+{
+   writeRecordType(TRACE_BASIC_BLOCK_DEFINITION);
+   write<UInt32>(id);
+   write<UInt32>(basic_block->size());
+
+   for (UInt32 i = 0; i < basic_block->size(); i++)
+   {
+      Instruction *instruction = basic_block->at(i);
+      const OperandList &ops = instruction->getOperands();
+
+      LOG_ASSERT_ERROR(instruction->getOpcode() <= 0xffffffffULL && instruction->getSize() <= 0xff && ops.size() <= 0xff,
+                       "Can not trace instruction(%#lx): opcode(%llu), size(%u), num operands(%u)",
+                       instruction->getAddress(), instruction->getOpcode(), instruction->getSize(), (UInt32) ops.size());
+
+      write<UInt8>(instruction->getType());
+      write<UInt32>(instruction->getOpcode());
+      write<UInt64>(instruction->getAddress());
+      write<UInt8>(instruction->getSize());
+      write<UInt8>(ops.size());
+
+      for (UInt32 j = 0; j < ops.size(); j++)
+      {
+         write<UInt8>(ops[j].m_type);
+         write<UInt8>(ops[j].m_direction);
+         write<UInt64>(ops[j].m_value);
+      }
+   }
+}
+
+void TraceWriter::writeMemoryAccess(UInt8 mem_op_type, UInt8 lock_signal, IntPtr address, UInt32 size)
+{
+   writeRecordType(TRACE_MEMORY_ACCESS);
+   write<UInt8>(mem_op_type);
+   write<UInt8>(lock_signal);
+   write<UInt32>(size);
+   write<UInt64>(address);
+}
+
+void TraceWriter::writeBranch(bool taken, IntPtr target)
+{
+   writeRecordType(TRACE_BRANCH);
+   write<UInt8>(taken);
+   write<UInt64>(target);
+}
+
+void TraceWriter::writeSync(TraceSyncType sync_type, SInt32 object, SInt32 argument)
+{
+   writeRecordType(TRACE_SYNC);
+   write<UInt8>(sync_type);
+   write<SInt32>(object);
+   write<SInt32>(argument);
+}
+
+void TraceWriter::writeSpawn(thread_id_t thread_id)
+{
+   writeRecordType(TRACE_SPAWN);
+   write<SInt32>(thread_id);
+}
+
+void TraceWriter::writeJoin(thread_id_t thread_id)
+{
+   writeRecordType(TRACE_JOIN);
+   write<SInt32>(thread_id);
+}
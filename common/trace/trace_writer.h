@@ -0,0 +1,47 @@
+#ifndef TRACE_WRITER_H
+#define TRACE_WRITER_H
+
+#include <cstdio>
+#include <string>
+#include <map>
+
+#include "fixed_types.h"
+#include "trace_format.h"
+
+class BasicBlock;
+
+// Writes the trace of one application thread (see trace_format.h)
+// Only the thread being traced uses it, so it is not locked
+class TraceWriter
+{
+public:
+   TraceWriter(const std::string &file_name);
+   ~TraceWriter();
+
+   void writeBasicBlock(BasicBlock *basic_block);
+   void writeMemoryAccess(UInt8 mem_op_type, UInt8 lock_signal, IntPtr address, UInt32 size);
+   void writeBranch(bool taken, IntPtr target);
+   void writeSync(TraceSyncType sync_type, SInt32 object, SInt32 argument = 0);
+   void writeSpawn(thread_id_t thread_id);
+   void writeJoin(thread_id_t thread_id);
+
+private:
+   static const UInt32 BUFFER_SIZE = 1 << 20;
+
+   template<class T> void write(T value)
+   { fwrite(&value, sizeof(T), 1, m_file); }
+   void writeRecordType(TraceRecordType type)
+   { write<UInt8>(type); }
+
+   void defineBasicBlock(BasicBlock *basic_block, UInt32 id);
+
+   std::string m_file_name;
+   FILE *m_file;
+   char *m_buffer;
+
+   // Basic blocks are static, so they are defined once and then referred to by id
+   typedef std::map<BasicBlock*, UInt32> BasicBlockIdMap;
+   BasicBlockIdMap m_basic_block_ids;
+};
+
+#endif
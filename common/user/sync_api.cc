@@ -10,22 +10,33 @@
 #include "config_file.hpp"
 #include "carbon_user.h"
 #include "thread_support_private.h"
+#include "trace_capture.h"
+
+static void recordSync(TraceSyncType sync_type, SInt32 object, SInt32 argument = 0)
+{
+   TraceCapture *trace_capture = Sim()->getTraceCapture();
+   if (trace_capture)
+      trace_capture->recordSync(sync_type, object, argument);
+}
 
 void CarbonMutexInit(carbon_mutex_t *mux)
 {
    Core *core = Sim()->getTileManager()->getCurrentCore();
    core->getSyncClient()->mutexInit(mux);
+   recordSync(TRACE_MUTEX_INIT, *mux);
 }
 
 void CarbonMutexLock(carbon_mutex_t *mux)
 {
    Core *core = Sim()->getTileManager()->getCurrentCore();
+   recordSync(TRACE_MUTEX_LOCK, *mux);
    core->getSyncClient()->mutexLock(mux);
 }
 
 void CarbonMutexUnlock(carbon_mutex_t *mux)
 {
    Core *core = Sim()->getTileManager()->getCurrentCore();
+   recordSync(TRACE_MUTEX_UNLOCK, *mux);
    core->getSyncClient()->mutexUnlock(mux);
 }
 
@@ -33,23 +44,27 @@ void CarbonCondInit(carbon_cond_t *cond)
 {
    Core *core = Sim()->getTileManager()->getCurrentCore();
    core->getSyncClient()->condInit(cond);
+   recordSync(TRACE_COND_INIT, *cond);
 }
 
 void CarbonCondWait(carbon_cond_t *cond, carbon_mutex_t *mux)
 {
    Core *core = Sim()->getTileManager()->getCurrentCore();
+   recordSync(TRACE_COND_WAIT, *cond, *mux);
    core->getSyncClient()->condWait(cond, mux);
 }
 
 void CarbonCondSignal(carbon_cond_t *cond)
 {
    Core *core = Sim()->getTileManager()->getCurrentCore();
+   recordSync(TRACE_COND_SIGNAL, *cond);
    core->getSyncClient()->condSignal(cond);
 }
 
 void CarbonCondBroadcast(carbon_cond_t *cond)
 {
    Core *core = Sim()->getTileManager()->getCurrentCore();
+   recordSync(TRACE_COND_BROADCAST, *cond);
    core->getSyncClient()->condBroadcast(cond);
 }
 
@@ -57,10 +72,12 @@ void CarbonBarrierInit(carbon_barrier_t *barrier, UInt32 count)
 {
    Core *core = Sim()->getTileManager()->getCurrentCore();
    core->getSyncClient()->barrierInit(barrier, count);
+   recordSync(TRACE_BARRIER_INIT, *barrier, count);
 }
 
 void CarbonBarrierWait(carbon_barrier_t *barrier)
 {
    Core *core = Sim()->getTileManager()->getCurrentCore();
+   recordSync(TRACE_BARRIER_WAIT, *barrier);
    core->getSyncClient()->barrierWait(barrier);
 }
@@ -11,6 +11,7 @@
 #include "config_file.hpp"
 #include "carbon_user.h"
 #include "thread_support_private.h"
+#include "trace_capture.h"
 
 // FIXME: Pthread wrappers are untested.
 int CarbonPthreadCreate(pthread_t *tid, int *attr, thread_func_t func, void *arg)
@@ -32,12 +33,17 @@ int CarbonPthreadJoin(pthread_t tid, void **pparg)
 carbon_thread_t CarbonSpawnThread(thread_func_t func, void *arg)
 {
    carbon_thread_t tid = Sim()->getThreadManager()->spawnThread(INVALID_TILE_ID, func, arg);
+   if (Sim()->getTraceCapture())
+      Sim()->getTraceCapture()->recordSpawn(tid);
    return tid;
 }
 
 carbon_thread_t CarbonSpawnThreadOnTile(tile_id_t tile_id, thread_func_t func, void *arg)
 {
-   return Sim()->getThreadManager()->spawnThread(tile_id, func, arg);
+   carbon_thread_t tid = Sim()->getThreadManager()->spawnThread(tile_id, func, arg);
+   if (Sim()->getTraceCapture())
+      Sim()->getTraceCapture()->recordSpawn(tid);
+   return tid;
 }
 
 
@@ -53,6 +59,8 @@ bool CarbonSchedGetAffinity(thread_id_t thread_id, UInt32 cpusetsize, cpu_set_t*
 
 void CarbonJoinThread(carbon_thread_t tid)
 {
+   if (Sim()->getTraceCapture())
+      Sim()->getTraceCapture()->recordJoin(tid);
    Sim()->getThreadManager()->joinThread(tid);
 }
 
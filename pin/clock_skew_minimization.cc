@@ -2,6 +2,7 @@
 #include "simulator.h"
 #include "tile_manager.h"
 #include "tile.h"
+#include "core_model.h"
 #include "clock_skew_minimization_object.h"
 
 static bool enabled()
@@ -23,6 +24,10 @@ void handlePeriodicSync()
       return;
    }
 
+   // With sampling, the core model is disabled in functional warming
+   if (!core->getPerformanceModel()->isEnabled())
+      return;
+
    ClockSkewMinimizationClient *client = core->getClockSkewMinimizationClient();
    if (client)
       client->synchronize();
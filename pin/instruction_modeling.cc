@@ -5,12 +5,26 @@
 #include "opcodes.h"
 #include "tile_manager.h"
 #include "tile.h"
+#include "sampling_controller.h"
+#include "trace_capture.h"
 
 void handleBasicBlock(BasicBlock *sim_basic_block)
 {
+   // Functional warming runs with the models disabled, so count first
+   SamplingController *sampling_controller = Sim()->getSamplingController();
+   if (sampling_controller)
+   {
+      sampling_controller->handleBasicBlock(Sim()->getTileManager()->getCurrentTileIndex(),
+                                            sim_basic_block);
+   }
+
    if (!Sim()->isEnabled())
       return;
 
+   TraceCapture *trace_capture = Sim()->getTraceCapture();
+   if (trace_capture)
+      trace_capture->recordBasicBlock(sim_basic_block);
+
    CoreModel *prfmdl = Sim()->getTileManager()->getCurrentCore()->getPerformanceModel();
    prfmdl->queueBasicBlock(sim_basic_block);
 
@@ -23,6 +37,10 @@ void handleBranch(BOOL taken, ADDRINT target)
    if (!Sim()->isEnabled())
       return;
 
+   TraceCapture *trace_capture = Sim()->getTraceCapture();
+   if (trace_capture)
+      trace_capture->recordBranch(taken, target);
+
    CoreModel *prfmdl = Sim()->getTileManager()->getCurrentCore()->getPerformanceModel();
 
    DynamicInstructionInfo info = DynamicInstructionInfo::createBranchInfo(taken, target);
@@ -153,18 +171,24 @@ VOID fillOperandList(OperandList *list, INS ins)
    }
 }
 
-VOID addInstructionModeling(INS ins)
+static bool accessesDataMemory(const OperandList &list)
 {
+   for (unsigned int i = 0; i < list.size(); i++)
+   {
+      if (list[i].m_type == Operand::MEMORY)
+         return true;
+   }
+   return false;
+}
 
-   BasicBlock *basic_block = new BasicBlock();
-
-   OperandList list;
-   fillOperandList(&list, ins);
+static Instruction* createInstruction(INS ins, OperandList &list)
+{
+   Instruction *instruction;
 
    // branches
    if (INS_IsBranch(ins) && INS_HasFallThrough(ins))
    {
-      basic_block->push_back(new BranchInstruction(INS_Opcode(ins), list));
+      instruction = new BranchInstruction(INS_Opcode(ins), list);
 
       INS_InsertCall(
          ins, IPOINT_TAKEN_BRANCH, (AFUNPTR)handleBranch,
@@ -185,24 +209,63 @@ VOID addInstructionModeling(INS ins)
       switch(INS_Opcode(ins))
       {
       case OPCODE_DIV:
-         basic_block->push_back(new ArithInstruction(INST_DIV, INS_Opcode(ins), list));
+         instruction = new ArithInstruction(INST_DIV, INS_Opcode(ins), list);
          break;
       case OPCODE_MUL:
-         basic_block->push_back(new ArithInstruction(INST_MUL, INS_Opcode(ins), list));
+         instruction = new ArithInstruction(INST_MUL, INS_Opcode(ins), list);
          break;
       case OPCODE_FDIV:
-         basic_block->push_back(new ArithInstruction(INST_FDIV, INS_Opcode(ins), list));
+         instruction = new ArithInstruction(INST_FDIV, INS_Opcode(ins), list);
          break;
       case OPCODE_FMUL:
-         basic_block->push_back(new ArithInstruction(INST_FMUL, INS_Opcode(ins), list));
+         instruction = new ArithInstruction(INST_FMUL, INS_Opcode(ins), list);
          break;
       default:
-         basic_block->push_back(new GenericInstruction(INS_Opcode(ins), list));
+         instruction = new GenericInstruction(INS_Opcode(ins), list);
       }
    }
 
-   basic_block->front()->setAddress(INS_Address(ins));
-   basic_block->front()->setSize(INS_Size(ins));
+   instruction->setAddress(INS_Address(ins));
+   instruction->setSize(INS_Size(ins));
+
+   return instruction;
+}
 
-   INS_InsertCall(ins, IPOINT_BEFORE, AFUNPTR(handleBasicBlock), IARG_PTR, basic_block, IARG_END);
+VOID addInstructionModeling(TRACE trace)
+{
+   // One BasicBlock (and one call to handleBasicBlock) per run of instructions.
+   // A run ends at the end of a BBL, before an instruction that accesses data
+   // memory and after a syscall. handleBasicBlock models all previously queued
+   // blocks, so the core model has caught up to the exact issue time of every
+   // memory access and to every dynamic instruction queued by a syscall.
+   for (BBL bbl = TRACE_BblHead(trace); BBL_Valid(bbl); bbl = BBL_Next(bbl))
+   {
+      BasicBlock *basic_block = NULL;
+      bool start_basic_block = true;
+
+      for (INS ins = BBL_InsHead(bbl); INS_Valid(ins); ins = INS_Next(ins))
+      {
+         OperandList list;
+         fillOperandList(&list, ins);
+
+         if (start_basic_block || accessesDataMemory(list))
+         {
+            if (basic_block)
+               basic_block->summarize();
+            basic_block = new BasicBlock();
+
+            // Must run before the memory accesses of the instruction are simulated
+            INS_InsertCall(ins, IPOINT_BEFORE, AFUNPTR(handleBasicBlock),
+                  IARG_CALL_ORDER, CALL_ORDER_FIRST + 1,
+                  IARG_PTR, basic_block,
+                  IARG_END);
+         }
+
+         basic_block->push_back(createInstruction(ins, list));
+         start_basic_block = INS_IsSyscall(ins);
+      }
+
+      if (basic_block)
+         basic_block->summarize();
+   }
 }
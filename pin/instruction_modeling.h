@@ -3,6 +3,6 @@
 
 #include <pin.H>
 
-void addInstructionModeling(INS ins);
+void addInstructionModeling(TRACE trace);
 
 #endif
@@ -162,6 +162,15 @@ void routineCallback(RTN rtn, void *v)
    }
 }
 
+VOID traceCallback (TRACE trace, void *v)
+{
+   if (Config::getSingleton()->getEnablePerformanceModeling())
+   {
+      // Core Performance Modeling
+      addInstructionModeling(trace);
+   }
+}
+
 VOID instructionCallback (INS ins, void *v)
 {
    // Debugging Function
@@ -174,12 +183,6 @@ VOID instructionCallback (INS ins, void *v)
             IARG_END);
    }
 
-   if (Config::getSingleton()->getEnablePerformanceModeling())
-   {
-      // Core Performance Modeling
-      addInstructionModeling(ins);
-   }
-
    // Progress Trace
    addProgressTrace(ins);
    // Clock Skew Minimization
@@ -433,6 +436,7 @@ int main(int argc, char *argv[])
       }
    }
 
+   TRACE_AddInstrumentFunction(traceCallback, 0);
    INS_AddInstrumentFunction(instructionCallback, 0);
 
    initProgressTrace();
@@ -0,0 +1,85 @@
+#include <stdio.h>
+#include <cassert>
+
+#include "bit_vector.h"
+#include "fixed_types.h"
+
+int main(int argc, char *argv[])
+{
+   const UInt32 num_bits = 1024;
+   BitVector bit_vector(num_bits);
+
+   // Set every third bit, including bits at word boundaries
+   UInt32 num_set = 0;
+   for (UInt32 i = 0; i < num_bits; i += 3)
+   {
+      bit_vector.set(i);
+      num_set ++;
+   }
+   bit_vector.set(128);
+   bit_vector.set(64);
+   num_set += 2;
+   assert(bit_vector.size() == num_set);
+   assert(bit_vector.any());
+
+   // Iterate using find() and check the bits come out in increasing order
+   bit_vector.resetFind();
+   SInt32 pos;
+   SInt32 last_pos = -1;
+   UInt32 num_found = 0;
+   while ((pos = bit_vector.find()) != -1)
+   {
+      assert(pos > last_pos);
+      assert(bit_vector.at(pos));
+      last_pos = pos;
+      num_found ++;
+   }
+   assert(num_found == num_set);
+
+   // getSetBits() and findNth() must agree with find()
+   SInt32 set_bits[num_bits];
+   assert(bit_vector.getSetBits(set_bits) == num_set);
+   bit_vector.resetFind();
+   for (UInt32 i = 0; i < num_set; i++)
+   {
+      SInt32 found = bit_vector.find();
+      assert(set_bits[i] == found);
+      assert(bit_vector.findNth(i) == found);
+   }
+   assert(bit_vector.findNth(num_set) == -1);
+
+   // Bulk operations
+   BitVector other(num_bits);
+   for (UInt32 i = 0; i < num_bits; i += 2)
+      other.set(i);
+
+   BitVector both(num_bits);
+   both.set(bit_vector);
+   both.intersect(other);
+   for (UInt32 i = 0; i < num_bits; i++)
+      assert(both.at(i) == (bit_vector.at(i) && other.at(i)));
+   assert(bit_vector.test(other));
+
+   BitVector either(num_bits);
+   either.set(bit_vector);
+   either.set(other);
+   for (UInt32 i = 0; i < num_bits; i++)
+      assert(either.at(i) == (bit_vector.at(i) || other.at(i)));
+
+   either.clear(other);
+   for (UInt32 i = 0; i < num_bits; i++)
+      assert(either.at(i) == (bit_vector.at(i) && !other.at(i)));
+   assert(!either.test(other));
+
+   // Clear everything
+   either.clear(either);
+   assert(either.none());
+   assert(either.size() == 0);
+   bit_vector.reset();
+   assert(bit_vector.none());
+   assert(bit_vector.find() == -1);
+
+   printf("Bit Vector tests successful\n");
+
+   return 0;
+}
@@ -0,0 +1,112 @@
+#include <stdio.h>
+#include <cassert>
+#include <sys/time.h>
+#include <map>
+#include <queue>
+
+#include "hash_map_queue.h"
+#include "fixed_types.h"
+
+// Reference implementation (the previous std::map of std::queue)
+template <typename K, typename V>
+class MapQueue
+{
+public:
+   void enqueue(K key, V value) { _map[key].push(value); }
+   V dequeue(K key)
+   {
+      typename std::map<K, std::queue<V> >::iterator it = _map.find(key);
+      V value = it->second.front();
+      it->second.pop();
+      if (it->second.empty())
+         _map.erase(it);
+      return value;
+   }
+   V front(K key) const { return _map.find(key)->second.front(); }
+   size_t count(K key) const
+   {
+      typename std::map<K, std::queue<V> >::const_iterator it = _map.find(key);
+      return (it == _map.end()) ? 0 : it->second.size();
+   }
+   size_t size() const { return _map.size(); }
+
+private:
+   std::map<K, std::queue<V> > _map;
+};
+
+static UInt64 getTime()
+{
+   struct timeval t;
+   gettimeofday(&t, NULL);
+   return ((UInt64) t.tv_sec) * 1000000 + t.tv_usec;
+}
+
+// Mimics the coherence request queues: a few requests outstanding per address,
+// with addresses constantly coming and going
+template <class Q>
+UInt64 runBenchmark(Q& q, UInt32 num_iterations, UInt32 num_addresses)
+{
+   UInt64 start_time = getTime();
+   UInt64 checksum = 0;
+   for (UInt32 i = 0; i < num_iterations; i++)
+   {
+      IntPtr address = ((IntPtr) (i % num_addresses)) << 6;
+      q.enqueue(address, (UInt64) i);
+      q.enqueue(address, (UInt64) i+1);
+      checksum += q.front(address);
+      checksum += q.count(address);
+      checksum += q.dequeue(address);
+      checksum += q.dequeue(address);
+   }
+   UInt64 end_time = getTime();
+   printf("  checksum(%llu), time(%llu us)\n", (unsigned long long) checksum, (unsigned long long) (end_time - start_time));
+   return checksum;
+}
+
+int main(int argc, char *argv[])
+{
+   const UInt32 num_addresses = 1024;
+
+   // Functional test against the reference implementation
+   HashMapQueue<IntPtr,UInt64> hash_map_queue;
+   MapQueue<IntPtr,UInt64> map_queue;
+   UInt32 seed = 1;
+   for (UInt32 i = 0; i < 200000; i++)
+   {
+      seed = seed * 1103515245 + 12345;
+      IntPtr address = ((IntPtr) ((seed >> 16) % num_addresses)) << 6;
+
+      assert(hash_map_queue.count(address) == map_queue.count(address));
+      assert(hash_map_queue.empty(address) == (map_queue.count(address) == 0));
+      if ((seed & 0x3) && (map_queue.count(address) > 0))
+      {
+         assert(hash_map_queue.front(address) == map_queue.front(address));
+         assert(hash_map_queue.dequeue(address) == map_queue.dequeue(address));
+      }
+      else
+      {
+         hash_map_queue.enqueue(address, i);
+         map_queue.enqueue(address, i);
+      }
+      assert(hash_map_queue.size() == map_queue.size());
+   }
+
+   // Missing keys
+   assert(hash_map_queue.front(1) == 0);
+   assert(hash_map_queue.dequeue(1) == 0);
+   assert(hash_map_queue.count(1) == 0);
+
+   // Microbenchmark
+   const UInt32 num_iterations = 10000000;
+   printf("std::map<K, std::queue<V> >:\n");
+   MapQueue<IntPtr,UInt64> bench_map_queue;
+   UInt64 map_checksum = runBenchmark(bench_map_queue, num_iterations, num_addresses);
+   printf("HashMapQueue:\n");
+   HashMapQueue<IntPtr,UInt64> bench_hash_map_queue;
+   UInt64 hash_map_checksum = runBenchmark(bench_hash_map_queue, num_iterations, num_addresses);
+   assert(map_checksum == hash_map_checksum);
+
+   printf("Hash Map Queue tests successful\n");
+
+   return 0;
+}
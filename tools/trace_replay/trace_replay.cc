@@ -0,0 +1,215 @@
+// Runs the timing models on the traces captured with [trace/capture] (see
+// trace_format.h), without Pin. The trace of thread 0 is replayed by the
+// main thread, and the threads it spawns are replayed by spawned threads.
+
+#include <map>
+#include <sched.h>
+
+#include "carbon_user.h"
+#include "simulator.h"
+#include "tile_manager.h"
+#include "core.h"
+#include "core_model.h"
+#include "sync_client.h"
+#include "dynamic_instruction_info.h"
+#include "trace_reader.h"
+#include "trace_capture.h"
+#include "lock.h"
+#include "log.h"
+
+static std::string trace_directory;
+
+// Sync objects and threads get new ids in the replay
+// A thread may use an object another thread creates later in its trace, so
+// the lookups wait for the mapping to be added
+class IdMap
+{
+public:
+   void add(SInt32 captured_id, SInt32 id)
+   {
+      ScopedLock sl(m_lock);
+      m_ids[captured_id] = id;
+   }
+
+   SInt32 get(SInt32 captured_id)
+   {
+      while (true)
+      {
+         {
+            ScopedLock sl(m_lock);
+            std::map<SInt32, SInt32>::iterator it = m_ids.find(captured_id);
+            if (it != m_ids.end())
+               return it->second;
+         }
+         sched_yield();
+      }
+   }
+
+private:
+   Lock m_lock;
+   std::map<SInt32, SInt32> m_ids;
+};
+
+static IdMap mutex_ids;
+static IdMap cond_ids;
+static IdMap barrier_ids;
+static IdMap thread_ids;
+
+static void* replayThread(void *arg);
+
+static void replaySync(const TraceRecord &record)
+{
+   SyncClient *sync_client = Sim()->getTileManager()->getCurrentCore()->getSyncClient();
+
+   switch (record.sync_type)
+   {
+   case TRACE_MUTEX_INIT:
+      {
+         carbon_mutex_t mux;
+         sync_client->mutexInit(&mux);
+         mutex_ids.add(record.object, mux);
+      }
+      break;
+   case TRACE_MUTEX_LOCK:
+      {
+         carbon_mutex_t mux = mutex_ids.get(record.object);
+         sync_client->mutexLock(&mux);
+      }
+      break;
+   case TRACE_MUTEX_UNLOCK:
+      {
+         carbon_mutex_t mux = mutex_ids.get(record.object);
+         sync_client->mutexUnlock(&mux);
+      }
+      break;
+   case TRACE_COND_INIT:
+      {
+         carbon_cond_t cond;
+         sync_client->condInit(&cond);
+         cond_ids.add(record.object, cond);
+      }
+      break;
+   case TRACE_COND_WAIT:
+      {
+         carbon_cond_t cond = cond_ids.get(record.object);
+         carbon_mutex_t mux = mutex_ids.get(record.argument);
+         sync_client->condWait(&cond, &mux);
+      }
+      break;
+   case TRACE_COND_SIGNAL:
+      {
+         carbon_cond_t cond = cond_ids.get(record.object);
+         sync_client->condSignal(&cond);
+      }
+      break;
+   case TRACE_COND_BROADCAST:
+      {
+         carbon_cond_t cond = cond_ids.get(record.object);
+         sync_client->condBroadcast(&cond);
+      }
+      break;
+   case TRACE_BARRIER_INIT:
+      {
+         carbon_barrier_t barrier;
+         sync_client->barrierInit(&barrier, record.argument);
+         barrier_ids.add(record.object, barrier);
+      }
+      break;
+   case TRACE_BARRIER_WAIT:
+      {
+         carbon_barrier_t barrier = barrier_ids.get(record.object);
+         sync_client->barrierWait(&barrier);
+      }
+      break;
+   default:
+      LOG_PRINT_ERROR("Unrecognized sync type(%u)", record.sync_type);
+      break;
+   }
+}
+
+static void replay(thread_id_t captured_thread_id)
+{
+   TraceReader reader(getTraceFileName(trace_directory, captured_thread_id));
+   TraceRecord record;
+
+   // Only the timing of the accesses is modeled, the data is not used
+   std::vector<Byte> data_buf(1);
+
+   while (reader.read(record))
+   {
+      // The thread may be migrated to another core
+      Core *core = Sim()->getTileManager()->getCurrentCore();
+
+      switch (record.type)
+      {
+      case TRACE_BASIC_BLOCK:
+         core->getPerformanceModel()->queueBasicBlock(record.basic_block);
+         core->getPerformanceModel()->iterate();
+         break;
+
+      case TRACE_MEMORY_ACCESS:
+         if (record.size > data_buf.size())
+            data_buf.resize(record.size);
+         core->initiateMemoryAccess(MemComponent::L1_DCACHE,
+                                    (Core::lock_signal_t) record.lock_signal,
+                                    (Core::mem_op_t) record.mem_op_type,
+                                    record.address, &data_buf[0], record.size,
+                                    true);
+         break;
+
+      case TRACE_BRANCH:
+         {
+            DynamicInstructionInfo info = DynamicInstructionInfo::createBranchInfo(record.taken, record.target);
+            core->getPerformanceModel()->pushDynamicInstructionInfo(info);
+         }
+         break;
+
+      case TRACE_SYNC:
+         replaySync(record);
+         break;
+
+      case TRACE_SPAWN:
+         {
+            carbon_thread_t thread_id = CarbonSpawnThread(replayThread, (void*) (long) record.thread_id);
+            thread_ids.add(record.thread_id, thread_id);
+         }
+         break;
+
+      case TRACE_JOIN:
+         CarbonJoinThread(thread_ids.get(record.thread_id));
+         break;
+
+      default:
+         LOG_PRINT_ERROR("Unexpected record type(%u)", record.type);
+         break;
+      }
+   }
+}
+
+static void* replayThread(void *arg)
+{
+   replay((thread_id_t) (long) arg);
+   return NULL;
+}
+
+int main(int argc, char *argv[])
+{
+   CarbonStartSim(argc, argv);
+
+   try
+   {
+      trace_directory = Sim()->getCfg()->getString("trace/directory");
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read trace/directory from the cfg file");
+   }
+   LOG_ASSERT_ERROR(!Sim()->getTraceCapture(), "Can not capture a trace while replaying one");
+
+   Simulator::enablePerformanceModelsInCurrentProcess();
+   replay(0);
+   Simulator::disablePerformanceModelsInCurrentProcess();
+
+   CarbonStopSim();
+   return 0;
+}